@@ -0,0 +1,147 @@
+/** @file
+ *
+ * @brief Benchmark of reading a 256 MiB file sequentially: buffered @c std::ifstream,
+ * a blocking @c read loop, and @c async_file_reader through io_uring and through the
+ * @c pread fallback, with the file in the page cache and with the cache dropped before
+ * each pass (@c POSIX_FADV_DONTNEED, so reads go to the device).
+ *
+ * Each pass folds every 64th byte into a checksum so the data is touched.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+#include <cstddef> // std::byte, std::size_t
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "utility/async_file_reader.hpp"
+
+#if defined(__linux__)
+
+#include <fcntl.h> // open, posix_fadvise
+#include <unistd.h> // read, close
+
+constexpr std::size_t FileSize = 256u * 1024u * 1024u;
+constexpr std::size_t ChunkSize = 128u * 1024u;
+
+namespace {
+
+const std::filesystem::path& bench_file() {
+  static const auto path = [] {
+    auto p = std::filesystem::temp_directory_path() / "async_file_reader_bench.bin";
+    std::vector<char> buf(ChunkSize);
+    std::ofstream out(p, std::ios::binary);
+    for (std::size_t off = 0u; off < FileSize; off += ChunkSize) {
+      for (std::size_t i = 0u; i < ChunkSize; ++i) {
+        buf[i] = static_cast<char>((off + i) * 7u);
+      }
+      out.write(buf.data(), static_cast<std::streamsize>(ChunkSize));
+    }
+    return p;
+  } ();
+  return path;
+}
+
+std::uint64_t fold(std::span<const std::byte> data) {
+  std::uint64_t sum = 0u;
+  for (std::size_t i = 0u; i < data.size(); i += 64u) {
+    sum += static_cast<std::uint64_t>(data[i]);
+  }
+  return sum;
+}
+
+void drop_cache() {
+  int fd = ::open(bench_file().c_str(), O_RDONLY);
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  ::close(fd);
+}
+
+std::uint64_t read_ifstream() {
+  std::ifstream in(bench_file(), std::ios::binary);
+  std::vector<std::byte> buf(ChunkSize);
+  std::uint64_t sum = 0u;
+  while (in.read(reinterpret_cast<char*>(buf.data()), static_cast<std::streamsize>(buf.size())) || in.gcount() > 0) {
+    sum += fold(std::span<const std::byte>(buf.data(), static_cast<std::size_t>(in.gcount())));
+  }
+  return sum;
+}
+
+std::uint64_t read_blocking() {
+  int fd = ::open(bench_file().c_str(), O_RDONLY);
+  std::vector<std::byte> buf(ChunkSize);
+  std::uint64_t sum = 0u;
+  for (auto n = ::read(fd, buf.data(), buf.size()); n > 0; n = ::read(fd, buf.data(), buf.size())) {
+    sum += fold(std::span<const std::byte>(buf.data(), static_cast<std::size_t>(n)));
+  }
+  ::close(fd);
+  return sum;
+}
+
+std::uint64_t read_async(chops::async_file_reader& rdr) {
+  std::uint64_t sum = 0u;
+  auto ec = rdr.read_file(bench_file().c_str(), [&sum] (std::uint64_t, std::span<const std::byte> data) {
+      sum += fold(data);
+    } );
+  REQUIRE_FALSE (ec);
+  return sum;
+}
+
+}
+
+TEST_CASE ( "Sequential read of a 256 MiB file", "[async_file_reader] [benchmark]" ) {
+
+  auto expected = read_blocking();
+  chops::async_file_reader uring({ .queue_depth = 16u, .buffer_size = ChunkSize });
+  chops::async_file_reader fallback({ .queue_depth = 16u, .buffer_size = ChunkSize, .use_io_uring = false });
+  REQUIRE (read_ifstream() == expected);
+  REQUIRE (read_async(uring) == expected);
+  REQUIRE (read_async(fallback) == expected);
+
+  BENCHMARK ( "cached, std::ifstream" ) {
+    return read_ifstream();
+  };
+  BENCHMARK ( "cached, blocking read" ) {
+    return read_blocking();
+  };
+  BENCHMARK ( uring.uses_io_uring() ? "cached, async_file_reader, io_uring" : "cached, async_file_reader, pread (no io_uring)" ) {
+    return read_async(uring);
+  };
+  BENCHMARK ( "cached, async_file_reader, pread fallback" ) {
+    return read_async(fallback);
+  };
+
+  BENCHMARK ( "cold, std::ifstream" ) {
+    drop_cache();
+    return read_ifstream();
+  };
+  BENCHMARK ( "cold, blocking read" ) {
+    drop_cache();
+    return read_blocking();
+  };
+  BENCHMARK ( uring.uses_io_uring() ? "cold, async_file_reader, io_uring" : "cold, async_file_reader, pread (no io_uring)" ) {
+    drop_cache();
+    return read_async(uring);
+  };
+  BENCHMARK ( "cold, async_file_reader, pread fallback" ) {
+    drop_cache();
+    return read_async(fallback);
+  };
+
+  std::filesystem::remove(bench_file());
+}
+
+#endif
+
@@ -0,0 +1,97 @@
+/** @file
+ *
+ * @brief Benchmark of per-call logging overhead, comparing @c binary_logger::log
+ * with formatting the line inline (with @c numeric_text and with @c snprintf).
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "utility/binary_logger.hpp"
+#include "utility/numeric_text.hpp"
+#include "utility/tsc_clock.hpp"
+
+constexpr int NumCalls = 1000;
+
+void append_chars(std::vector<std::byte>& buf, std::string_view sv) {
+  for (char c : sv) {
+    buf.push_back(static_cast<std::byte>(c));
+  }
+}
+
+TEST_CASE ( "Logging overhead", "[binary_logger] [benchmark]" ) {
+
+  chops::tsc_clock::now(); // calibrate before measuring
+
+  std::uint64_t written = 0u;
+  // rings large enough that a measured run does not fill them, the rings are flushed
+  // after each sample (and when full during Catch's run time estimation)
+  chops::binary_logger text_logger([&written] (std::span<const std::byte> buf) { written += buf.size(); },
+                                   chops::log_output::text, 1u << 24u);
+  chops::binary_logger bin_logger([&written] (std::span<const std::byte> buf) { written += buf.size(); },
+                                  chops::log_output::binary, 1u << 24u);
+
+  BENCHMARK_ADVANCED ( "binary_logger::log, text output" ) (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&text_logger] {
+      for (int i = 0; i < NumCalls; ++i) {
+        while (!text_logger.log("order {} filled {} at {}", std::uint64_t{1234567u} + i, i, 101.25)) {
+          text_logger.flush();
+        }
+      }
+    } );
+    text_logger.flush();
+  };
+  BENCHMARK_ADVANCED ( "binary_logger::log, binary output" ) (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&bin_logger] {
+      for (int i = 0; i < NumCalls; ++i) {
+        while (!bin_logger.log("order {} filled {} at {}", std::uint64_t{1234567u} + i, i, 101.25)) {
+          bin_logger.flush();
+        }
+      }
+    } );
+    bin_logger.flush();
+  };
+  BENCHMARK ( "Inline formatting, numeric_text" ) {
+    std::vector<std::byte> buf;
+    buf.reserve(64u);
+    std::size_t sum = 0u;
+    for (int i = 0; i < NumCalls; ++i) {
+      buf.clear();
+      chops::append_decimal(buf, chops::tsc_clock::now().time_since_epoch().count());
+      append_chars(buf, " order ");
+      chops::append_decimal(buf, std::uint64_t{1234567u} + i);
+      append_chars(buf, " filled ");
+      chops::append_decimal(buf, i);
+      append_chars(buf, " at ");
+      chops::append_fixed(buf, 101.25, 6);
+      sum += buf.size();
+    }
+    return sum;
+  };
+  BENCHMARK ( "Inline formatting, snprintf" ) {
+    char buf[128];
+    std::size_t sum = 0u;
+    for (int i = 0; i < NumCalls; ++i) {
+      sum += static_cast<std::size_t>(std::snprintf(buf, sizeof(buf), "%lld order %llu filled %d at %f",
+          static_cast<long long>(chops::tsc_clock::now().time_since_epoch().count()),
+          static_cast<unsigned long long>(1234567u + i), i, 101.25));
+    }
+    return sum;
+  };
+  REQUIRE (written > 0u);
+}
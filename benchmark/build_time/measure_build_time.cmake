@@ -0,0 +1,42 @@
+# Copyright (c) 2026 by Cliff Green
+#
+# Distributed under the Boost Software License, Version 1.0.
+# (See accompanying file LICENSE.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+#
+# Build the synthetic project twice, once including the utility-rack headers and once
+# importing the chops.utility module, and report the build time of each. Run from
+# an empty directory:
+#
+#   cmake -D TU_COUNT=200 -D GENERATOR=Ninja -P <utility-rack>/benchmark/build_time/measure_build_time.cmake
+#
+# CMake module support requires the Ninja or Visual Studio generators.
+
+cmake_minimum_required ( VERSION 3.28 FATAL_ERROR )
+
+if ( NOT DEFINED TU_COUNT )
+  set ( TU_COUNT 200 )
+endif ()
+if ( NOT DEFINED GENERATOR )
+  set ( GENERATOR Ninja )
+endif ()
+
+foreach ( variant include module )
+  set ( build_dir ${CMAKE_CURRENT_BINARY_DIR}/build_time_${variant} )
+  file ( REMOVE_RECURSE ${build_dir} )
+  execute_process ( COMMAND ${CMAKE_COMMAND} -S ${CMAKE_CURRENT_LIST_DIR} -B ${build_dir}
+                            -G ${GENERATOR} -D CMAKE_BUILD_TYPE=Release
+                            -D BUILD_TIME_VARIANT=${variant} -D BUILD_TIME_TU_COUNT=${TU_COUNT}
+                    OUTPUT_QUIET RESULT_VARIABLE configure_result )
+  if ( NOT configure_result EQUAL 0 )
+    message ( FATAL_ERROR "Configure of ${variant} variant failed" )
+  endif ()
+  string ( TIMESTAMP start_time "%s%f" )
+  execute_process ( COMMAND ${CMAKE_COMMAND} --build ${build_dir} --config Release
+                    OUTPUT_QUIET RESULT_VARIABLE build_result )
+  string ( TIMESTAMP end_time "%s%f" )
+  if ( NOT build_result EQUAL 0 )
+    message ( FATAL_ERROR "Build of ${variant} variant failed" )
+  endif ()
+  math ( EXPR elapsed_ms "(${end_time} - ${start_time}) / 1000" )
+  message ( "${variant} variant: ${elapsed_ms} ms for ${TU_COUNT} translation units" )
+endforeach ()
@@ -0,0 +1,79 @@
+/** @file
+ *
+ * @brief Benchmark of counter increments from 1 to 64 threads: a single shared
+ * atomic, adjacent per-thread atomics (false sharing), cache padded per-thread
+ * atomics, and a @c per_cpu_counter.
+ *
+ * Each thread performs the same number of increments regardless of thread count,
+ * so a variant that scales well shows a flat time as threads are added (up to the
+ * number of cores).
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utility/cache_padded.hpp"
+#include "utility/repeat.hpp"
+
+constexpr int MaxThreads = 64;
+constexpr int IncrsPerThread = 20000;
+
+template <typename F>
+void run_threads (int num_thrs, F&& func) {
+  std::vector<std::thread> thrs;
+  chops::repeat(num_thrs, [&] (int i) { thrs.emplace_back(func, i); } );
+  for (auto& thr : thrs) {
+    thr.join();
+  }
+}
+
+TEST_CASE ( "Contended versus padded counters, 1 to 64 threads", "[cache_padded] [benchmark]" ) {
+
+  std::atomic<std::uint64_t> shared { 0u };
+  std::atomic<std::uint64_t> adjacent[MaxThreads] { };
+  chops::cache_padded<chops::relaxed_counter> padded[MaxThreads];
+  chops::per_cpu_counter per_cpu;
+
+  for (int n = 1; n <= MaxThreads; n *= 2) {
+    auto suffix = ", " + std::to_string(n) + " threads";
+
+    BENCHMARK ( "shared atomic" + suffix ) {
+      run_threads(n, [&shared] (int) {
+        chops::repeat(IncrsPerThread, [&shared] { shared.fetch_add(1u, std::memory_order_relaxed); } );
+      } );
+      return shared.load();
+    };
+    BENCHMARK ( "adjacent atomics" + suffix ) {
+      run_threads(n, [&adjacent] (int i) {
+        chops::repeat(IncrsPerThread, [&adjacent, i] { adjacent[i].fetch_add(1u, std::memory_order_relaxed); } );
+      } );
+      return adjacent[0].load();
+    };
+    BENCHMARK ( "cache padded atomics" + suffix ) {
+      run_threads(n, [&padded] (int i) {
+        chops::repeat(IncrsPerThread, [&padded, i] { ++(*padded[i]); } );
+      } );
+      return padded[0]->load();
+    };
+    BENCHMARK ( "per_cpu_counter" + suffix ) {
+      run_threads(n, [&per_cpu] (int) {
+        chops::repeat(IncrsPerThread, [&per_cpu] { ++per_cpu; } );
+      } );
+      return per_cpu.load();
+    };
+  }
+}
@@ -0,0 +1,102 @@
+/** @file
+ *
+ * @brief Benchmark of mixed read / write workloads from 1 to 64 threads, comparing
+ * @c concurrent_hash_map with a @c std::unordered_map behind a single @c std::mutex.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "utility/concurrent_hash_map.hpp"
+#include "utility/repeat.hpp"
+
+constexpr int MaxThreads = 64;
+constexpr int OpsPerThread = 10000;
+constexpr std::uint64_t NumKeys = 100000u;
+
+struct locked_unordered_map {
+  std::mutex mtx;
+  std::unordered_map<std::uint64_t, std::uint64_t> map;
+
+  void insert_or_assign(std::uint64_t k, std::uint64_t v) {
+    std::lock_guard lk(mtx);
+    map.insert_or_assign(k, v);
+  }
+  std::optional<std::uint64_t> find(std::uint64_t k) {
+    std::lock_guard lk(mtx);
+    if (auto it = map.find(k); it != map.end()) {
+      return { it->second };
+    }
+    return { };
+  }
+};
+
+// each thread runs a xorshift sequence choosing keys and the operation type
+template <typename M>
+std::uint64_t mixed_workload (M& m, int num_thrs, unsigned read_pct) {
+  std::atomic<std::uint64_t> found { 0u };
+  std::vector<std::thread> thrs;
+  chops::repeat(num_thrs, [&] (int t) {
+    thrs.emplace_back([&, t] {
+      std::uint64_t x = 0x9e3779b97f4a7c15u * static_cast<std::uint64_t>(t + 1);
+      std::uint64_t hits = 0u;
+      chops::repeat(OpsPerThread, [&] {
+        x ^= x << 13u;
+        x ^= x >> 7u;
+        x ^= x << 17u;
+        auto k = x % NumKeys;
+        if ((x >> 40u) % 100u < read_pct) {
+          hits += m.find(k).has_value();
+        }
+        else {
+          m.insert_or_assign(k, x);
+        }
+      } );
+      found.fetch_add(hits);
+    } );
+  } );
+  for (auto& thr : thrs) {
+    thr.join();
+  }
+  return found.load();
+}
+
+TEST_CASE ( "Mixed read / write hash map workloads", "[concurrent_hash_map] [benchmark]" ) {
+
+  chops::concurrent_hash_map<std::uint64_t, std::uint64_t> chm(64u);
+  locked_unordered_map lum;
+  for (std::uint64_t k = 0u; k < NumKeys; k += 2u) {
+    chm.insert(k, k);
+    lum.insert_or_assign(k, k);
+  }
+
+  for (unsigned read_pct : { 50u, 90u, 99u }) {
+    for (int n = 1; n <= MaxThreads; n *= 2) {
+      auto suffix = ", " + std::to_string(read_pct) + "% reads, " + std::to_string(n) + " threads";
+
+      BENCHMARK ( "std::unordered_map + std::mutex" + suffix ) {
+        return mixed_workload(lum, n, read_pct);
+      };
+      BENCHMARK ( "concurrent_hash_map" + suffix ) {
+        return mixed_workload(chm, n, read_pct);
+      };
+    }
+  }
+}
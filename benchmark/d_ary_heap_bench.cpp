@@ -0,0 +1,239 @@
+/** @file
+ *
+ * @brief Benchmark of priority queues at 10^6 elements: @c std::priority_queue, a
+ * pairing heap, and @c d_ary_heap with 2, 4 and 8 children, plus a scheduler style
+ * mix of pushes, pops and deadline changes on @c indexed_priority_queue and the
+ * pairing heap (which supports decrease key).
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+#include <cstdint>
+#include <functional> // std::greater
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "utility/d_ary_heap.hpp"
+
+constexpr std::size_t NumElems = 1'000'000u;
+
+// min pairing heap over a node pool, with decrease key by node index
+class pairing_heap {
+public:
+  explicit pairing_heap(std::size_t n) { m_nodes.reserve(n); }
+
+  std::uint32_t push(std::uint64_t key) {
+    auto i = static_cast<std::uint32_t>(m_nodes.size());
+    m_nodes.push_back(node { key, nil, nil, nil });
+    m_root = meld(m_root, i);
+    ++m_size;
+    return i;
+  }
+
+  std::uint64_t top() const { return m_nodes[m_root].key; }
+  bool empty() const { return m_size == 0u; }
+
+  void pop() {
+    auto old = m_root;
+    m_root = merge_pairs(m_nodes[old].child);
+    if (m_root != nil) {
+      m_nodes[m_root].prev = nil;
+    }
+    --m_size;
+  }
+
+  void decrease_key(std::uint32_t i, std::uint64_t key) {
+    m_nodes[i].key = key;
+    if (i == m_root) {
+      return;
+    }
+    detach(i);
+    m_root = meld(m_root, i);
+  }
+
+private:
+  static constexpr std::uint32_t nil = 0xffffffffu;
+
+  struct node {
+    std::uint64_t key;
+    std::uint32_t child;
+    std::uint32_t next;
+    std::uint32_t prev; // parent if first child, else previous sibling
+  };
+
+  std::uint32_t meld(std::uint32_t a, std::uint32_t b) {
+    if (a == nil) { return b; }
+    if (b == nil) { return a; }
+    if (m_nodes[b].key < m_nodes[a].key) { std::swap(a, b); }
+    // b becomes the first child of a
+    m_nodes[b].next = m_nodes[a].child;
+    if (m_nodes[a].child != nil) { m_nodes[m_nodes[a].child].prev = b; }
+    m_nodes[b].prev = a;
+    m_nodes[a].child = b;
+    m_nodes[a].next = nil;
+    return a;
+  }
+
+  void detach(std::uint32_t i) {
+    auto p = m_nodes[i].prev;
+    if (m_nodes[p].child == i) { m_nodes[p].child = m_nodes[i].next; }
+    else { m_nodes[p].next = m_nodes[i].next; }
+    if (m_nodes[i].next != nil) { m_nodes[m_nodes[i].next].prev = p; }
+    m_nodes[i].next = nil;
+    m_nodes[i].prev = nil;
+  }
+
+  std::uint32_t merge_pairs(std::uint32_t first) {
+    m_pairs.clear();
+    while (first != nil) {
+      auto a = first;
+      auto b = m_nodes[a].next;
+      first = (b == nil) ? nil : m_nodes[b].next;
+      m_nodes[a].next = nil;
+      m_nodes[a].prev = nil;
+      if (b != nil) {
+        m_nodes[b].next = nil;
+        m_nodes[b].prev = nil;
+      }
+      m_pairs.push_back(meld(a, b));
+    }
+    std::uint32_t r = nil;
+    for (auto it = m_pairs.rbegin(); it != m_pairs.rend(); ++it) {
+      r = meld(*it, r);
+    }
+    return r;
+  }
+
+private:
+  std::vector<node>          m_nodes;
+  std::vector<std::uint32_t> m_pairs;
+  std::uint32_t              m_root { nil };
+  std::size_t                m_size { 0u };
+};
+
+std::vector<std::uint64_t> make_keys () {
+  std::mt19937_64 gen(42u);
+  std::vector<std::uint64_t> keys(NumElems);
+  for (auto& k : keys) {
+    k = gen();
+  }
+  return keys;
+}
+
+template <typename Q>
+std::uint64_t push_pop_all (Q& q, const std::vector<std::uint64_t>& keys) {
+  for (auto k : keys) {
+    q.push(k);
+  }
+  std::uint64_t sum = 0u;
+  while (!q.empty()) {
+    sum += q.top();
+    q.pop();
+  }
+  return sum;
+}
+
+TEST_CASE ( "Priority queue push and pop of 10^6 elements", "[d_ary_heap] [benchmark]" ) {
+
+  auto keys = make_keys();
+  using greater = std::greater<std::uint64_t>;
+
+  BENCHMARK ( "std::priority_queue" ) {
+    std::priority_queue<std::uint64_t, std::vector<std::uint64_t>, greater> q;
+    return push_pop_all(q, keys);
+  };
+  BENCHMARK ( "pairing heap" ) {
+    pairing_heap q(NumElems);
+    return push_pop_all(q, keys);
+  };
+  BENCHMARK ( "d_ary_heap, D = 2" ) {
+    chops::d_ary_heap<std::uint64_t, 2, greater> q;
+    q.reserve(NumElems);
+    return push_pop_all(q, keys);
+  };
+  BENCHMARK ( "d_ary_heap, D = 4" ) {
+    chops::d_ary_heap<std::uint64_t, 4, greater> q;
+    q.reserve(NumElems);
+    return push_pop_all(q, keys);
+  };
+  BENCHMARK ( "d_ary_heap, D = 8" ) {
+    chops::d_ary_heap<std::uint64_t, 8, greater> q;
+    q.reserve(NumElems);
+    return push_pop_all(q, keys);
+  };
+}
+
+TEST_CASE ( "Scheduler mix with deadline changes, 10^6 timers", "[d_ary_heap] [benchmark]" ) {
+
+  auto keys = make_keys();
+  using greater = std::greater<std::uint64_t>;
+
+  // every timer is rescheduled to an earlier deadline once, then all are popped
+  BENCHMARK ( "pairing heap, decrease key" ) {
+    pairing_heap q(NumElems);
+    std::vector<std::uint32_t> ids;
+    ids.reserve(NumElems);
+    for (auto k : keys) {
+      ids.push_back(q.push(k));
+    }
+    for (std::size_t i = 0u; i < NumElems; ++i) {
+      q.decrease_key(ids[i], keys[i] / 2u);
+    }
+    std::uint64_t sum = 0u;
+    while (!q.empty()) {
+      sum += q.top();
+      q.pop();
+    }
+    return sum;
+  };
+  BENCHMARK ( "indexed_priority_queue, D = 4, update" ) {
+    chops::indexed_priority_queue<std::uint64_t, 4, greater> q;
+    q.reserve(NumElems);
+    std::vector<chops::slot_handle> ids;
+    ids.reserve(NumElems);
+    for (auto k : keys) {
+      ids.push_back(q.push(k));
+    }
+    for (std::size_t i = 0u; i < NumElems; ++i) {
+      q.update(ids[i], keys[i] / 2u);
+    }
+    std::uint64_t sum = 0u;
+    while (!q.empty()) {
+      sum += q.top();
+      q.pop();
+    }
+    return sum;
+  };
+  BENCHMARK ( "std::priority_queue, tombstones" ) {
+    // a rescheduled timer is pushed again and its old entry skipped when popped
+    std::priority_queue<std::pair<std::uint64_t, std::uint32_t>,
+                        std::vector<std::pair<std::uint64_t, std::uint32_t>>,
+                        std::greater<std::pair<std::uint64_t, std::uint32_t>>> q;
+    std::vector<std::uint64_t> current(keys);
+    for (std::uint32_t i = 0u; i < NumElems; ++i) {
+      q.emplace(keys[i], i);
+    }
+    for (std::uint32_t i = 0u; i < NumElems; ++i) {
+      current[i] = keys[i] / 2u;
+      q.emplace(current[i], i);
+    }
+    std::uint64_t sum = 0u;
+    while (!q.empty()) {
+      auto [k, i] = q.top();
+      q.pop();
+      sum += (current[i] == k) ? k : 0u;
+    }
+    return sum;
+  };
+}
+
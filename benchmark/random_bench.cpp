@@ -0,0 +1,89 @@
+/** @file
+ *
+ * @brief Benchmark of the pseudo random number generators, bounded integer
+ * generation, and bulk byte fill, compared with @c std::mt19937_64 and
+ * @c std::uniform_int_distribution.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+#include <cstddef> // std::byte
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "utility/random.hpp"
+
+constexpr int NumValues = 100000;
+constexpr std::size_t FillBytes = 1u << 20u;
+
+template <typename G>
+std::uint64_t raw_values (G& gen) {
+  std::uint64_t sum = 0u;
+  for (int i = 0; i < NumValues; ++i) {
+    sum += gen();
+  }
+  return sum;
+}
+
+TEST_CASE ( "Raw generator throughput", "[random] [benchmark]" ) {
+
+  std::mt19937_64 mt { 1u };
+  chops::xoshiro256ss xo { 1u };
+  chops::wyrand wy { 1u };
+
+  BENCHMARK ( "std::mt19937_64" ) { return raw_values(mt); };
+  BENCHMARK ( "xoshiro256ss" ) { return raw_values(xo); };
+  BENCHMARK ( "wyrand" ) { return raw_values(wy); };
+}
+
+TEST_CASE ( "Bounded integer generation", "[random] [benchmark]" ) {
+
+  std::mt19937_64 mt { 1u };
+  chops::xoshiro256ss xo { 1u };
+
+  BENCHMARK ( "std::uniform_int_distribution, std::mt19937_64" ) {
+    std::uniform_int_distribution<int> dist(0, 999);
+    std::uint64_t sum = 0u;
+    for (int i = 0; i < NumValues; ++i) {
+      sum += static_cast<std::uint64_t>(dist(mt));
+    }
+    return sum;
+  };
+  BENCHMARK ( "std::uniform_int_distribution, xoshiro256ss" ) {
+    std::uniform_int_distribution<int> dist(0, 999);
+    std::uint64_t sum = 0u;
+    for (int i = 0; i < NumValues; ++i) {
+      sum += static_cast<std::uint64_t>(dist(xo));
+    }
+    return sum;
+  };
+  BENCHMARK ( "chops::uniform_int, xoshiro256ss" ) {
+    std::uint64_t sum = 0u;
+    for (int i = 0; i < NumValues; ++i) {
+      sum += static_cast<std::uint64_t>(chops::uniform_int(xo, 0, 999));
+    }
+    return sum;
+  };
+}
+
+TEST_CASE ( "Bulk byte fill", "[random] [benchmark]" ) {
+
+  std::vector<std::byte> buf(FillBytes);
+  chops::xoshiro256ss xo { 1u };
+  chops::wyrand wy { 1u };
+  chops::xoshiro256ss_x4 x4 { 1u };
+
+  BENCHMARK ( "fill_random, xoshiro256ss" ) { chops::fill_random(buf, xo); return buf[0]; };
+  BENCHMARK ( "fill_random, wyrand" ) { chops::fill_random(buf, wy); return buf[0]; };
+  BENCHMARK ( "fill_random, xoshiro256ss_x4" ) { chops::fill_random(buf, x4); return buf[0]; };
+}
@@ -0,0 +1,101 @@
+/** @file
+ *
+ * @brief Benchmark of rate limiter checks from 1 to 8 threads, comparing a mutex
+ * protected token bucket with the lock-free @c token_bucket and
+ * @c sliding_window_limiter, and a @c keyed_rate_limiter over many keys.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utility/rate_limiter.hpp"
+#include "utility/repeat.hpp"
+
+constexpr int MaxThreads = 8;
+constexpr int OpsPerThread = 20000;
+
+// conventional token bucket, floating point tokens guarded by a mutex
+class mutex_token_bucket {
+public:
+  mutex_token_bucket(double rate, double burst) :
+      m_rate(rate), m_burst(burst), m_tokens(burst), m_last(std::chrono::steady_clock::now()) { }
+
+  bool try_acquire() {
+    std::lock_guard lk(m_mutex);
+    auto now = std::chrono::steady_clock::now();
+    m_tokens = std::min(m_burst, m_tokens + std::chrono::duration<double>(now - m_last).count() * m_rate);
+    m_last = now;
+    if (m_tokens < 1.0) {
+      return false;
+    }
+    m_tokens -= 1.0;
+    return true;
+  }
+
+private:
+  std::mutex                            m_mutex;
+  double                                m_rate;
+  double                                m_burst;
+  double                                m_tokens;
+  std::chrono::steady_clock::time_point m_last;
+};
+
+template <typename F>
+std::uint64_t contend (int num_thrs, F func) {
+  std::atomic<std::uint64_t> allowed { 0u };
+  std::vector<std::thread> thrs;
+  chops::repeat(num_thrs, [&] (int t) {
+    thrs.emplace_back([&, t] {
+      std::uint64_t n = 0u;
+      chops::repeat(OpsPerThread, [&] (int i) { n += func(t, i) ? 1u : 0u; } );
+      allowed.fetch_add(n);
+    } );
+  } );
+  for (auto& thr : thrs) {
+    thr.join();
+  }
+  return allowed.load();
+}
+
+TEST_CASE ( "Rate limiter checks under contention", "[rate_limiter] [benchmark]" ) {
+
+  mutex_token_bucket mtb(1e6, 1000.0);
+  chops::token_bucket tb(1e6, 1000.0);
+  chops::sliding_window_limiter sw(100000u, std::chrono::milliseconds(100));
+  chops::keyed_rate_limiter<std::uint64_t> kl(chops::token_bucket(1e3, 100.0));
+
+  for (int n = 1; n <= MaxThreads; n *= 2) {
+    auto suffix = ", " + std::to_string(n) + " threads";
+
+    BENCHMARK ( "mutex token bucket" + suffix ) {
+      return contend(n, [&mtb] (int, int) { return mtb.try_acquire(); } );
+    };
+    BENCHMARK ( "token_bucket" + suffix ) {
+      return contend(n, [&tb] (int, int) { return tb.try_acquire(); } );
+    };
+    BENCHMARK ( "sliding_window_limiter" + suffix ) {
+      return contend(n, [&sw] (int, int) { return sw.try_acquire(); } );
+    };
+    BENCHMARK ( "keyed_rate_limiter, 64K keys" + suffix ) {
+      return contend(n, [&kl] (int t, int i) {
+          return kl.try_acquire(static_cast<std::uint64_t>(t * OpsPerThread + i) & 0xffffu); } );
+    };
+  }
+}
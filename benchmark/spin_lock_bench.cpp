@@ -0,0 +1,67 @@
+/** @file
+ *
+ * @brief Benchmark of a short critical section under contention, comparing
+ * @c std::mutex, @c spin_lock, and @c hybrid_mutex from 1 to 16 threads.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utility/spin_lock.hpp"
+#include "utility/repeat.hpp"
+
+constexpr int MaxThreads = 16;
+constexpr int OpsPerThread = 20000;
+
+template <typename M>
+std::uint64_t contend (M& mtx, int num_thrs) {
+  std::uint64_t counter = 0u;
+  std::vector<std::thread> thrs;
+  chops::repeat(num_thrs, [&] {
+    thrs.emplace_back([&] {
+      chops::repeat(OpsPerThread, [&] {
+        std::lock_guard lk(mtx);
+        counter += 1u;
+      } );
+    } );
+  } );
+  for (auto& thr : thrs) {
+    thr.join();
+  }
+  return counter;
+}
+
+TEST_CASE ( "Short critical section under contention", "[spin_lock] [hybrid_mutex] [benchmark]" ) {
+
+  std::mutex std_mtx;
+  chops::spin_lock spin;
+  chops::hybrid_mutex hybrid;
+
+  for (int n = 1; n <= MaxThreads; n *= 2) {
+    auto suffix = ", " + std::to_string(n) + " threads";
+
+    BENCHMARK ( "std::mutex" + suffix ) {
+      return contend(std_mtx, n);
+    };
+    BENCHMARK ( "spin_lock" + suffix ) {
+      return contend(spin, n);
+    };
+    BENCHMARK ( "hybrid_mutex" + suffix ) {
+      return contend(hybrid, n);
+    };
+  }
+}
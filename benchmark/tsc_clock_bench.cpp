@@ -0,0 +1,50 @@
+/** @file
+ *
+ * @brief Benchmark of timestamp overhead, comparing @c std::chrono::steady_clock,
+ * @c tsc_clock::now, and raw @c tsc_clock::ticks.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+#include "utility/tsc_clock.hpp"
+
+constexpr int NumCalls = 10000;
+
+TEST_CASE ( "Timestamp overhead", "[tsc_clock] [benchmark]" ) {
+
+  chops::tsc_clock::now(); // calibrate before measuring
+
+  BENCHMARK ( "std::chrono::steady_clock::now" ) {
+    std::int64_t sum = 0;
+    for (int i = 0; i < NumCalls; ++i) {
+      sum += std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+    return sum;
+  };
+  BENCHMARK ( "tsc_clock::now" ) {
+    std::int64_t sum = 0;
+    for (int i = 0; i < NumCalls; ++i) {
+      sum += chops::tsc_clock::now().time_since_epoch().count();
+    }
+    return sum;
+  };
+  BENCHMARK ( "tsc_clock::ticks" ) {
+    std::uint64_t sum = 0u;
+    for (int i = 0; i < NumCalls; ++i) {
+      sum += chops::tsc_clock::ticks();
+    }
+    return sum;
+  };
+}
@@ -0,0 +1,733 @@
+/** @file
+ *
+ * @brief An asynchronous file reader keeping a number of reads in flight through
+ * io_uring, with a thread pool @c pread fallback.
+ *
+ * Reading a large file with blocking @c read calls leaves the device idle while the
+ * data of each call is processed, and at most one request queued. @c async_file_reader
+ * keeps up to @c queue_depth reads in flight, each into its own buffer from a pool
+ * allocated once, so the device always has work queued.
+ *
+ * On Linux the reads go through io_uring, set up with the raw @c io_uring_setup and
+ * @c io_uring_enter system calls and the shared rings mapped directly (no liburing
+ * dependency). Reads queued by @c read are batched and passed to the kernel with one
+ * @c io_uring_enter call by @c submit, @c poll or @c wait. Where io_uring is not
+ * available (older kernels, or blocked by a seccomp policy), or when disabled in the
+ * options, reads are run with @c pread on an internal @c thread_pool instead; the
+ * interface and completion behavior are the same.
+ *
+ * Completion handlers are @c read_handler objects, small buffer callables which store
+ * the function object inline (no allocation per read; a function object larger than
+ * @c read_handler::capacity fails to compile). Handlers run on the thread calling
+ * @c read, @c poll, @c wait or @c drain, never on a kernel or pool thread, and may
+ * queue further reads. The data span passed to a handler refers to a pooled buffer and
+ * is valid only until the handler returns. Completions of independent reads may arrive
+ * in any order; @c read_file reads a whole file delivering chunks in file order.
+ *
+ * An @c async_file_reader is not thread safe; it is intended to be owned by one thread.
+ * The destructor waits for reads in flight without invoking their handlers.
+ *
+ * @code
+ * chops::async_file_reader rdr({ .queue_depth = 16u, .buffer_size = 256u * 1024u });
+ * auto ec = rdr.read_file("capture.bin", [&] (std::uint64_t offset, std::span<const std::byte> data) {
+ *     replay(offset, data);
+ *   } );
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef ASYNC_FILE_READER_HPP_INCLUDED
+#define ASYNC_FILE_READER_HPP_INCLUDED
+
+#include <cassert>
+#include <concepts> // std::invocable
+#include <condition_variable>
+#include <cstddef> // std::byte, std::size_t, std::max_align_t
+#include <cstdint> // std::uint64_t, std::uint32_t
+#include <memory> // std::unique_ptr, std::make_unique_for_overwrite
+#include <mutex>
+#include <new> // placement new
+#include <span>
+#include <stdexcept> // std::invalid_argument
+#include <system_error> // std::error_code, std::system_error
+#include <type_traits>
+#include <utility> // std::move, std::forward, std::exchange
+#include <vector>
+
+#if defined(__linux__)
+#include <atomic> // std::atomic_ref
+#include <cerrno>
+#include <cstring> // std::memset
+#include <fcntl.h> // open, posix_fadvise
+#include <sys/stat.h> // fstat
+#include <sys/syscall.h>
+#include <sys/uio.h> // iovec
+#include <unistd.h> // pread, close, syscall
+
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#include <sys/mman.h> // mmap, munmap
+#define CHOPS_HAS_IO_URING 1
+#else
+#define CHOPS_HAS_IO_URING 0
+#endif
+
+#include "utility/thread_pool.hpp"
+#endif
+
+namespace chops {
+
+#if defined(__linux__)
+
+/**
+ * @brief The outcome of one read, passed to its @c read_handler.
+ */
+struct read_result {
+  int                        fd { -1 };
+  std::uint64_t              offset { 0u };
+/** @brief Bytes read, shorter than requested at end of file; valid during the handler. */
+  std::span<const std::byte> data;
+/** @brief The @c errno value of a failed read, with @c data empty. */
+  std::error_code            error;
+};
+
+/**
+ * @brief A move only callable taking a @c read_result, storing the function object
+ * inline.
+ */
+class read_handler {
+public:
+  static constexpr std::size_t capacity = 6u * sizeof(void*);
+
+  read_handler() noexcept = default;
+
+  template <typename F>
+    requires (!std::same_as<std::remove_cvref_t<F>, read_handler> &&
+              std::invocable<std::decay_t<F>&, const read_result&>)
+  read_handler(F&& func) {
+    using D = std::decay_t<F>;
+    static_assert(sizeof(D) <= capacity, "read handler function object too large, capture less or by reference");
+    static_assert(alignof(D) <= alignof(std::max_align_t), "read handler function object over aligned");
+    static_assert(std::is_nothrow_move_constructible_v<D>, "read handler function object must be nothrow movable");
+    ::new (static_cast<void*>(m_storage)) D(std::forward<F>(func));
+    m_ops = &ops_for<D>;
+  }
+
+  read_handler(read_handler&& rhs) noexcept : m_ops(std::exchange(rhs.m_ops, nullptr)) {
+    if (m_ops) {
+      m_ops->move(m_storage, rhs.m_storage);
+    }
+  }
+
+  read_handler& operator=(read_handler&& rhs) noexcept {
+    if (this != &rhs) {
+      reset();
+      m_ops = std::exchange(rhs.m_ops, nullptr);
+      if (m_ops) {
+        m_ops->move(m_storage, rhs.m_storage);
+      }
+    }
+    return *this;
+  }
+
+  ~read_handler() { reset(); }
+
+  explicit operator bool() const noexcept { return m_ops != nullptr; }
+
+  void operator()(const read_result& res) {
+    assert(m_ops);
+    m_ops->call(m_storage, res);
+  }
+
+  void reset() noexcept {
+    if (m_ops) {
+      m_ops->destroy(m_storage);
+      m_ops = nullptr;
+    }
+  }
+
+private:
+  struct ops {
+    void (*call)(void*, const read_result&);
+    void (*move)(void*, void*) noexcept; // move constructs into the first, destroys the second
+    void (*destroy)(void*) noexcept;
+  };
+
+  template <typename D>
+  static constexpr ops ops_for {
+    [] (void* p, const read_result& res) { (*static_cast<D*>(p))(res); },
+    [] (void* dst, void* src) noexcept {
+      ::new (dst) D(std::move(*static_cast<D*>(src)));
+      static_cast<D*>(src)->~D();
+    },
+    [] (void* p) noexcept { static_cast<D*>(p)->~D(); }
+  };
+
+  alignas(std::max_align_t) std::byte m_storage[capacity];
+  const ops*                          m_ops { nullptr };
+};
+
+/**
+ * @brief Configuration for @c async_file_reader.
+ */
+struct async_reader_options {
+/** @brief Maximum number of reads in flight, each with its own buffer. */
+  std::size_t queue_depth { 32u };
+/** @brief Size of each pooled buffer, the largest single read. */
+  std::size_t buffer_size { 128u * 1024u };
+/** @brief Use io_uring when available; @c false forces the @c pread fallback. */
+  bool        use_io_uring { true };
+/** @brief Threads for the @c pread fallback, 0 for one per read in flight. */
+  std::size_t fallback_threads { 4u };
+};
+
+namespace detail {
+
+#if CHOPS_HAS_IO_URING
+// the submission and completion rings of one io_uring instance, mapped from the kernel
+class io_uring_ring {
+public:
+  io_uring_ring() noexcept = default;
+  io_uring_ring(const io_uring_ring&) = delete;
+  io_uring_ring& operator=(const io_uring_ring&) = delete;
+
+  ~io_uring_ring() { close(); }
+
+  // false if io_uring is not available, leaving the ring invalid
+  bool setup(unsigned entries) noexcept {
+    ::io_uring_params p;
+    std::memset(&p, 0, sizeof(p));
+    auto fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &p));
+    if (fd < 0) {
+      return false;
+    }
+    m_fd = fd;
+    m_sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    m_cq_size = p.cq_off.cqes + p.cq_entries * sizeof(::io_uring_cqe);
+    bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0u;
+    if (single) {
+      m_sq_size = m_cq_size = (m_sq_size > m_cq_size) ? m_sq_size : m_cq_size;
+    }
+    m_sq_ptr = map(m_sq_size, IORING_OFF_SQ_RING);
+    m_cq_ptr = single ? m_sq_ptr : map(m_cq_size, IORING_OFF_CQ_RING);
+    m_sqes_size = p.sq_entries * sizeof(::io_uring_sqe);
+    m_sqes = static_cast<::io_uring_sqe*>(map(m_sqes_size, IORING_OFF_SQES));
+    if (!m_sq_ptr || !m_cq_ptr || !m_sqes) {
+      close();
+      return false;
+    }
+    auto* sq = static_cast<std::byte*>(m_sq_ptr);
+    auto* cq = static_cast<std::byte*>(m_cq_ptr);
+    m_sq_tail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+    m_sq_mask = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+    m_sq_array = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+    m_cq_head = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+    m_cq_tail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+    m_cq_mask = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<::io_uring_cqe*>(cq + p.cq_off.cqes);
+    return true;
+  }
+
+  bool valid() const noexcept { return m_fd >= 0; }
+
+  // the caller keeps the number of unsubmitted plus in flight entries within the ring size
+  void push_readv(int fd, const ::iovec* iov, std::uint64_t offset, std::uint64_t user_data) noexcept {
+    auto tail = *m_sq_tail; // only written by this thread
+    auto idx = tail & m_sq_mask;
+    auto& sqe = m_sqes[idx];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_READV;
+    sqe.fd = fd;
+    sqe.off = offset;
+    sqe.addr = reinterpret_cast<std::uint64_t>(iov);
+    sqe.len = 1u;
+    sqe.user_data = user_data;
+    m_sq_array[idx] = idx;
+    std::atomic_ref<unsigned>(*m_sq_tail).store(tail + 1u, std::memory_order_release);
+  }
+
+  // number of entries submitted, or -errno
+  int enter(unsigned to_submit, unsigned min_complete) noexcept {
+    auto r = ::syscall(__NR_io_uring_enter, m_fd, to_submit, min_complete,
+                       (min_complete > 0u) ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+    return (r < 0) ? -errno : static_cast<int>(r);
+  }
+
+  // copies out and consumes the oldest completion, if any
+  bool pop_cqe(::io_uring_cqe& cqe) noexcept {
+    auto head = *m_cq_head; // only written by this thread
+    if (head == std::atomic_ref<unsigned>(*m_cq_tail).load(std::memory_order_acquire)) {
+      return false;
+    }
+    cqe = m_cqes[head & m_cq_mask];
+    std::atomic_ref<unsigned>(*m_cq_head).store(head + 1u, std::memory_order_release);
+    return true;
+  }
+
+private:
+  void* map(std::size_t size, std::uint64_t offset) noexcept {
+    auto* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     m_fd, static_cast<off_t>(offset));
+    return (p == MAP_FAILED) ? nullptr : p;
+  }
+
+  void close() noexcept {
+    if (m_sqes) {
+      ::munmap(m_sqes, m_sqes_size);
+    }
+    if (m_cq_ptr && m_cq_ptr != m_sq_ptr) {
+      ::munmap(m_cq_ptr, m_cq_size);
+    }
+    if (m_sq_ptr) {
+      ::munmap(m_sq_ptr, m_sq_size);
+    }
+    if (m_fd >= 0) {
+      ::close(m_fd);
+    }
+    m_sqes = nullptr;
+    m_cq_ptr = m_sq_ptr = nullptr;
+    m_fd = -1;
+  }
+
+private:
+  int             m_fd { -1 };
+  void*           m_sq_ptr { nullptr };
+  void*           m_cq_ptr { nullptr };
+  std::size_t     m_sq_size { 0u };
+  std::size_t     m_cq_size { 0u };
+  std::size_t     m_sqes_size { 0u };
+  ::io_uring_sqe* m_sqes { nullptr };
+  unsigned*       m_sq_tail { nullptr };
+  unsigned*       m_sq_array { nullptr };
+  unsigned        m_sq_mask { 0u };
+  unsigned*       m_cq_head { nullptr };
+  unsigned*       m_cq_tail { nullptr };
+  unsigned        m_cq_mask { 0u };
+  ::io_uring_cqe* m_cqes { nullptr };
+};
+#endif
+
+}
+
+/**
+ * @brief Reads files with a number of reads in flight, through io_uring or a thread
+ * pool.
+ */
+class async_file_reader {
+public:
+
+/**
+ * @brief Allocate the buffer pool and set up io_uring, or the fallback thread pool.
+ *
+ * @throw std::invalid_argument if the queue depth or buffer size is 0.
+ */
+  explicit async_file_reader(const async_reader_options& opts = async_reader_options { }) :
+      m_opts(opts) {
+    if (opts.queue_depth == 0u || opts.buffer_size == 0u) {
+      throw std::invalid_argument("async_file_reader queue depth and buffer size must be non-zero");
+    }
+    m_buffers = std::make_unique_for_overwrite<std::byte[]>(opts.queue_depth * opts.buffer_size);
+    m_slots = std::vector<read_slot>(opts.queue_depth);
+    m_free.reserve(opts.queue_depth);
+    for (std::size_t i = opts.queue_depth; i > 0u; --i) {
+      m_slots[i - 1u].m_buf = m_buffers.get() + (i - 1u) * opts.buffer_size;
+      m_free.push_back(static_cast<std::uint32_t>(i - 1u));
+    }
+#if CHOPS_HAS_IO_URING
+    if (opts.use_io_uring) {
+      m_ring.setup(static_cast<unsigned>(opts.queue_depth));
+    }
+    if (m_ring.valid()) {
+      return;
+    }
+#endif
+    m_queued.reserve(opts.queue_depth);
+    m_done.reserve(opts.queue_depth);
+    m_pool = std::make_unique<thread_pool>(
+        (opts.fallback_threads == 0u) ? opts.queue_depth : opts.fallback_threads, false);
+  }
+
+  async_file_reader(const async_file_reader&) = delete;
+  async_file_reader& operator=(const async_file_reader&) = delete;
+
+/**
+ * @brief Wait for the reads in flight, discarding their handlers.
+ */
+  ~async_file_reader() {
+    for (auto& s : m_slots) {
+      s.m_handler.reset();
+    }
+    m_discard = true;
+    try {
+      drain();
+    }
+    catch (...) {
+    }
+  }
+
+/**
+ * @brief Queue a read of up to @c buffer_size bytes at @c offset of @c fd.
+ *
+ * If @c queue_depth reads are already in flight, submits and processes completions
+ * until a buffer is free. The read is passed to the kernel (or pool) by the next
+ * @c submit, @c poll or @c wait.
+ *
+ * @throw std::invalid_argument if @c len is larger than the buffer size.
+ */
+  void read(int fd, std::uint64_t offset, std::size_t len, read_handler handler) {
+    if (len > m_opts.buffer_size) {
+      throw std::invalid_argument("async_file_reader read larger than the buffer size");
+    }
+    assert(!m_ordered_active);
+    while (m_free.empty()) {
+      wait();
+    }
+    auto s = m_free.back();
+    m_free.pop_back();
+    m_slots[s].m_handler = std::move(handler);
+    m_slots[s].m_ordered = false;
+    queue(s, fd, offset, len);
+  }
+
+/**
+ * @brief Pass the queued reads to the kernel or the fallback pool.
+ */
+  void submit() {
+#if CHOPS_HAS_IO_URING
+    if (m_ring.valid()) {
+      while (m_unsubmitted > 0u) {
+        auto r = m_ring.enter(m_unsubmitted, 0u);
+        if (r == -EINTR) {
+          continue;
+        }
+        if (r == -EAGAIN || r == -EBUSY) {
+          return; // retried by the next submit or wait
+        }
+        if (r < 0) {
+          throw std::system_error(-r, std::generic_category(), "io_uring_enter");
+        }
+        m_unsubmitted -= static_cast<unsigned>(r);
+      }
+      return;
+    }
+#endif
+    for (auto s : m_queued) {
+      auto& sl = m_slots[s];
+      m_pool->post([this, s, fd = sl.m_fd, buf = sl.m_buf, len = sl.m_len, off = sl.m_offset] {
+          ssize_t n;
+          do {
+            n = ::pread(fd, buf, len, static_cast<off_t>(off));
+          } while (n < 0 && errno == EINTR);
+          int res = (n < 0) ? -errno : static_cast<int>(n);
+          {
+            std::lock_guard lk(m_done_mutex);
+            m_done.push_back(completion { s, res });
+          }
+          m_done_cv.notify_one();
+        } );
+    }
+    m_queued.clear();
+  }
+
+/**
+ * @brief Submit queued reads and run the handlers of completed reads, without
+ * waiting.
+ *
+ * @return Number of completions processed.
+ */
+  std::size_t poll() {
+    submit();
+    return process();
+  }
+
+/**
+ * @brief Submit queued reads and wait until at least one read completes, running the
+ * handlers of completed reads.
+ *
+ * @return Number of completions processed, 0 only if no reads are in flight.
+ */
+  std::size_t wait() {
+    submit();
+    for (;;) {
+      auto cnt = process();
+      if (cnt > 0u || m_in_flight == 0u) {
+        return cnt;
+      }
+#if CHOPS_HAS_IO_URING
+      if (m_ring.valid()) {
+        auto r = m_ring.enter(m_unsubmitted, 1u);
+        if (r >= 0) {
+          m_unsubmitted -= static_cast<unsigned>(r);
+        }
+        else if (r != -EINTR && r != -EAGAIN && r != -EBUSY) {
+          throw std::system_error(-r, std::generic_category(), "io_uring_enter");
+        }
+        continue;
+      }
+#endif
+      std::unique_lock lk(m_done_mutex);
+      m_done_cv.wait(lk, [this] { return m_done_next < m_done.size(); } );
+    }
+  }
+
+/**
+ * @brief Wait for all reads in flight, running their handlers.
+ */
+  void drain() {
+    while (m_in_flight > 0u) {
+      wait();
+    }
+  }
+
+/**
+ * @brief Read a whole regular file in @c buffer_size chunks, with up to
+ * @c queue_depth reads in flight, invoking @c on_chunk(offset, data) for each chunk in
+ * file order.
+ *
+ * Reads queued by @c read are completed first. @c on_chunk must not queue reads on
+ * this reader; the data span is valid only until it returns.
+ *
+ * @return An empty error code on success, otherwise the @c errno value of the first
+ * failed read (chunks before it have been delivered).
+ */
+  template <typename F>
+  std::error_code read_file(int fd, F&& on_chunk) {
+    drain();
+    struct ::stat st;
+    if (::fstat(fd, &st) != 0) {
+      return std::error_code(errno, std::generic_category());
+    }
+    auto size = static_cast<std::uint64_t>(st.st_size);
+    auto bs = static_cast<std::uint64_t>(m_opts.buffer_size);
+    auto depth = m_slots.size();
+    auto chunks = (size + bs - 1u) / bs;
+    auto chunk_len = [size, bs] (std::uint64_t c) {
+      return static_cast<std::size_t>((size - c * bs < bs) ? size - c * bs : bs);
+    };
+    // chunk c uses slot c % depth; the free list is left alone, since no other reads run
+    ordered_guard guard { *this };
+    std::uint64_t next = 0u;
+    for (; next < chunks && next < depth; ++next) {
+      queue_ordered(next, fd, next * bs, chunk_len(next));
+    }
+    for (std::uint64_t c = 0u; c < chunks; ++c) {
+      auto& sl = m_slots[static_cast<std::size_t>(c % depth)];
+      while (!sl.m_done) {
+        wait();
+      }
+      if (sl.m_res < 0) {
+        return std::error_code(-sl.m_res, std::generic_category());
+      }
+      // complete a short read synchronously, so chunks stay contiguous
+      auto want = chunk_len(c);
+      auto got = static_cast<std::size_t>(sl.m_res);
+      while (got < want) {
+        auto n = ::pread(fd, sl.m_buf + got, want - got, static_cast<off_t>(c * bs + got));
+        if (n < 0 && errno == EINTR) {
+          continue;
+        }
+        if (n < 0) {
+          return std::error_code(errno, std::generic_category());
+        }
+        if (n == 0) {
+          break;
+        }
+        got += static_cast<std::size_t>(n);
+      }
+      on_chunk(c * bs, std::span<const std::byte>(sl.m_buf, got));
+      if (got < want) {
+        return { }; // file truncated while reading
+      }
+      if (next < chunks) {
+        queue_ordered(next, fd, next * bs, chunk_len(next));
+        ++next;
+      }
+    }
+    return { };
+  }
+
+/**
+ * @brief Open a file and read it with @c read_file(fd, on_chunk).
+ */
+  template <typename F>
+  std::error_code read_file(const char* path, F&& on_chunk) {
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return std::error_code(errno, std::generic_category());
+    }
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    std::error_code ec;
+    try {
+      ec = read_file(fd, std::forward<F>(on_chunk));
+    }
+    catch (...) {
+      ::close(fd);
+      throw;
+    }
+    ::close(fd);
+    return ec;
+  }
+
+/**
+ * @brief @c true if reads go through io_uring, @c false for the @c pread fallback.
+ */
+  bool uses_io_uring() const noexcept {
+#if CHOPS_HAS_IO_URING
+    return m_ring.valid();
+#else
+    return false;
+#endif
+  }
+
+  std::size_t in_flight() const noexcept { return m_in_flight; }
+  std::size_t queue_depth() const noexcept { return m_opts.queue_depth; }
+  std::size_t buffer_size() const noexcept { return m_opts.buffer_size; }
+
+private:
+  struct read_slot {
+    std::byte*    m_buf { nullptr };
+    ::iovec       m_iov { };
+    read_handler  m_handler;
+    int           m_fd { -1 };
+    std::uint64_t m_offset { 0u };
+    std::size_t   m_len { 0u };
+    int           m_res { 0 }; // bytes read or -errno, for ordered reads
+    bool          m_ordered { false };
+    bool          m_done { false };
+  };
+
+  struct completion {
+    std::uint32_t m_slot;
+    int           m_res;
+  };
+
+  // waits for the ordered reads in flight when read_file returns or throws
+  struct ordered_guard {
+    async_file_reader& m_rdr;
+    explicit ordered_guard(async_file_reader& rdr) noexcept : m_rdr(rdr) { m_rdr.m_ordered_active = true; }
+    ~ordered_guard() {
+      m_rdr.m_discard = true;
+      try {
+        m_rdr.drain();
+      }
+      catch (...) {
+      }
+      m_rdr.m_discard = false;
+      m_rdr.m_ordered_active = false;
+    }
+  };
+
+  void queue(std::uint32_t s, int fd, std::uint64_t offset, std::size_t len) {
+    auto& sl = m_slots[s];
+    sl.m_fd = fd;
+    sl.m_offset = offset;
+    sl.m_len = len;
+    sl.m_done = false;
+    ++m_in_flight;
+#if CHOPS_HAS_IO_URING
+    if (m_ring.valid()) {
+      sl.m_iov = ::iovec { sl.m_buf, len };
+      m_ring.push_readv(fd, &sl.m_iov, offset, s);
+      ++m_unsubmitted;
+      return;
+    }
+#endif
+    m_queued.push_back(s);
+  }
+
+  void queue_ordered(std::uint64_t chunk, int fd, std::uint64_t offset, std::size_t len) {
+    auto s = static_cast<std::uint32_t>(chunk % m_slots.size());
+    m_slots[s].m_ordered = true;
+    queue(s, fd, offset, len);
+  }
+
+  // takes the next completion, from the ring or the fallback pool
+  bool next_completion(completion& c) {
+#if CHOPS_HAS_IO_URING
+    if (m_ring.valid()) {
+      ::io_uring_cqe cqe;
+      if (!m_ring.pop_cqe(cqe)) {
+        return false;
+      }
+      c = completion { static_cast<std::uint32_t>(cqe.user_data), cqe.res };
+      return true;
+    }
+#endif
+    std::lock_guard lk(m_done_mutex);
+    if (m_done_next == m_done.size()) {
+      m_done.clear();
+      m_done_next = 0u;
+      return false;
+    }
+    c = m_done[m_done_next++];
+    return true;
+  }
+
+  std::size_t process() {
+    std::size_t cnt = 0u;
+    completion c { };
+    while (next_completion(c)) {
+      ++cnt;
+      --m_in_flight;
+      auto& sl = m_slots[c.m_slot];
+      if (sl.m_ordered) {
+        sl.m_res = c.m_res;
+        sl.m_done = true;
+        continue;
+      }
+      // the buffer returns to the pool when the handler finishes, even if it throws
+      struct release {
+        async_file_reader& m_rdr;
+        std::uint32_t      m_slot;
+        ~release() { m_rdr.m_free.push_back(m_slot); }
+      } rel { *this, c.m_slot };
+      auto handler = std::move(sl.m_handler);
+      if (m_discard || !handler) {
+        continue;
+      }
+      read_result res { sl.m_fd, sl.m_offset, { }, { } };
+      if (c.m_res < 0) {
+        res.error = std::error_code(-c.m_res, std::generic_category());
+      }
+      else {
+        res.data = std::span<const std::byte>(sl.m_buf, static_cast<std::size_t>(c.m_res));
+      }
+      handler(res);
+    }
+    return cnt;
+  }
+
+private:
+  async_reader_options           m_opts;
+  std::unique_ptr<std::byte[]>   m_buffers;
+  std::vector<read_slot>         m_slots;
+  std::vector<std::uint32_t>     m_free;
+  std::size_t                    m_in_flight { 0u };
+  bool                           m_ordered_active { false };
+  bool                           m_discard { false };
+#if CHOPS_HAS_IO_URING
+  detail::io_uring_ring          m_ring;
+  unsigned                       m_unsubmitted { 0u };
+#endif
+  // fallback
+  std::vector<std::uint32_t>     m_queued;
+  std::mutex                     m_done_mutex;
+  std::condition_variable        m_done_cv;
+  std::vector<completion>        m_done;
+  std::size_t                    m_done_next { 0u };
+  std::unique_ptr<thread_pool>   m_pool;
+};
+
+#endif
+
+} // end namespace
+
+#endif
+
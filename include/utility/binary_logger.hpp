@@ -0,0 +1,582 @@
+/** @file
+ *
+ * @brief A deferred formatting logger, copying raw argument bytes into per-thread
+ * rings on the hot path and formatting (or writing binary records) on a background
+ * thread.
+ *
+ * Formatting a log line (converting numbers to text, copying strings, building the
+ * line) typically costs hundreds of nanoseconds to microseconds, which is too much for
+ * a latency sensitive thread. @c binary_logger::log instead copies a pointer to the
+ * format string, a pointer to a static table of argument type tags, a raw time stamp
+ * counter value (@c tsc_clock::ticks), and the bytes of each argument into a
+ * single producer, single consumer byte ring (@c spsc_byte_ring) owned by the calling
+ * thread. There are no locks, no allocations (after a thread's first call), and no
+ * formatting; the cost is dominated by reading the time stamp counter.
+ *
+ * A background thread drains the rings periodically (and on @c flush), and either
+ * formats each entry as a text line, or writes compact binary records (a dictionary
+ * record the first time each format string is seen, then entry records holding only
+ * the dictionary id, thread index, time stamp, and argument bytes) for offline
+ * decoding with @c decode_binary_log. The output is passed to a user supplied writer
+ * function in batches, one call per drain pass.
+ *
+ * The format string must be a string literal (or otherwise have static storage
+ * duration), since only its address is recorded. Each @c {} in the format string is
+ * replaced by the next argument. Supported argument types are the arithmetic types,
+ * @c bool, @c char, and anything convertible to @c std::string_view (string contents
+ * are copied). Floating point values are formatted in fixed notation with 6 digits
+ * after the decimal point.
+ *
+ * If a thread's ring is full the entry is dropped and counted (see @c dropped), rather
+ * than blocking the logging thread. Entries from one thread are output in order;
+ * entries from different threads are interleaved in drain order, not strictly in time
+ * stamp order.
+ *
+ * @code
+ * chops::binary_logger logger([&file] (std::span<const std::byte> buf) { file.write(buf); } );
+ * // ... in a hot path
+ * logger.log("order {} filled {} at {}", order_id, qty, price);
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef BINARY_LOGGER_HPP_INCLUDED
+#define BINARY_LOGGER_HPP_INCLUDED
+
+#include <algorithm> // std::find
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts> // std::integral, std::floating_point, std::convertible_to
+#include <condition_variable>
+#include <cstddef> // std::byte, std::size_t
+#include <cstdint> // std::uint8_t, std::uint32_t, std::uint64_t, std::int64_t, std::uintptr_t
+#include <cstring> // std::memcpy, std::memcmp
+#include <functional> // std::function
+#include <memory> // std::shared_ptr
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <type_traits> // std::remove_cvref_t, std::is_same_v
+#include <unordered_map>
+#include <utility> // std::pair
+#include <vector>
+
+#include "utility/cast_ptr_to.hpp"
+#include "utility/hash_bytes.hpp"
+#include "utility/numeric_text.hpp"
+#include "utility/spsc_byte_ring.hpp"
+#include "utility/tsc_clock.hpp"
+
+namespace chops {
+
+/**
+ * @brief Type tag of a logged argument, as recorded in the rings and binary output.
+ */
+enum class log_arg_type : std::uint8_t {
+  i8, i16, i32, i64, u8, u16, u32, u64, f32, f64, boolean, character, string
+};
+
+/**
+ * @brief Output mode of a @c binary_logger.
+ */
+enum class log_output { text, binary };
+
+namespace detail {
+
+template <typename T>
+concept log_arithmetic = std::integral<T> || std::same_as<T, float> || std::same_as<T, double>;
+
+template <typename T>
+concept loggable = log_arithmetic<std::remove_cvref_t<T>> ||
+                   std::convertible_to<const T&, std::string_view>;
+
+template <typename T>
+constexpr log_arg_type log_type_of() noexcept {
+  using U = std::remove_cvref_t<T>;
+  if constexpr (std::is_same_v<U, bool>) {
+    return log_arg_type::boolean;
+  }
+  else if constexpr (std::is_same_v<U, char>) {
+    return log_arg_type::character;
+  }
+  else if constexpr (std::signed_integral<U>) {
+    return sizeof(U) == 1u ? log_arg_type::i8 : sizeof(U) == 2u ? log_arg_type::i16 :
+           sizeof(U) == 4u ? log_arg_type::i32 : log_arg_type::i64;
+  }
+  else if constexpr (std::unsigned_integral<U>) {
+    return sizeof(U) == 1u ? log_arg_type::u8 : sizeof(U) == 2u ? log_arg_type::u16 :
+           sizeof(U) == 4u ? log_arg_type::u32 : log_arg_type::u64;
+  }
+  else if constexpr (std::is_same_v<U, float>) {
+    return log_arg_type::f32;
+  }
+  else if constexpr (std::is_same_v<U, double>) {
+    return log_arg_type::f64;
+  }
+  else {
+    return log_arg_type::string;
+  }
+}
+
+// one static tag table per argument type list, its address identifies the list
+template <typename... Args>
+inline constexpr std::array<log_arg_type, sizeof...(Args)> log_arg_types { log_type_of<Args>()... };
+
+// fixed size of the encoding of each tag, 0 for strings (u32 length plus characters)
+constexpr std::size_t log_arg_fixed_size(log_arg_type t) noexcept {
+  constexpr std::uint8_t sizes[] = { 1u, 2u, 4u, 8u, 1u, 2u, 4u, 8u, 4u, 8u, 1u, 1u, 0u };
+  return sizes[static_cast<std::uint8_t>(t)];
+}
+
+template <typename T>
+std::size_t log_arg_size(const T& val) noexcept {
+  if constexpr (log_arithmetic<T>) {
+    return sizeof(T);
+  }
+  else {
+    return sizeof(std::uint32_t) + std::string_view(val).size();
+  }
+}
+
+template <typename T>
+std::byte* encode_log_arg(std::byte* p, const T& val) noexcept {
+  if constexpr (log_arithmetic<T>) {
+    std::memcpy(p, &val, sizeof(T));
+    return p + sizeof(T);
+  }
+  else {
+    std::string_view sv(val);
+    auto len = static_cast<std::uint32_t>(sv.size());
+    std::memcpy(p, &len, sizeof(len));
+    std::memcpy(p + sizeof(len), sv.data(), sv.size());
+    return p + sizeof(len) + sv.size();
+  }
+}
+
+// header of each ring entry, followed by the encoded arguments
+struct log_entry_header {
+  const char*         fmt;
+  const log_arg_type* types;
+  std::uint64_t       ticks;
+  std::uint32_t       num_args;
+};
+
+template <typename T>
+T read_log_value(const std::byte* p) noexcept {
+  T v;
+  std::memcpy(&v, p, sizeof(T));
+  return v;
+}
+
+inline void append_log_chars(std::vector<std::byte>& out, std::string_view sv) {
+  auto* p = cast_ptr_to<std::byte>(sv.data());
+  out.insert(out.end(), p, p + sv.size());
+}
+
+// append one argument as text, returns the number of argument bytes consumed or 0
+// if the arguments are truncated
+inline std::size_t format_log_arg(std::vector<std::byte>& out, log_arg_type t,
+                                  std::span<const std::byte> args) {
+  auto sz = log_arg_fixed_size(t);
+  if (t == log_arg_type::string) {
+    if (args.size() < sizeof(std::uint32_t)) {
+      return 0u;
+    }
+    auto len = read_log_value<std::uint32_t>(args.data());
+    if (args.size() - sizeof(std::uint32_t) < len) {
+      return 0u;
+    }
+    auto* p = args.data() + sizeof(std::uint32_t);
+    out.insert(out.end(), p, p + len);
+    return sizeof(std::uint32_t) + len;
+  }
+  if (args.size() < sz) {
+    return 0u;
+  }
+  auto* p = args.data();
+  switch (t) {
+    case log_arg_type::i8: append_decimal(out, read_log_value<std::int8_t>(p)); break;
+    case log_arg_type::i16: append_decimal(out, read_log_value<std::int16_t>(p)); break;
+    case log_arg_type::i32: append_decimal(out, read_log_value<std::int32_t>(p)); break;
+    case log_arg_type::i64: append_decimal(out, read_log_value<std::int64_t>(p)); break;
+    case log_arg_type::u8: append_decimal(out, read_log_value<std::uint8_t>(p)); break;
+    case log_arg_type::u16: append_decimal(out, read_log_value<std::uint16_t>(p)); break;
+    case log_arg_type::u32: append_decimal(out, read_log_value<std::uint32_t>(p)); break;
+    case log_arg_type::u64: append_decimal(out, read_log_value<std::uint64_t>(p)); break;
+    case log_arg_type::f32: append_fixed(out, read_log_value<float>(p), 6); break;
+    case log_arg_type::f64: append_fixed(out, read_log_value<double>(p), 6); break;
+    case log_arg_type::boolean:
+      append_log_chars(out, std::to_integer<std::uint8_t>(*p) != 0u ? "true" : "false");
+      break;
+    case log_arg_type::character: out.push_back(*p); break;
+    default: return 0u;
+  }
+  return sz;
+}
+
+// format "timestamp message\n", replacing each {} with the next argument; returns
+// false if the arguments do not match the type tags
+inline bool format_log_entry(std::vector<std::byte>& out, std::int64_t ts_ns, std::string_view fmt,
+                             std::span<const log_arg_type> types, std::span<const std::byte> args) {
+  append_decimal(out, ts_ns);
+  out.push_back(std::byte{' '});
+  std::size_t arg = 0u;
+  for (;;) {
+    auto pos = fmt.find("{}");
+    if (pos == std::string_view::npos || arg == types.size()) {
+      append_log_chars(out, fmt);
+      break;
+    }
+    append_log_chars(out, fmt.substr(0u, pos));
+    auto used = format_log_arg(out, types[arg], args);
+    if (used == 0u) {
+      return false;
+    }
+    args = args.subspan(used);
+    fmt.remove_prefix(pos + 2u);
+    ++arg;
+  }
+  out.push_back(std::byte{'\n'});
+  return true;
+}
+
+// binary output records, all integers in native byte order
+inline constexpr char binary_log_magic[] = "CHBLOG01";
+constexpr std::size_t binary_log_magic_size = 8u;
+constexpr std::uint8_t log_record_dictionary = 1u;
+constexpr std::uint8_t log_record_entry = 2u;
+
+template <typename T>
+void append_log_value(std::vector<std::byte>& out, T val) {
+  auto* p = cast_ptr_to<std::byte>(&val);
+  out.insert(out.end(), p, p + sizeof(T));
+}
+
+// a thread's ring, shared by the thread's cache and the logger
+struct log_ring {
+  log_ring(std::size_t capacity, std::uint32_t index) : ring(capacity), thread_index(index) { }
+
+  spsc_byte_ring    ring;
+  std::uint32_t     thread_index;
+  std::atomic<bool> thread_exited { false };
+  std::atomic<bool> logger_closed { false };
+};
+
+inline std::atomic<std::uint64_t> next_logger_id { 1u };
+
+// per-thread cache of this thread's ring in each logger, the rings are marked when
+// the thread exits so the logger can remove them once drained
+struct log_ring_cache {
+  std::uint64_t last_id { 0u };
+  log_ring*     last { nullptr };
+  std::vector<std::pair<std::uint64_t, std::shared_ptr<log_ring>>> entries;
+
+  ~log_ring_cache() {
+    for (auto& e : entries) {
+      e.second->thread_exited.store(true, std::memory_order_release);
+    }
+  }
+};
+
+inline log_ring_cache& local_log_rings() {
+  thread_local log_ring_cache c;
+  return c;
+}
+
+struct log_key_hash {
+  std::size_t operator()(const std::pair<const char*, const log_arg_type*>& k) const noexcept {
+    return static_cast<std::size_t>(hash_mix(reinterpret_cast<std::uintptr_t>(k.first),
+                                             reinterpret_cast<std::uintptr_t>(k.second)));
+  }
+};
+
+} // end detail namespace
+
+/**
+ * @brief Logger recording raw arguments on the calling thread and formatting or
+ * writing them on a background thread.
+ *
+ * A logger must outlive all calls to its @c log function.
+ */
+class binary_logger {
+public:
+
+  using writer_type = std::function<void (std::span<const std::byte>)>;
+
+/**
+ * @brief Construct the logger and start its background thread.
+ *
+ * @param writer Function called from the background thread with each batch of output.
+ *
+ * @param output Whether to write formatted text lines or binary records.
+ *
+ * @param ring_capacity Size in bytes of each thread's ring.
+ *
+ * @param poll_interval Interval at which the background thread drains the rings.
+ */
+  explicit binary_logger(writer_type writer, log_output output = log_output::text,
+                         std::size_t ring_capacity = 1u << 18u,
+                         std::chrono::milliseconds poll_interval = std::chrono::milliseconds(10)) :
+      m_writer(std::move(writer)), m_output(output), m_ring_capacity(ring_capacity),
+      m_poll_interval(poll_interval) {
+    if (m_output == log_output::binary) {
+      detail::append_log_chars(m_out, std::string_view(detail::binary_log_magic, detail::binary_log_magic_size));
+    }
+    m_thr = std::thread([this] { run(); } );
+  }
+
+/**
+ * @brief Output all remaining entries and stop the background thread.
+ */
+  ~binary_logger() {
+    {
+      std::lock_guard lk(m_mutex);
+      m_stop = true;
+    }
+    m_cv.notify_one();
+    m_thr.join();
+    for (auto& r : m_rings) {
+      r->logger_closed.store(true, std::memory_order_release);
+    }
+  }
+
+  binary_logger(const binary_logger&) = delete;
+  binary_logger& operator=(const binary_logger&) = delete;
+
+/**
+ * @brief Record a log entry.
+ *
+ * @param fmt Format string literal, each @c {} is replaced by the next argument.
+ *
+ * @return @c false if the calling thread's ring was full and the entry was dropped.
+ */
+  template <std::size_t N, typename... Args>
+    requires (detail::loggable<Args> && ...)
+  bool log(const char (&fmt)[N], const Args&... args) {
+    auto& r = local_ring();
+    auto size = sizeof(detail::log_entry_header) + (std::size_t{0u} + ... + detail::log_arg_size(args));
+    auto sp = r.ring.try_reserve(size);
+    if (sp.data() == nullptr) {
+      m_dropped.fetch_add(1u, std::memory_order_relaxed);
+      return false;
+    }
+    detail::log_entry_header hdr { fmt, detail::log_arg_types<Args...>.data(), tsc_clock::ticks(),
+                                   static_cast<std::uint32_t>(sizeof...(Args)) };
+    std::memcpy(sp.data(), &hdr, sizeof(hdr));
+    [[maybe_unused]] auto* p = sp.data() + sizeof(hdr);
+    ((p = detail::encode_log_arg(p, args)), ...);
+    r.ring.commit();
+    return true;
+  }
+
+/**
+ * @brief Block until all entries recorded before the call have been written.
+ */
+  void flush() {
+    std::unique_lock lk(m_mutex);
+    auto target = ++m_flush_requested;
+    m_cv.notify_one();
+    m_flush_cv.wait(lk, [this, target] { return m_flush_done >= target; } );
+  }
+
+/**
+ * @brief Number of entries dropped because a ring was full.
+ */
+  std::uint64_t dropped() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+
+  detail::log_ring& local_ring() {
+    auto& c = detail::local_log_rings();
+    if (c.last_id == m_id) {
+      return *c.last;
+    }
+    return register_thread(c);
+  }
+
+  detail::log_ring& register_thread(detail::log_ring_cache& c) {
+    std::erase_if(c.entries, [] (const auto& e) {
+        return e.second->logger_closed.load(std::memory_order_acquire); } );
+    detail::log_ring* r = nullptr;
+    for (auto& e : c.entries) {
+      if (e.first == m_id) {
+        r = e.second.get();
+      }
+    }
+    if (r == nullptr) {
+      std::lock_guard lk(m_mutex);
+      auto sp = std::make_shared<detail::log_ring>(m_ring_capacity, m_next_thread++);
+      m_rings.push_back(sp);
+      c.entries.emplace_back(m_id, sp);
+      r = sp.get();
+    }
+    c.last_id = m_id;
+    c.last = r;
+    return *r;
+  }
+
+  void run() {
+    std::unique_lock lk(m_mutex);
+    for (;;) {
+      auto flush_target = m_flush_requested;
+      auto stop = m_stop;
+      m_snapshot = m_rings;
+      lk.unlock();
+      drain();
+      lk.lock();
+      // remove rings of exited threads, which have been fully drained
+      std::erase_if(m_rings, [this] (const auto& r) {
+          return std::find(m_exited.begin(), m_exited.end(), r.get()) != m_exited.end(); } );
+      m_exited.clear();
+      m_flush_done = flush_target;
+      m_flush_cv.notify_all();
+      if (stop) {
+        break;
+      }
+      m_cv.wait_for(lk, m_poll_interval, [this] { return m_stop || m_flush_requested != m_flush_done; } );
+    }
+  }
+
+  void drain() {
+    for (auto& r : m_snapshot) {
+      // checked before draining, so an exited thread's last entries are included
+      if (r->thread_exited.load(std::memory_order_acquire)) {
+        m_exited.push_back(r.get());
+      }
+      r->ring.consume_all([this, idx = r->thread_index] (std::span<const std::byte> rec) {
+          output_entry(idx, rec); } );
+    }
+    m_snapshot.clear();
+    if (!m_out.empty()) {
+      m_writer(std::span<const std::byte>(m_out));
+      m_out.clear();
+    }
+  }
+
+  void output_entry(std::uint32_t thread_index, std::span<const std::byte> rec) {
+    detail::log_entry_header hdr;
+    std::memcpy(&hdr, rec.data(), sizeof(hdr));
+    auto args = rec.subspan(sizeof(hdr));
+    auto ts = tsc_clock::from_ticks(hdr.ticks).time_since_epoch().count();
+    if (m_output == log_output::text) {
+      detail::format_log_entry(m_out, ts, hdr.fmt, std::span<const log_arg_type>(hdr.types, hdr.num_args), args);
+      return;
+    }
+    auto [it, inserted] = m_dictionary.try_emplace(std::pair(hdr.fmt, hdr.types),
+                                                   static_cast<std::uint32_t>(m_dictionary.size()));
+    if (inserted) {
+      std::string_view fmt(hdr.fmt);
+      m_out.push_back(std::byte{detail::log_record_dictionary});
+      detail::append_log_value(m_out, it->second);
+      detail::append_log_value(m_out, static_cast<std::uint32_t>(fmt.size()));
+      detail::append_log_value(m_out, hdr.num_args);
+      detail::append_log_chars(m_out, fmt);
+      auto* t = cast_ptr_to<std::byte>(hdr.types);
+      m_out.insert(m_out.end(), t, t + hdr.num_args);
+    }
+    m_out.push_back(std::byte{detail::log_record_entry});
+    detail::append_log_value(m_out, it->second);
+    detail::append_log_value(m_out, thread_index);
+    detail::append_log_value(m_out, ts);
+    detail::append_log_value(m_out, static_cast<std::uint32_t>(args.size()));
+    m_out.insert(m_out.end(), args.begin(), args.end());
+  }
+
+private:
+  using dictionary_type = std::unordered_map<std::pair<const char*, const log_arg_type*>, std::uint32_t,
+                                             detail::log_key_hash>;
+
+  const std::uint64_t        m_id { detail::next_logger_id.fetch_add(1u, std::memory_order_relaxed) };
+  writer_type                m_writer;
+  log_output                 m_output;
+  std::size_t                m_ring_capacity;
+  std::chrono::milliseconds  m_poll_interval;
+  std::atomic<std::uint64_t> m_dropped { 0u };
+
+  std::mutex                 m_mutex;
+  std::condition_variable    m_cv;
+  std::condition_variable    m_flush_cv;
+  bool                       m_stop { false };
+  std::uint64_t              m_flush_requested { 0u };
+  std::uint64_t              m_flush_done { 0u };
+  std::uint32_t              m_next_thread { 0u };
+  std::vector<std::shared_ptr<detail::log_ring>> m_rings;
+
+  // background thread only
+  std::vector<std::shared_ptr<detail::log_ring>> m_snapshot;
+  std::vector<detail::log_ring*>                 m_exited;
+  std::vector<std::byte>                         m_out;
+  dictionary_type                                m_dictionary;
+  std::thread                                    m_thr;
+};
+
+/**
+ * @brief Decode the binary output of a @c binary_logger to text lines, in the same
+ * format as the text output.
+ *
+ * The whole log (starting with its header) must be passed in one call, since entry
+ * records refer to dictionary records written earlier.
+ *
+ * @return @c false if the log is malformed or truncated; lines decoded before the
+ * error are still appended.
+ */
+inline bool decode_binary_log(std::span<const std::byte> log, std::vector<std::byte>& text) {
+  if (log.size() < detail::binary_log_magic_size ||
+      std::memcmp(log.data(), detail::binary_log_magic, detail::binary_log_magic_size) != 0) {
+    return false;
+  }
+  log = log.subspan(detail::binary_log_magic_size);
+  std::vector<std::pair<std::string_view, std::span<const log_arg_type>>> dictionary;
+  constexpr std::size_t dict_hdr = 1u + 3u * sizeof(std::uint32_t);
+  constexpr std::size_t entry_hdr = 1u + 3u * sizeof(std::uint32_t) + sizeof(std::int64_t);
+  while (!log.empty()) {
+    auto* p = log.data();
+    auto kind = std::to_integer<std::uint8_t>(p[0]);
+    if (kind == detail::log_record_dictionary && log.size() >= dict_hdr) {
+      auto id = detail::read_log_value<std::uint32_t>(p + 1u);
+      auto fmt_len = detail::read_log_value<std::uint32_t>(p + 5u);
+      auto num_args = detail::read_log_value<std::uint32_t>(p + 9u);
+      if (id != dictionary.size() || log.size() - dict_hdr < std::size_t{fmt_len} + num_args) {
+        return false;
+      }
+      std::string_view fmt(cast_ptr_to<char>(p + dict_hdr), fmt_len);
+      auto* types = cast_ptr_to<log_arg_type>(p + dict_hdr + fmt_len);
+      for (std::uint32_t i = 0u; i < num_args; ++i) {
+        if (static_cast<std::uint8_t>(types[i]) > static_cast<std::uint8_t>(log_arg_type::string)) {
+          return false;
+        }
+      }
+      dictionary.emplace_back(fmt, std::span<const log_arg_type>(types, num_args));
+      log = log.subspan(dict_hdr + fmt_len + num_args);
+    }
+    else if (kind == detail::log_record_entry && log.size() >= entry_hdr) {
+      auto id = detail::read_log_value<std::uint32_t>(p + 1u);
+      auto ts = detail::read_log_value<std::int64_t>(p + 9u);
+      auto arg_len = detail::read_log_value<std::uint32_t>(p + 17u);
+      if (id >= dictionary.size() || log.size() - entry_hdr < arg_len ||
+          !detail::format_log_entry(text, ts, dictionary[id].first, dictionary[id].second,
+                                    log.subspan(entry_hdr, arg_len))) {
+        return false;
+      }
+      log = log.subspan(entry_hdr + arg_len);
+    }
+    else {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end namespace
+
+#endif
+
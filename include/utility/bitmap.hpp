@@ -0,0 +1,407 @@
+/** @file
+ *
+ * @brief A dynamically sized dense bitmap with word level bulk operations, fast
+ * population count, set bit iteration, and rank / select support.
+ *
+ * @c std::vector<bool> is a common choice for masks and tombstone flags (e.g. marking
+ * elements to be removed with @c erase_where_if), but it only offers bit-at-a-time
+ * access: iterating over the set bits or combining two masks touches every bit
+ * individually. @c bitmap stores bits in 64-bit words and operates a word at a time:
+ *
+ * - @c &=, @c |=, @c ^= and @c and_not combine bitmaps 64 bits per operation.
+ * - @c count uses an AVX2 nibble lookup population count when compiled with AVX2
+ *   enabled (e.g. @c -mavx2 or @c -march=native), otherwise @c std::popcount (which
+ *   is a single @c popcnt instruction when the target supports it).
+ * - Set bit iteration (@c for_each_set, @c find_next) skips zero words and locates each
+ *   set bit with @c std::countr_zero (@c tzcnt).
+ * - @c rank_select builds a small index over a bitmap (one count per 512 bits) giving
+ *   constant time @c rank (number of set bits before a position) and logarithmic time
+ *   @c select (position of the k-th set bit).
+ *
+ * @c erase_where_bits removes the elements of a container whose corresponding bits
+ * are set, in a single pass.
+ *
+ * Bits beyond @c size in the last word are always zero.
+ *
+ * See @c compressed_bitmap.hpp for a compressed variant suited to sparse sets.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef BITMAP_HPP_INCLUDED
+#define BITMAP_HPP_INCLUDED
+
+#include <algorithm> // std::upper_bound, std::fill
+#include <bit> // std::popcount, std::countr_zero
+#include <cassert>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <span>
+#include <utility> // std::move
+#include <vector>
+
+#if defined(__AVX2__) || defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace chops {
+
+namespace detail {
+
+inline std::uint64_t popcount_words(const std::uint64_t* p, std::size_t n) noexcept {
+  std::uint64_t total = 0u;
+  std::size_t i = 0u;
+#if defined(__AVX2__)
+  // nibble lookup with vpshufb, byte counts summed with vpsadbw (Mula's method)
+  const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                          0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+  __m256i acc = _mm256_setzero_si256();
+  const std::size_t vec_end = n - n % 4u;
+  for (; i < vec_end; i += 4u) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+    __m256i lo = _mm256_and_si256(v, low_mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, _mm256_setzero_si256()));
+  }
+  total = static_cast<std::uint64_t>(_mm256_extract_epi64(acc, 0)) +
+          static_cast<std::uint64_t>(_mm256_extract_epi64(acc, 1)) +
+          static_cast<std::uint64_t>(_mm256_extract_epi64(acc, 2)) +
+          static_cast<std::uint64_t>(_mm256_extract_epi64(acc, 3));
+#endif
+  for (; i < n; ++i) {
+    total += static_cast<std::uint64_t>(std::popcount(p[i]));
+  }
+  return total;
+}
+
+// position of the k-th (0 based) set bit of a word, which must have more than k bits set
+inline unsigned select_in_word(std::uint64_t w, unsigned k) noexcept {
+#if defined(__BMI2__)
+  return static_cast<unsigned>(std::countr_zero(_pdep_u64(std::uint64_t{1u} << k, w)));
+#else
+  for (unsigned i = 0u; i < k; ++i) {
+    w &= w - 1u;
+  }
+  return static_cast<unsigned>(std::countr_zero(w));
+#endif
+}
+
+}
+
+/**
+ * @brief Dynamically sized dense bitmap.
+ */
+class bitmap {
+public:
+  using word_type = std::uint64_t;
+  static constexpr std::size_t word_bits = 64u;
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  bitmap() = default;
+
+  explicit bitmap(std::size_t num_bits, bool value = false) :
+      m_words(word_count_for(num_bits), value ? ~word_type{0u} : word_type{0u}), m_size(num_bits) {
+    clear_tail();
+  }
+
+  std::size_t size() const noexcept { return m_size; }
+  bool empty() const noexcept { return m_size == 0u; }
+
+  std::span<const word_type> words() const noexcept { return m_words; }
+  std::span<word_type> words() noexcept { return m_words; }
+
+  void resize(std::size_t num_bits, bool value = false) {
+    auto old_size = m_size;
+    m_words.resize(word_count_for(num_bits), value ? ~word_type{0u} : word_type{0u});
+    m_size = num_bits;
+    if (value && num_bits > old_size && (old_size % word_bits) != 0u) {
+      m_words[old_size / word_bits] |= ~word_type{0u} << (old_size % word_bits);
+    }
+    clear_tail();
+  }
+
+  bool test(std::size_t pos) const noexcept {
+    assert(pos < m_size);
+    return (m_words[pos / word_bits] >> (pos % word_bits)) & 1u;
+  }
+  bool operator[](std::size_t pos) const noexcept { return test(pos); }
+
+  void set(std::size_t pos) noexcept {
+    assert(pos < m_size);
+    m_words[pos / word_bits] |= bit(pos);
+  }
+  void set(std::size_t pos, bool value) noexcept {
+    value ? set(pos) : reset(pos);
+  }
+  void reset(std::size_t pos) noexcept {
+    assert(pos < m_size);
+    m_words[pos / word_bits] &= ~bit(pos);
+  }
+  void flip(std::size_t pos) noexcept {
+    assert(pos < m_size);
+    m_words[pos / word_bits] ^= bit(pos);
+  }
+
+  void set_all() noexcept {
+    std::fill(m_words.begin(), m_words.end(), ~word_type{0u});
+    clear_tail();
+  }
+  void reset_all() noexcept {
+    std::fill(m_words.begin(), m_words.end(), word_type{0u});
+  }
+  void flip_all() noexcept {
+    for (auto& w : m_words) {
+      w = ~w;
+    }
+    clear_tail();
+  }
+
+/**
+ * @brief Number of set bits.
+ */
+  std::size_t count() const noexcept {
+    return static_cast<std::size_t>(detail::popcount_words(m_words.data(), m_words.size()));
+  }
+
+  bool any() const noexcept {
+    for (auto w : m_words) {
+      if (w != 0u) {
+        return true;
+      }
+    }
+    return false;
+  }
+  bool none() const noexcept { return !any(); }
+
+/**
+ * @brief Bulk operations; both bitmaps must be the same size.
+ */
+  bitmap& operator&=(const bitmap& rhs) noexcept {
+    assert(m_size == rhs.m_size);
+    for (std::size_t i = 0u; i < m_words.size(); ++i) {
+      m_words[i] &= rhs.m_words[i];
+    }
+    return *this;
+  }
+  bitmap& operator|=(const bitmap& rhs) noexcept {
+    assert(m_size == rhs.m_size);
+    for (std::size_t i = 0u; i < m_words.size(); ++i) {
+      m_words[i] |= rhs.m_words[i];
+    }
+    return *this;
+  }
+  bitmap& operator^=(const bitmap& rhs) noexcept {
+    assert(m_size == rhs.m_size);
+    for (std::size_t i = 0u; i < m_words.size(); ++i) {
+      m_words[i] ^= rhs.m_words[i];
+    }
+    return *this;
+  }
+/**
+ * @brief Clear every bit that is set in @c rhs (this & ~rhs).
+ */
+  bitmap& and_not(const bitmap& rhs) noexcept {
+    assert(m_size == rhs.m_size);
+    for (std::size_t i = 0u; i < m_words.size(); ++i) {
+      m_words[i] &= ~rhs.m_words[i];
+    }
+    return *this;
+  }
+
+  friend bitmap operator&(bitmap lhs, const bitmap& rhs) noexcept { return std::move(lhs &= rhs); }
+  friend bitmap operator|(bitmap lhs, const bitmap& rhs) noexcept { return std::move(lhs |= rhs); }
+  friend bitmap operator^(bitmap lhs, const bitmap& rhs) noexcept { return std::move(lhs ^= rhs); }
+  friend bool operator==(const bitmap&, const bitmap&) = default;
+
+/**
+ * @brief Position of the first set bit, or @c npos.
+ */
+  std::size_t find_first() const noexcept { return scan_from(0u); }
+
+/**
+ * @brief Position of the first set bit after @c pos, or @c npos.
+ */
+  std::size_t find_next(std::size_t pos) const noexcept {
+    ++pos;
+    if (pos >= m_size) {
+      return npos;
+    }
+    auto wi = pos / word_bits;
+    auto w = m_words[wi] & (~word_type{0u} << (pos % word_bits));
+    if (w != 0u) {
+      return wi * word_bits + static_cast<std::size_t>(std::countr_zero(w));
+    }
+    return scan_from(wi + 1u);
+  }
+
+/**
+ * @brief Invoke a function object with the position of each set bit, in increasing
+ * order.
+ */
+  template <typename F>
+  void for_each_set(F&& func) const {
+    for (std::size_t wi = 0u; wi < m_words.size(); ++wi) {
+      auto w = m_words[wi];
+      while (w != 0u) {
+        func(wi * word_bits + static_cast<std::size_t>(std::countr_zero(w)));
+        w &= w - 1u;
+      }
+    }
+  }
+
+private:
+
+  static std::size_t word_count_for(std::size_t num_bits) noexcept {
+    return (num_bits + word_bits - 1u) / word_bits;
+  }
+
+  static word_type bit(std::size_t pos) noexcept {
+    return word_type{1u} << (pos % word_bits);
+  }
+
+  void clear_tail() noexcept {
+    if (auto rem = m_size % word_bits; rem != 0u) {
+      m_words.back() &= (word_type{1u} << rem) - 1u;
+    }
+  }
+
+  std::size_t scan_from(std::size_t wi) const noexcept {
+    for (; wi < m_words.size(); ++wi) {
+      if (m_words[wi] != 0u) {
+        return wi * word_bits + static_cast<std::size_t>(std::countr_zero(m_words[wi]));
+      }
+    }
+    return npos;
+  }
+
+private:
+  std::vector<word_type> m_words;
+  std::size_t            m_size { 0u };
+};
+
+/**
+ * @brief Number of bits set in both bitmaps, without creating an intermediate bitmap.
+ */
+inline std::size_t count_and(const bitmap& lhs, const bitmap& rhs) noexcept {
+  assert(lhs.size() == rhs.size());
+  auto a = lhs.words();
+  auto b = rhs.words();
+  std::size_t total = 0u;
+  for (std::size_t i = 0u; i < a.size(); ++i) {
+    total += static_cast<std::size_t>(std::popcount(a[i] & b[i]));
+  }
+  return total;
+}
+
+/**
+ * @brief Rank and select index over a bitmap.
+ *
+ * The index stores the number of set bits preceding each 512 bit block. It refers to
+ * the bitmap, which must outlive the index and not be modified while it is in use
+ * (rebuild the index after modifications).
+ */
+class rank_select {
+public:
+  static constexpr std::size_t npos = bitmap::npos;
+
+  explicit rank_select(const bitmap& bm) : m_bitmap(&bm) {
+    auto words = bm.words();
+    m_blocks.reserve(words.size() / words_per_block + 2u);
+    std::size_t total = 0u;
+    for (std::size_t i = 0u; i < words.size(); i += words_per_block) {
+      m_blocks.push_back(total);
+      auto n = (words.size() - i < words_per_block) ? words.size() - i : words_per_block;
+      total += static_cast<std::size_t>(detail::popcount_words(words.data() + i, n));
+    }
+    m_blocks.push_back(total);
+  }
+
+/**
+ * @brief Total number of set bits.
+ */
+  std::size_t count() const noexcept { return m_blocks.back(); }
+
+/**
+ * @brief Number of set bits in positions [0, pos); @c pos may equal the bitmap size.
+ */
+  std::size_t rank(std::size_t pos) const noexcept {
+    assert(pos <= m_bitmap->size());
+    auto words = m_bitmap->words();
+    auto wi = pos / bitmap::word_bits;
+    auto bi = wi / words_per_block;
+    auto r = m_blocks[bi];
+    for (auto i = bi * words_per_block; i < wi; ++i) {
+      r += static_cast<std::size_t>(std::popcount(words[i]));
+    }
+    if (auto rem = pos % bitmap::word_bits; rem != 0u) {
+      r += static_cast<std::size_t>(std::popcount(words[wi] & ((std::uint64_t{1u} << rem) - 1u)));
+    }
+    return r;
+  }
+
+/**
+ * @brief Position of the k-th (0 based) set bit, or @c npos if there are not that
+ * many set bits.
+ */
+  std::size_t select(std::size_t k) const noexcept {
+    if (k >= count()) {
+      return npos;
+    }
+    // last block whose preceding count is <= k
+    auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), k);
+    auto bi = static_cast<std::size_t>(it - m_blocks.begin()) - 1u;
+    auto remaining = k - m_blocks[bi];
+    auto words = m_bitmap->words();
+    for (auto i = bi * words_per_block; i < words.size(); ++i) {
+      auto c = static_cast<std::size_t>(std::popcount(words[i]));
+      if (remaining < c) {
+        return i * bitmap::word_bits + detail::select_in_word(words[i], static_cast<unsigned>(remaining));
+      }
+      remaining -= c;
+    }
+    return npos;
+  }
+
+private:
+  static constexpr std::size_t words_per_block = 8u;
+
+  const bitmap*            m_bitmap;
+  std::vector<std::size_t> m_blocks;
+};
+
+/**
+ * @brief Erase the elements of a sequence container whose corresponding bit in the
+ * mask is set, preserving the order of the remaining elements.
+ *
+ * The mask must have at least as many bits as the container has elements.
+ */
+template <typename C>
+auto erase_where_bits(C& c, const bitmap& mask) {
+  assert(mask.size() >= c.size());
+  auto first = mask.find_first();
+  if (first == bitmap::npos || first >= c.size()) {
+    return c.end();
+  }
+  auto dst = c.begin() + static_cast<typename C::difference_type>(first);
+  auto src = dst;
+  for (std::size_t i = first; i < c.size(); ++i, ++src) {
+    if (!mask.test(i)) {
+      *dst = std::move(*src);
+      ++dst;
+    }
+  }
+  return c.erase(dst, c.end());
+}
+
+} // end namespace
+
+#endif
+
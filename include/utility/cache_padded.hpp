@@ -0,0 +1,228 @@
+/** @file
+ *
+ * @brief Cache line padding and per-CPU data, avoiding false sharing between threads.
+ *
+ * When two frequently written variables share a cache line, each write by one core
+ * invalidates the line in the other cores' caches even though the variables are
+ * logically independent ("false sharing"). Atomic counters declared next to each other
+ * are the classic case, and can make a multi-threaded program scale negatively.
+ *
+ * @c cache_padded<T> aligns and pads a value to its own cache line. The line size is
+ * @c std::hardware_destructive_interference_size when the standard library provides it,
+ * otherwise 64 bytes.
+ *
+ * @c per_cpu<T> holds one cache padded @c T per CPU, and @c local returns the one for
+ * the CPU the calling thread is running on (from @c sched_getcpu on Linux, or a hash of
+ * the thread id elsewhere). A thread can migrate to another CPU at any time, so two
+ * threads may occasionally access the same slot - @c T must be safe for concurrent
+ * access (typically an atomic). The benefit is that the common case is uncontended.
+ *
+ * @c relaxed_counter is an atomic counter using relaxed memory ordering, appropriate
+ * for statistics where no other memory is synchronized through the counter.
+ * @c per_cpu_counter combines the two: increments touch only the local slot, and
+ * @c load sums all slots.
+ *
+ * @code
+ * chops::per_cpu_counter msgs_received;
+ * // hot path, any thread
+ * ++msgs_received;
+ * // occasional reporting
+ * auto total = msgs_received.load();
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef CACHE_PADDED_HPP_INCLUDED
+#define CACHE_PADDED_HPP_INCLUDED
+
+#include <atomic>
+#include <bit> // std::bit_ceil
+#include <concepts> // std::constructible_from
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <functional> // std::hash
+#include <memory> // std::unique_ptr
+#include <new> // std::hardware_destructive_interference_size
+#include <thread>
+#include <type_traits> // std::remove_cvref_t
+#include <utility> // std::forward
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace chops {
+
+#if defined(__cpp_lib_hardware_interference_size)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winterference-size"
+#endif
+inline constexpr std::size_t cache_line_size = std::hardware_destructive_interference_size;
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#else
+inline constexpr std::size_t cache_line_size = 64u;
+#endif
+
+/**
+ * @brief A value aligned and padded to occupy its own cache line (or lines).
+ */
+template <typename T>
+class alignas(cache_line_size) cache_padded {
+public:
+
+  template <typename... Args>
+    requires (std::constructible_from<T, Args...> &&
+              !(sizeof...(Args) == 1u && (std::same_as<std::remove_cvref_t<Args>, cache_padded> && ...)))
+  constexpr explicit cache_padded(Args&&... args) : m_value(std::forward<Args>(args)...) { }
+
+  constexpr T& get() noexcept { return m_value; }
+  constexpr const T& get() const noexcept { return m_value; }
+
+  constexpr T& operator*() noexcept { return m_value; }
+  constexpr const T& operator*() const noexcept { return m_value; }
+  constexpr T* operator->() noexcept { return &m_value; }
+  constexpr const T* operator->() const noexcept { return &m_value; }
+
+private:
+  T m_value;
+};
+
+/**
+ * @brief An atomic counter using relaxed memory ordering.
+ */
+class relaxed_counter {
+public:
+  constexpr relaxed_counter(std::uint64_t start = 0u) noexcept : m_count(start) { }
+
+  void add(std::uint64_t n) noexcept { m_count.fetch_add(n, std::memory_order_relaxed); }
+  relaxed_counter& operator++() noexcept { add(1u); return *this; }
+  relaxed_counter& operator+=(std::uint64_t n) noexcept { add(n); return *this; }
+
+  std::uint64_t load() const noexcept { return m_count.load(std::memory_order_relaxed); }
+  void store(std::uint64_t n) noexcept { m_count.store(n, std::memory_order_relaxed); }
+
+private:
+  std::atomic<std::uint64_t> m_count;
+};
+
+namespace detail {
+
+inline std::size_t thread_slot_hash() noexcept {
+  thread_local const std::size_t h = std::hash<std::thread::id>{}(std::this_thread::get_id());
+  return h;
+}
+
+}
+
+/**
+ * @brief Index identifying the CPU of the calling thread, for spreading data across
+ * slots; on Linux this is the CPU number, elsewhere a per-thread hash.
+ */
+inline std::size_t cpu_slot_index() noexcept {
+#if defined(__linux__)
+  int cpu = ::sched_getcpu();
+  if (cpu >= 0) {
+    return static_cast<std::size_t>(cpu);
+  }
+#endif
+  return detail::thread_slot_hash();
+}
+
+/**
+ * @brief One cache padded instance of @c T per CPU.
+ *
+ * The number of slots is a power of two, at least the number of hardware threads,
+ * and CPU indices are masked to select a slot.
+ */
+template <typename T>
+class per_cpu {
+public:
+
+/**
+ * @brief Construct the slots, value initializing each @c T.
+ *
+ * @param min_slots Minimum number of slots, defaults to the number of hardware threads.
+ */
+  explicit per_cpu(std::size_t min_slots = std::thread::hardware_concurrency()) :
+      m_mask(std::bit_ceil(min_slots == 0u ? std::size_t{1u} : min_slots) - 1u),
+      m_slots(std::make_unique<cache_padded<T>[]>(m_mask + 1u)) { }
+
+  per_cpu(const per_cpu&) = delete;
+  per_cpu& operator=(const per_cpu&) = delete;
+
+  std::size_t size() const noexcept { return m_mask + 1u; }
+
+/**
+ * @brief Slot for the CPU the calling thread is running on.
+ */
+  T& local() noexcept { return *m_slots[cpu_slot_index() & m_mask]; }
+
+  T& operator[](std::size_t idx) noexcept { return *m_slots[idx]; }
+  const T& operator[](std::size_t idx) const noexcept { return *m_slots[idx]; }
+
+/**
+ * @brief Invoke a function object on every slot.
+ */
+  template <typename F>
+  void for_each(F&& func) {
+    for (std::size_t i = 0u; i < size(); ++i) {
+      func(*m_slots[i]);
+    }
+  }
+
+  template <typename F>
+  void for_each(F&& func) const {
+    for (std::size_t i = 0u; i < size(); ++i) {
+      func(std::as_const(*m_slots[i]));
+    }
+  }
+
+private:
+  std::size_t                         m_mask;
+  std::unique_ptr<cache_padded<T>[]>  m_slots;
+};
+
+/**
+ * @brief A counter spread across CPUs, with uncontended increments and a summing read.
+ */
+class per_cpu_counter {
+public:
+
+  explicit per_cpu_counter(std::size_t min_slots = std::thread::hardware_concurrency()) :
+      m_counters(min_slots) { }
+
+  void add(std::uint64_t n) noexcept { m_counters.local().add(n); }
+  per_cpu_counter& operator++() noexcept { add(1u); return *this; }
+  per_cpu_counter& operator+=(std::uint64_t n) noexcept { add(n); return *this; }
+
+/**
+ * @brief Sum of all slots; concurrent increments may or may not be included.
+ */
+  std::uint64_t load() const noexcept {
+    std::uint64_t sum = 0u;
+    m_counters.for_each([&sum] (const relaxed_counter& c) { sum += c.load(); } );
+    return sum;
+  }
+
+  void reset() noexcept {
+    m_counters.for_each([] (relaxed_counter& c) { c.store(0u); } );
+  }
+
+private:
+  per_cpu<relaxed_counter> m_counters;
+};
+
+} // end namespace
+
+#endif
+
@@ -0,0 +1,361 @@
+/** @file
+ *
+ * @brief A vector stored in fixed size chunks, so element addresses never change as
+ * it grows, with constant time indexing and chunk at a time iteration.
+ *
+ * A @c std::vector moves its elements when it grows, invalidating pointers held by
+ * other structures (an index, an intrusive list, a handle table). @c std::deque keeps
+ * addresses stable, but in libstdc++ its blocks are 512 bytes, too small for large
+ * elements, and the block size cannot be changed. @c chunked_vector<T, ChunkSize>
+ * allocates chunks of @c ChunkSize elements (a power of two, by default about 16 KiB
+ * of elements), never moves an element when growing, and finds element @c i with a
+ * shift and a mask.
+ *
+ * Element by element iteration through the iterators costs a chunk lookup per access;
+ * for hot loops, @c for_each_chunk (or @c chunk) passes each chunk as a contiguous
+ * @c std::span, whose inner loop the compiler can vectorize.
+ *
+ * Erasing from the middle (@c erase, @c erase_where_if) shifts the later elements
+ * down, chunk by chunk, so pointers to those elements then refer to different values,
+ * as with @c std::vector; pointers to earlier elements, and all pointers when
+ * appending, stay valid. Emptied chunks are kept for reuse until @c shrink_to_fit.
+ *
+ * @code
+ * chops::chunked_vector<order, 4096> orders;
+ * order* p = &orders.emplace_back(...); // stays valid as orders grows
+ * orders.for_each_chunk([] (std::span<order> c) { for (auto& o : c) { ... } } );
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef CHUNKED_VECTOR_HPP_INCLUDED
+#define CHUNKED_VECTOR_HPP_INCLUDED
+
+#include <bit> // std::has_single_bit, std::bit_floor, std::countr_zero
+#include <compare> // std::strong_ordering
+#include <cstddef> // std::byte, std::size_t, std::ptrdiff_t
+#include <iterator> // std::random_access_iterator_tag
+#include <memory> // std::unique_ptr
+#include <new> // std::launder
+#include <span>
+#include <stdexcept> // std::out_of_range
+#include <type_traits> // std::conditional_t
+#include <utility> // std::move, std::forward, std::swap
+#include <vector>
+
+namespace chops {
+
+namespace detail {
+
+// elements in about 16 KiB, at least 16
+template <typename T>
+constexpr std::size_t default_chunk_size() noexcept {
+  constexpr std::size_t n = 16384u / sizeof(T);
+  return n < 16u ? 16u : std::bit_floor(n);
+}
+
+}
+
+/**
+ * @brief Vector of elements in fixed size chunks with stable element addresses.
+ *
+ * @tparam T Element type.
+ *
+ * @tparam ChunkSize Elements per chunk, a power of two.
+ */
+template <typename T, std::size_t ChunkSize = detail::default_chunk_size<T>()>
+class chunked_vector {
+  static_assert(std::has_single_bit(ChunkSize), "chunked_vector chunk size must be a power of two");
+
+  template <bool Const>
+  class iter {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+    using container = std::conditional_t<Const, const chunked_vector, chunked_vector>;
+
+    iter() noexcept = default;
+    iter(container* c, std::size_t pos) noexcept : m_cont(c), m_pos(pos) { }
+    operator iter<true>() const noexcept { return iter<true>(m_cont, m_pos); }
+
+    reference operator*() const noexcept { return (*m_cont)[m_pos]; }
+    pointer operator->() const noexcept { return &(*m_cont)[m_pos]; }
+    reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+    iter& operator++() noexcept { ++m_pos; return *this; }
+    iter operator++(int) noexcept { auto t = *this; ++m_pos; return t; }
+    iter& operator--() noexcept { --m_pos; return *this; }
+    iter operator--(int) noexcept { auto t = *this; --m_pos; return t; }
+    iter& operator+=(difference_type n) noexcept { m_pos += static_cast<std::size_t>(n); return *this; }
+    iter& operator-=(difference_type n) noexcept { m_pos -= static_cast<std::size_t>(n); return *this; }
+    friend iter operator+(iter it, difference_type n) noexcept { return it += n; }
+    friend iter operator+(difference_type n, iter it) noexcept { return it += n; }
+    friend iter operator-(iter it, difference_type n) noexcept { return it -= n; }
+    friend difference_type operator-(const iter& a, const iter& b) noexcept {
+      return static_cast<difference_type>(a.m_pos - b.m_pos);
+    }
+    friend bool operator==(const iter& a, const iter& b) noexcept { return a.m_pos == b.m_pos; }
+    friend auto operator<=>(const iter& a, const iter& b) noexcept { return a.m_pos <=> b.m_pos; }
+
+  private:
+    friend class chunked_vector;
+    container*  m_cont { nullptr };
+    std::size_t m_pos { 0u };
+  };
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = iter<false>;
+  using const_iterator = iter<true>;
+
+  static constexpr std::size_t chunk_size = ChunkSize;
+
+  chunked_vector() = default;
+
+  chunked_vector(const chunked_vector& rhs) : chunked_vector() {
+    reserve(rhs.size());
+    rhs.for_each_chunk([this] (std::span<const T> c) {
+        for (const auto& v : c) {
+          push_back(v);
+        }
+      } );
+  }
+
+  chunked_vector(chunked_vector&& rhs) noexcept :
+    m_chunks(std::move(rhs.m_chunks)), m_size(rhs.m_size) { rhs.m_size = 0u; }
+
+  chunked_vector& operator=(chunked_vector rhs) noexcept {
+    swap(rhs);
+    return *this;
+  }
+
+  ~chunked_vector() { clear(); }
+
+  template <typename... Args>
+  T& emplace_back(Args&&... args) {
+    if (m_size == m_chunks.size() * ChunkSize) {
+      add_chunk();
+    }
+    auto p = ::new (static_cast<void*>(slot(m_size))) T(std::forward<Args>(args)...);
+    ++m_size;
+    return *p;
+  }
+
+  void push_back(const T& val) { emplace_back(val); }
+  void push_back(T&& val) { emplace_back(std::move(val)); }
+
+  void pop_back() noexcept {
+    --m_size;
+    (*this)[m_size].~T();
+  }
+
+  T& operator[](std::size_t i) noexcept { return *element(i); }
+  const T& operator[](std::size_t i) const noexcept { return *element(i); }
+
+/**
+ * @throw std::out_of_range if @c i is not less than @c size.
+ */
+  T& at(std::size_t i) {
+    if (i >= m_size) {
+      throw std::out_of_range("chunked_vector: index out of range");
+    }
+    return (*this)[i];
+  }
+
+  const T& at(std::size_t i) const {
+    if (i >= m_size) {
+      throw std::out_of_range("chunked_vector: index out of range");
+    }
+    return (*this)[i];
+  }
+
+  T& front() noexcept { return (*this)[0u]; }
+  const T& front() const noexcept { return (*this)[0u]; }
+  T& back() noexcept { return (*this)[m_size - 1u]; }
+  const T& back() const noexcept { return (*this)[m_size - 1u]; }
+
+  std::size_t size() const noexcept { return m_size; }
+  bool empty() const noexcept { return m_size == 0u; }
+  std::size_t capacity() const noexcept { return m_chunks.size() * ChunkSize; }
+
+/**
+ * @brief Allocate chunks for at least @c n elements.
+ */
+  void reserve(std::size_t n) {
+    while (capacity() < n) {
+      add_chunk();
+    }
+  }
+
+/**
+ * @brief Free chunks holding no elements.
+ */
+  void shrink_to_fit() {
+    auto needed = (m_size + ChunkSize - 1u) / ChunkSize;
+    m_chunks.resize(needed);
+    m_chunks.shrink_to_fit();
+  }
+
+/**
+ * @brief Destroy all elements, keeping the chunks.
+ */
+  void clear() noexcept {
+    while (m_size > 0u) {
+      pop_back();
+    }
+  }
+
+/**
+ * @brief Number of chunks holding elements.
+ */
+  std::size_t chunk_count() const noexcept { return (m_size + ChunkSize - 1u) / ChunkSize; }
+
+/**
+ * @brief Elements of chunk @c i, contiguous; only the last chunk may be partial.
+ */
+  std::span<T> chunk(std::size_t i) noexcept { return { chunk_data(i), chunk_length(i) }; }
+  std::span<const T> chunk(std::size_t i) const noexcept { return { chunk_data(i), chunk_length(i) }; }
+
+/**
+ * @brief Invoke @c f with each chunk, as a contiguous span, in order.
+ */
+  template <typename F>
+  void for_each_chunk(F&& f) {
+    for (std::size_t i = 0u; i < chunk_count(); ++i) {
+      f(chunk(i));
+    }
+  }
+
+  template <typename F>
+  void for_each_chunk(F&& f) const {
+    for (std::size_t i = 0u; i < chunk_count(); ++i) {
+      f(chunk(i));
+    }
+  }
+
+/**
+ * @brief Erase a range, moving later elements down.
+ *
+ * @return Iterator to the element following the erased range.
+ */
+  iterator erase(const_iterator first, const_iterator last) {
+    if (first == last) {
+      return iterator(this, first.m_pos);
+    }
+    auto dst = first.m_pos;
+    for (auto src = last.m_pos; src < m_size; ++src, ++dst) {
+      (*this)[dst] = std::move((*this)[src]);
+    }
+    while (m_size > dst) {
+      pop_back();
+    }
+    return iterator(this, first.m_pos);
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+/**
+ * @brief Erase every element for which @c pred returns @c true, keeping the order of
+ * the others; the compaction walks the chunks as contiguous spans.
+ *
+ * @return Number of elements erased.
+ */
+  template <typename Pred>
+  std::size_t erase_if(Pred pred) {
+    std::size_t dst = 0u;
+    T* out = nullptr;
+    for (std::size_t ci = 0u; ci < chunk_count(); ++ci) {
+      for (auto& v : chunk(ci)) {
+        if (pred(static_cast<const T&>(v))) {
+          continue;
+        }
+        if (out == nullptr || (dst & mask) == 0u) {
+          out = element(dst);
+        }
+        if (out != &v) {
+          *out = std::move(v);
+        }
+        ++out;
+        ++dst;
+      }
+    }
+    auto cnt = m_size - dst;
+    while (m_size > dst) {
+      pop_back();
+    }
+    return cnt;
+  }
+
+  void swap(chunked_vector& rhs) noexcept {
+    m_chunks.swap(rhs.m_chunks);
+    std::swap(m_size, rhs.m_size);
+  }
+
+  iterator begin() noexcept { return iterator(this, 0u); }
+  iterator end() noexcept { return iterator(this, m_size); }
+  const_iterator begin() const noexcept { return const_iterator(this, 0u); }
+  const_iterator end() const noexcept { return const_iterator(this, m_size); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+private:
+  static constexpr std::size_t shift = static_cast<std::size_t>(std::countr_zero(ChunkSize));
+  static constexpr std::size_t mask = ChunkSize - 1u;
+
+  struct chunk_storage {
+    alignas(T) std::byte m_bytes[sizeof(T) * ChunkSize];
+  };
+
+  void add_chunk() {
+    // not make_unique, which would zero the storage
+    std::unique_ptr<chunk_storage> c { new chunk_storage };
+    m_chunks.push_back(std::move(c));
+  }
+
+  // address of the storage for element i, constructed or not
+  T* slot(std::size_t i) const noexcept {
+    return reinterpret_cast<T*>(m_chunks[i >> shift]->m_bytes) + (i & mask);
+  }
+
+  T* element(std::size_t i) const noexcept { return std::launder(slot(i)); }
+
+  T* chunk_data(std::size_t i) const noexcept { return std::launder(reinterpret_cast<T*>(m_chunks[i]->m_bytes)); }
+
+  std::size_t chunk_length(std::size_t i) const noexcept {
+    auto rest = m_size - i * ChunkSize;
+    return rest < ChunkSize ? rest : ChunkSize;
+  }
+
+private:
+  std::vector<std::unique_ptr<chunk_storage>> m_chunks;
+  std::size_t                                 m_size { 0u };
+};
+
+/**
+ * @brief Erase every element of a @c chunked_vector for which @c f returns @c true,
+ * matching @c erase_where_if for standard containers.
+ *
+ * @return Number of elements erased.
+ */
+template <typename T, std::size_t ChunkSize, typename F>
+std::size_t erase_where_if(chunked_vector<T, ChunkSize>& c, F&& f) {
+  return c.erase_if(f);
+}
+
+} // end namespace
+
+#endif
+
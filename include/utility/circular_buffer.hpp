@@ -0,0 +1,344 @@
+/** @file
+ *
+ * @brief A fixed capacity circular buffer that overwrites its oldest element when
+ * full, and a variant that can be snapshotted by reader threads without locking.
+ *
+ * Keeping the last N samples or events (per connection, per worker) for diagnostics
+ * is often done with a @c std::deque trimmed after each insert, which allocates and
+ * frees blocks continuously. @c circular_buffer<T, N> stores its elements in a member
+ * @c std::array, never allocates, and on @c push_back to a full buffer overwrites the
+ * oldest element. The capacity must be a power of two, so positions are mapped to
+ * slots with a mask rather than a division.
+ *
+ * @c spans returns the contents (oldest to newest) as at most two contiguous spans,
+ * for bulk copies with @c memcpy or @c std::copy; iterators and indexing are also
+ * provided. @c total_pushed counts every element ever pushed, so the number of
+ * overwritten elements is @c total_pushed minus @c size.
+ *
+ * @c snapshot_circular_buffer<T, N> is written by one thread and read by any number of
+ * threads. The writer never blocks or waits, and readers copy the most recent elements
+ * (as a @c circular_buffer, or into a span) while the writer continues; elements that
+ * the writer overwrote during a copy are detected with a sequence counter and
+ * excluded, in the same way as @c seqlock. Elements must be trivially copyable and
+ * are stored as relaxed atomic words, so a concurrent copy is race free.
+ *
+ * @code
+ * chops::circular_buffer<latency_sample, 1024> recent;
+ * recent.push_back(sample);
+ * auto [older, newer] = recent.spans();
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef CIRCULAR_BUFFER_HPP_INCLUDED
+#define CIRCULAR_BUFFER_HPP_INCLUDED
+
+#include <array>
+#include <atomic>
+#include <bit> // std::has_single_bit, std::bit_cast
+#include <compare> // std::strong_ordering
+#include <concepts> // std::default_initializable
+#include <cstddef> // std::byte, std::size_t, std::ptrdiff_t
+#include <cstdint> // std::uint64_t
+#include <iterator> // std::random_access_iterator_tag
+#include <optional>
+#include <span>
+#include <type_traits> // std::is_trivially_copyable_v, std::conditional_t
+#include <utility> // std::pair, std::move, std::forward
+
+#include "utility/cast_ptr_to.hpp"
+#include "utility/cache_padded.hpp"
+#include "utility/seqlock.hpp"
+
+namespace chops {
+
+/**
+ * @brief Fixed capacity circular buffer, overwriting the oldest element when full.
+ *
+ * @tparam T Element type, which must be default constructible; empty slots hold
+ * default constructed values.
+ *
+ * @tparam N Capacity, a power of two.
+ */
+template <std::default_initializable T, std::size_t N>
+class circular_buffer {
+  static_assert(std::has_single_bit(N), "circular_buffer capacity must be a power of two");
+
+  template <bool Const>
+  class iter {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+    using buffer = std::conditional_t<Const, const circular_buffer, circular_buffer>;
+
+    constexpr iter() noexcept = default;
+    constexpr iter(buffer* buf, std::size_t pos) noexcept : m_buf(buf), m_pos(pos) { }
+    constexpr operator iter<true>() const noexcept { return iter<true>(m_buf, m_pos); }
+
+    constexpr reference operator*() const noexcept { return (*m_buf)[m_pos]; }
+    constexpr pointer operator->() const noexcept { return &(*m_buf)[m_pos]; }
+    constexpr reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+    constexpr iter& operator++() noexcept { ++m_pos; return *this; }
+    constexpr iter operator++(int) noexcept { auto t = *this; ++m_pos; return t; }
+    constexpr iter& operator--() noexcept { --m_pos; return *this; }
+    constexpr iter operator--(int) noexcept { auto t = *this; --m_pos; return t; }
+    constexpr iter& operator+=(difference_type n) noexcept { m_pos += static_cast<std::size_t>(n); return *this; }
+    constexpr iter& operator-=(difference_type n) noexcept { m_pos -= static_cast<std::size_t>(n); return *this; }
+    friend constexpr iter operator+(iter it, difference_type n) noexcept { return it += n; }
+    friend constexpr iter operator+(difference_type n, iter it) noexcept { return it += n; }
+    friend constexpr iter operator-(iter it, difference_type n) noexcept { return it -= n; }
+    friend constexpr difference_type operator-(const iter& a, const iter& b) noexcept {
+      return static_cast<difference_type>(a.m_pos - b.m_pos);
+    }
+    friend constexpr bool operator==(const iter& a, const iter& b) noexcept { return a.m_pos == b.m_pos; }
+    friend constexpr auto operator<=>(const iter& a, const iter& b) noexcept { return a.m_pos <=> b.m_pos; }
+
+  private:
+    buffer*     m_buf { nullptr };
+    std::size_t m_pos { 0u };
+  };
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = iter<false>;
+  using const_iterator = iter<true>;
+
+  static constexpr std::size_t capacity() noexcept { return N; }
+
+/**
+ * @brief Append an element, overwriting the oldest element if the buffer is full.
+ */
+  constexpr void push_back(const T& val) { slot(m_end) = val; advance(); }
+  constexpr void push_back(T&& val) { slot(m_end) = std::move(val); advance(); }
+
+  template <typename... Args>
+  constexpr T& emplace_back(Args&&... args) {
+    auto& s = slot(m_end);
+    s = T(std::forward<Args>(args)...);
+    advance();
+    return s;
+  }
+
+/**
+ * @brief Remove the oldest element; the buffer must not be empty.
+ */
+  constexpr void pop_front() {
+    slot(m_begin) = T { };
+    ++m_begin;
+  }
+
+  constexpr void clear() {
+    while (!empty()) {
+      pop_front();
+    }
+  }
+
+/**
+ * @brief Element @c i, counting from the oldest (0) to the newest (@c size - 1).
+ */
+  constexpr T& operator[](std::size_t i) noexcept { return slot(m_begin + i); }
+  constexpr const T& operator[](std::size_t i) const noexcept { return slot(m_begin + i); }
+
+  constexpr T& front() noexcept { return slot(m_begin); }
+  constexpr const T& front() const noexcept { return slot(m_begin); }
+  constexpr T& back() noexcept { return slot(m_end - 1u); }
+  constexpr const T& back() const noexcept { return slot(m_end - 1u); }
+
+  constexpr std::size_t size() const noexcept { return static_cast<std::size_t>(m_end - m_begin); }
+  constexpr bool empty() const noexcept { return m_end == m_begin; }
+  constexpr bool full() const noexcept { return size() == N; }
+
+/**
+ * @brief Number of elements pushed since construction, including overwritten ones.
+ */
+  constexpr std::uint64_t total_pushed() const noexcept { return m_end; }
+
+/**
+ * @brief Contents from oldest to newest as two contiguous spans; the second is empty
+ * unless the contents wrap around the end of the storage.
+ */
+  constexpr std::pair<std::span<T>, std::span<T>> spans() noexcept {
+    auto [first, second] = span_bounds();
+    return { std::span<T>(m_data.data() + first, second), std::span<T>(m_data.data(), size() - second) };
+  }
+
+  constexpr std::pair<std::span<const T>, std::span<const T>> spans() const noexcept {
+    auto [first, second] = span_bounds();
+    return { std::span<const T>(m_data.data() + first, second), std::span<const T>(m_data.data(), size() - second) };
+  }
+
+/**
+ * @brief Copy the contents, oldest first, to an output iterator.
+ */
+  template <typename OutIt>
+  constexpr OutIt copy_to(OutIt out) const {
+    auto [a, b] = spans();
+    for (const auto& v : a) {
+      *out++ = v;
+    }
+    for (const auto& v : b) {
+      *out++ = v;
+    }
+    return out;
+  }
+
+  constexpr iterator begin() noexcept { return iterator(this, 0u); }
+  constexpr iterator end() noexcept { return iterator(this, size()); }
+  constexpr const_iterator begin() const noexcept { return const_iterator(this, 0u); }
+  constexpr const_iterator end() const noexcept { return const_iterator(this, size()); }
+  constexpr const_iterator cbegin() const noexcept { return begin(); }
+  constexpr const_iterator cend() const noexcept { return end(); }
+
+private:
+  static constexpr std::uint64_t mask = N - 1u;
+
+  constexpr T& slot(std::uint64_t pos) noexcept { return m_data[static_cast<std::size_t>(pos & mask)]; }
+  constexpr const T& slot(std::uint64_t pos) const noexcept { return m_data[static_cast<std::size_t>(pos & mask)]; }
+
+  constexpr void advance() noexcept {
+    if (++m_end - m_begin > N) {
+      ++m_begin;
+    }
+  }
+
+  // start of the oldest element and length of the first span
+  constexpr std::pair<std::size_t, std::size_t> span_bounds() const noexcept {
+    auto first = static_cast<std::size_t>(m_begin & mask);
+    auto len = (N - first < size()) ? N - first : size();
+    return { first, len };
+  }
+
+private:
+  std::array<T, N> m_data { };
+  std::uint64_t    m_begin { 0u };
+  std::uint64_t    m_end { 0u };
+};
+
+/**
+ * @brief Single writer circular buffer whose recent contents can be copied by any
+ * number of reader threads without locking.
+ *
+ * @tparam T A trivially copyable, default constructible type.
+ *
+ * @tparam N Capacity, a power of two.
+ */
+template <typename T, std::size_t N>
+class snapshot_circular_buffer {
+  static_assert(std::is_trivially_copyable_v<T>, "snapshot_circular_buffer requires a trivially copyable type");
+  static_assert(std::has_single_bit(N), "snapshot_circular_buffer capacity must be a power of two");
+public:
+
+  snapshot_circular_buffer() = default;
+  snapshot_circular_buffer(const snapshot_circular_buffer&) = delete;
+  snapshot_circular_buffer& operator=(const snapshot_circular_buffer&) = delete;
+
+  static constexpr std::size_t capacity() noexcept { return N; }
+
+/**
+ * @brief Append an element, overwriting the oldest if full; writer thread only.
+ */
+  void push_back(const T& val) noexcept {
+    auto pos = m_end->load(std::memory_order_relaxed);
+    // announce the slot being overwritten before touching it
+    m_claimed->store(pos + 1u, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    detail::store_words<sizeof(T)>(m_slots[static_cast<std::size_t>(pos & mask)], cast_ptr_to<std::byte>(&val));
+    m_end->store(pos + 1u, std::memory_order_release);
+  }
+
+/**
+ * @brief Number of elements pushed since construction.
+ */
+  std::uint64_t total_pushed() const noexcept { return m_end->load(std::memory_order_acquire); }
+
+/**
+ * @brief Copy the most recent elements, oldest first, into @c out.
+ *
+ * Elements overwritten by the writer during the copy are excluded; the copy is retried
+ * a few times if that happens, and if the writer keeps overtaking the reader, fewer
+ * elements than requested are returned.
+ *
+ * @return Number of elements copied, at the front of @c out.
+ */
+  std::size_t snapshot(std::span<T> out) const noexcept {
+    std::size_t copied = 0u;
+    for (int attempt = 0; attempt < max_attempts; ++attempt) {
+      auto end = m_end->load(std::memory_order_acquire);
+      auto want = (out.size() < N) ? out.size() : N;
+      want = (end < want) ? static_cast<std::size_t>(end) : want;
+      auto first = end - want;
+      for (std::size_t i = 0u; i < want; ++i) {
+        std::array<std::byte, sizeof(T)> buf;
+        detail::load_words<sizeof(T)>(m_slots[static_cast<std::size_t>((first + i) & mask)], buf.data());
+        out[i] = std::bit_cast<T>(buf);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      auto claimed = m_claimed->load(std::memory_order_relaxed);
+      // positions below claimed - N may have been overwritten during the copy
+      auto valid_from = (claimed > N) ? claimed - N : 0u;
+      if (valid_from <= first) {
+        return want;
+      }
+      auto lost = (valid_from - first < want) ? static_cast<std::size_t>(valid_from - first) : want;
+      copied = want - lost;
+      for (std::size_t i = 0u; i < copied; ++i) {
+        out[i] = out[i + lost];
+      }
+    }
+    return copied;
+  }
+
+/**
+ * @brief Copy the most recent elements into a @c circular_buffer.
+ */
+  circular_buffer<T, N> snapshot() const noexcept {
+    std::array<T, N> tmp;
+    auto n = snapshot(std::span<T>(tmp));
+    circular_buffer<T, N> cb;
+    for (std::size_t i = 0u; i < n; ++i) {
+      cb.push_back(tmp[i]);
+    }
+    return cb;
+  }
+
+/**
+ * @brief Copy of the newest element, or an empty @c std::optional if none has been
+ * pushed.
+ */
+  std::optional<T> latest() const noexcept {
+    T val;
+    if (snapshot(std::span<T>(&val, 1u)) == 0u) {
+      return { };
+    }
+    return val;
+  }
+
+private:
+  static constexpr std::uint64_t mask = N - 1u;
+  static constexpr int max_attempts = 4;
+
+  using slot_type = std::array<std::atomic<std::uint64_t>, (sizeof(T) + 7u) / 8u>;
+
+  cache_padded<std::atomic<std::uint64_t>> m_end { 0u };
+  cache_padded<std::atomic<std::uint64_t>> m_claimed { 0u };
+  std::array<slot_type, N>                 m_slots { };
+};
+
+} // end namespace
+
+#endif
+
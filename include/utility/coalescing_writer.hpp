@@ -0,0 +1,363 @@
+/** @file
+ *
+ * @brief A write coalescing buffer, combining many small writes into batches of
+ * @c iovec segments for a single @c writev call.
+ *
+ * Writing each small message (a protocol frame, a log line) to a socket or file with
+ * its own system call wastes most of the call's cost on the kernel transition.
+ * @c coalescing_writer copies small writes into fixed size chunks taken from a pool it
+ * owns, and passes the buffered bytes to a sink function (typically wrapping
+ * @c writev) as a batch of segments when one of the following happens:
+ *
+ * - the buffered byte count reaches the size threshold,
+ * - the oldest buffered byte has waited longer than the maximum delay (checked on each
+ *   write and by @c poll, which an event loop calls when @c deadline expires),
+ * - a large write arrives, or
+ * - @c flush is called.
+ *
+ * Writes at least as large as the copy threshold are not copied; the pending chunks and
+ * the large payload are passed to the sink together in the same batch, before @c write
+ * returns, so the payload does not need to outlive the call. A batch with more segments
+ * than the sink accepts at once (@c IOV_MAX for @c writev) is split into several sink
+ * calls.
+ *
+ * Every flush produces a @c flush_stats record (bytes, writes coalesced, sink calls
+ * saved, segments, and the reason for the flush), returned from @c flush and @c poll
+ * and passed to an optional stats callback for flushes triggered inside @c write;
+ * running totals are available from @c totals.
+ *
+ * A @c coalescing_writer is not thread safe; it is intended to be owned by the thread
+ * (or strand) writing to one connection or file. The deadline uses @c tsc_clock.
+ *
+ * @code
+ * chops::coalescing_writer wr([fd] (std::span<const chops::io_vec> segs) {
+ *     if (auto ec = chops::write_all(fd, segs)) { throw std::system_error(ec); }
+ *   } );
+ * wr.write(header_bytes);
+ * wr.write(body_bytes);
+ * // in the event loop, when wr.deadline() expires
+ * wr.poll();
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef COALESCING_WRITER_HPP_INCLUDED
+#define COALESCING_WRITER_HPP_INCLUDED
+
+#include <chrono>
+#include <cstddef> // std::byte, std::size_t
+#include <cstdint> // std::uint64_t
+#include <cstring> // std::memcpy
+#include <functional> // std::function
+#include <memory> // std::unique_ptr
+#include <optional>
+#include <span>
+#include <system_error> // std::error_code
+#include <utility> // std::move
+#include <vector>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <climits> // IOV_MAX
+#include <sys/uio.h> // iovec, writev
+#include <unistd.h> // write
+#endif
+
+#include "utility/tsc_clock.hpp"
+
+namespace chops {
+
+#if defined(__linux__)
+/**
+ * @brief A segment of a gather write, @c iovec where available.
+ */
+using io_vec = ::iovec;
+#else
+struct io_vec {
+  void*       iov_base;
+  std::size_t iov_len;
+};
+#endif
+
+/**
+ * @brief Tuning parameters of a @c coalescing_writer.
+ */
+struct coalescing_config {
+/** @brief Flush when this many bytes are buffered. */
+  std::size_t               flush_bytes { 64u * 1024u };
+/** @brief Flush when the oldest buffered byte has waited this long. */
+  std::chrono::microseconds max_delay { 1000 };
+/** @brief Writes of at least this size are passed to the sink without copying. */
+  std::size_t               copy_threshold { 4u * 1024u };
+/** @brief Size of each pooled buffer chunk. */
+  std::size_t               chunk_size { 16u * 1024u };
+/** @brief Maximum number of segments passed to one sink call. */
+#if defined(__linux__)
+  std::size_t               max_segments { IOV_MAX };
+#else
+  std::size_t               max_segments { 1024u };
+#endif
+};
+
+/**
+ * @brief Reason for a flush.
+ */
+enum class flush_reason { size, deadline, large_write, explicit_flush };
+
+/**
+ * @brief Statistics of one flush.
+ */
+struct flush_stats {
+/** @brief Bytes passed to the sink. */
+  std::size_t  bytes { 0u };
+/** @brief Number of @c write calls whose data was in the batch. */
+  std::size_t  writes { 0u };
+/** @brief Sink calls made. */
+  std::size_t  sink_calls { 0u };
+/** @brief Sink calls avoided by coalescing, @c writes minus @c sink_calls. */
+  std::size_t  writes_saved { 0u };
+/** @brief Segments in the batch. */
+  std::size_t  segments { 0u };
+  flush_reason reason { flush_reason::explicit_flush };
+};
+
+/**
+ * @brief Running totals over all flushes of a @c coalescing_writer.
+ */
+struct coalescing_totals {
+  std::uint64_t bytes { 0u };
+  std::uint64_t writes { 0u };
+  std::uint64_t sink_calls { 0u };
+  std::uint64_t flushes { 0u };
+
+/**
+ * @brief Average number of writes per sink call.
+ */
+  double average_batch() const noexcept {
+    return sink_calls == 0u ? 0.0 : static_cast<double>(writes) / static_cast<double>(sink_calls);
+  }
+};
+
+/**
+ * @brief Buffer coalescing small writes into gather write batches.
+ */
+class coalescing_writer {
+public:
+  using sink_type = std::function<void (std::span<const io_vec>)>;
+  using stats_callback = std::function<void (const flush_stats&)>;
+  using time_point = tsc_clock::time_point;
+
+/**
+ * @brief Construct the writer.
+ *
+ * @param sink Function passed each batch of segments; it must consume all of the
+ * bytes (e.g. with @c write_all) or throw.
+ *
+ * @param config Thresholds and sizes.
+ *
+ * @param on_flush Optional function passed the statistics of flushes triggered by
+ * @c write.
+ */
+  explicit coalescing_writer(sink_type sink, const coalescing_config& config = coalescing_config { },
+                             stats_callback on_flush = stats_callback { }) :
+      m_sink(std::move(sink)), m_config(config), m_on_flush(std::move(on_flush)) {
+    if (m_config.chunk_size == 0u) {
+      m_config.chunk_size = 1u;
+    }
+    if (m_config.max_segments == 0u) {
+      m_config.max_segments = 1u;
+    }
+  }
+
+  coalescing_writer(const coalescing_writer&) = delete;
+  coalescing_writer& operator=(const coalescing_writer&) = delete;
+
+/**
+ * @brief Buffer (or, for a large payload, immediately pass on) a span of bytes,
+ * flushing if a threshold is reached.
+ */
+  void write(std::span<const std::byte> data) {
+    if (data.empty()) {
+      return;
+    }
+    auto now = tsc_clock::now();
+    if (m_pending_bytes == 0u) {
+      m_deadline = now + m_config.max_delay;
+    }
+    ++m_pending_writes;
+    if (data.size() >= m_config.copy_threshold) {
+      report(emit(flush_reason::large_write, data));
+      return;
+    }
+    append(data);
+    if (m_pending_bytes >= m_config.flush_bytes) {
+      report(emit(flush_reason::size, { }));
+    }
+    else if (now >= m_deadline) {
+      report(emit(flush_reason::deadline, { }));
+    }
+  }
+
+/**
+ * @brief Pass all buffered bytes to the sink.
+ *
+ * @return Statistics of the flush (all zero if nothing was buffered).
+ */
+  flush_stats flush() { return emit(flush_reason::explicit_flush, { }); }
+
+/**
+ * @brief Flush if the deadline of the buffered bytes has expired.
+ */
+  std::optional<flush_stats> poll() {
+    if (m_pending_bytes == 0u || tsc_clock::now() < m_deadline) {
+      return { };
+    }
+    return emit(flush_reason::deadline, { });
+  }
+
+/**
+ * @brief Time by which the buffered bytes will be flushed (by the next @c write or
+ * @c poll call), or an empty @c optional if nothing is buffered.
+ */
+  std::optional<time_point> deadline() const noexcept {
+    if (m_pending_bytes == 0u) {
+      return { };
+    }
+    return m_deadline;
+  }
+
+  std::size_t pending_bytes() const noexcept { return m_pending_bytes; }
+
+  const coalescing_totals& totals() const noexcept { return m_totals; }
+
+/**
+ * @brief Number of chunks allocated, in use or pooled.
+ */
+  std::size_t chunks_allocated() const noexcept { return m_chunks.size() + m_free.size(); }
+
+private:
+
+  void append(std::span<const std::byte> data) {
+    while (!data.empty()) {
+      if (m_chunks.empty() || m_last_used == m_config.chunk_size) {
+        if (m_free.empty()) {
+          m_chunks.emplace_back(new std::byte[m_config.chunk_size]);
+        }
+        else {
+          m_chunks.push_back(std::move(m_free.back()));
+          m_free.pop_back();
+        }
+        m_last_used = 0u;
+      }
+      auto n = m_config.chunk_size - m_last_used;
+      n = (n < data.size()) ? n : data.size();
+      std::memcpy(m_chunks.back().get() + m_last_used, data.data(), n);
+      m_last_used += n;
+      m_pending_bytes += n;
+      data = data.subspan(n);
+    }
+  }
+
+  flush_stats emit(flush_reason reason, std::span<const std::byte> large) {
+    flush_stats st;
+    st.reason = reason;
+    m_iov.clear();
+    for (std::size_t i = 0u; i < m_chunks.size(); ++i) {
+      auto len = (i + 1u == m_chunks.size()) ? m_last_used : m_config.chunk_size;
+      if (len > 0u) {
+        m_iov.push_back(io_vec { m_chunks[i].get(), len });
+      }
+    }
+    if (!large.empty()) {
+      // writev does not modify the segments, the cast is only for the iovec type
+      m_iov.push_back(io_vec { const_cast<std::byte*>(large.data()), large.size() });
+    }
+    st.bytes = m_pending_bytes + large.size();
+    st.writes = m_pending_writes;
+    st.segments = m_iov.size();
+    // the buffer is recycled even if the sink throws
+    for (auto& c : m_chunks) {
+      m_free.push_back(std::move(c));
+    }
+    m_chunks.clear();
+    m_last_used = 0u;
+    m_pending_bytes = 0u;
+    m_pending_writes = 0u;
+    std::span<const io_vec> segs(m_iov);
+    while (!segs.empty()) {
+      auto n = (segs.size() < m_config.max_segments) ? segs.size() : m_config.max_segments;
+      m_sink(segs.first(n));
+      segs = segs.subspan(n);
+      ++st.sink_calls;
+    }
+    st.writes_saved = (st.writes > st.sink_calls) ? st.writes - st.sink_calls : 0u;
+    m_totals.bytes += st.bytes;
+    m_totals.writes += st.writes;
+    m_totals.sink_calls += st.sink_calls;
+    m_totals.flushes += (st.sink_calls > 0u) ? 1u : 0u;
+    return st;
+  }
+
+  void report(const flush_stats& st) {
+    if (m_on_flush) {
+      m_on_flush(st);
+    }
+  }
+
+private:
+  sink_type                                 m_sink;
+  coalescing_config                         m_config;
+  stats_callback                            m_on_flush;
+  std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+  std::vector<std::unique_ptr<std::byte[]>> m_free;
+  std::vector<io_vec>                       m_iov;
+  std::size_t                               m_last_used { 0u };
+  std::size_t                               m_pending_bytes { 0u };
+  std::size_t                               m_pending_writes { 0u };
+  time_point                                m_deadline { };
+  coalescing_totals                         m_totals;
+};
+
+#if defined(__linux__)
+/**
+ * @brief Write all bytes of a batch of segments to a file descriptor with @c writev,
+ * continuing after partial writes and interrupted calls.
+ *
+ * @return An empty error code on success, otherwise the @c errno value of the failed
+ * call.
+ */
+inline std::error_code write_all(int fd, std::span<const io_vec> segs) {
+  std::size_t offset = 0u; // bytes of the first segment already written
+  while (!segs.empty()) {
+    auto cnt = (segs.size() < IOV_MAX) ? segs.size() : std::size_t{IOV_MAX};
+    auto n = (offset == 0u) ?
+        ::writev(fd, segs.data(), static_cast<int>(cnt)) :
+        ::write(fd, static_cast<const std::byte*>(segs[0].iov_base) + offset, segs[0].iov_len - offset);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return std::error_code(errno, std::generic_category());
+    }
+    auto written = static_cast<std::size_t>(n) + offset;
+    while (!segs.empty() && written >= segs[0].iov_len) {
+      written -= segs[0].iov_len;
+      segs = segs.subspan(1u);
+    }
+    offset = written;
+  }
+  return { };
+}
+#endif
+
+} // end namespace
+
+#endif
+
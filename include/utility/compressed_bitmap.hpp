@@ -0,0 +1,405 @@
+/** @file
+ *
+ * @brief A compressed bitmap for sparse sets of 32-bit values, in the style of
+ * Roaring bitmaps.
+ *
+ * A dense @c bitmap needs one bit per possible value, which is wasteful when the set
+ * bits are sparse (e.g. a few thousand ids spread over a 32-bit range). A
+ * @c compressed_bitmap partitions the value range into chunks of 65536 values, keyed by
+ * the high 16 bits of the value. Each non-empty chunk is stored in one of two forms,
+ * chosen by its cardinality:
+ *
+ * - an array container, a sorted vector of the low 16 bits of each value, used when the
+ *   chunk holds at most 4096 values (at most 8 KiB);
+ * - a bitmap container, 1024 64-bit words (exactly 8 KiB), used for denser chunks.
+ *
+ * Containers switch form automatically as values are added and removed. Intersection
+ * and union operate container by container, using merges for array containers and
+ * word operations (with the same population count as @c bitmap) for bitmap containers.
+ *
+ * Values are visited in increasing order by @c for_each, and conversions to and from a
+ * dense @c bitmap are provided.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef COMPRESSED_BITMAP_HPP_INCLUDED
+#define COMPRESSED_BITMAP_HPP_INCLUDED
+
+#include <algorithm> // std::lower_bound, std::set_intersection, std::set_union
+#include <bit> // std::popcount, std::countr_zero
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint16_t, std::uint32_t, std::uint64_t
+#include <iterator> // std::back_inserter
+#include <vector>
+
+#include "utility/bitmap.hpp"
+
+namespace chops {
+
+/**
+ * @brief Compressed set of 32-bit unsigned values.
+ */
+class compressed_bitmap {
+public:
+
+  compressed_bitmap() = default;
+
+/**
+ * @brief Construct from the set bits of a dense bitmap, whose size must not exceed
+ * 2^32 bits.
+ */
+  explicit compressed_bitmap(const bitmap& bm) {
+    bm.for_each_set([this] (std::size_t pos) { add(static_cast<std::uint32_t>(pos)); } );
+  }
+
+/**
+ * @brief Add a value.
+ *
+ * @return @c true if the value was not already present.
+ */
+  bool add(std::uint32_t val) {
+    auto& c = find_or_insert(high(val));
+    auto lo = low(val);
+    if (c.is_bitmap()) {
+      auto& w = c.bits[lo / 64u];
+      auto b = std::uint64_t{1u} << (lo % 64u);
+      if (w & b) {
+        return false;
+      }
+      w |= b;
+      ++c.cardinality;
+      return true;
+    }
+    auto it = std::lower_bound(c.array.begin(), c.array.end(), lo);
+    if (it != c.array.end() && *it == lo) {
+      return false;
+    }
+    c.array.insert(it, lo);
+    ++c.cardinality;
+    if (c.cardinality > array_max) {
+      c.to_bitmap_form();
+    }
+    return true;
+  }
+
+/**
+ * @brief Remove a value.
+ *
+ * @return @c true if the value was present.
+ */
+  bool remove(std::uint32_t val) {
+    auto it = find_container(high(val));
+    if (it == m_containers.end()) {
+      return false;
+    }
+    auto& c = *it;
+    auto lo = low(val);
+    if (c.is_bitmap()) {
+      auto& w = c.bits[lo / 64u];
+      auto b = std::uint64_t{1u} << (lo % 64u);
+      if (!(w & b)) {
+        return false;
+      }
+      w &= ~b;
+      --c.cardinality;
+      if (c.cardinality <= array_max) {
+        c.to_array_form();
+      }
+    }
+    else {
+      auto ait = std::lower_bound(c.array.begin(), c.array.end(), lo);
+      if (ait == c.array.end() || *ait != lo) {
+        return false;
+      }
+      c.array.erase(ait);
+      --c.cardinality;
+    }
+    if (c.cardinality == 0u) {
+      m_containers.erase(it);
+    }
+    return true;
+  }
+
+  bool contains(std::uint32_t val) const noexcept {
+    auto it = find_container(high(val));
+    if (it == m_containers.end()) {
+      return false;
+    }
+    auto lo = low(val);
+    if (it->is_bitmap()) {
+      return (it->bits[lo / 64u] >> (lo % 64u)) & 1u;
+    }
+    return std::binary_search(it->array.begin(), it->array.end(), lo);
+  }
+
+/**
+ * @brief Number of values in the set.
+ */
+  std::size_t cardinality() const noexcept {
+    std::size_t n = 0u;
+    for (const auto& c : m_containers) {
+      n += c.cardinality;
+    }
+    return n;
+  }
+
+  bool empty() const noexcept { return m_containers.empty(); }
+
+/**
+ * @brief Number of containers, and how many are in bitmap form; useful for judging
+ * the compression achieved.
+ */
+  std::size_t container_count() const noexcept { return m_containers.size(); }
+
+  std::size_t bitmap_container_count() const noexcept {
+    return static_cast<std::size_t>(std::count_if(m_containers.begin(), m_containers.end(),
+        [] (const container& c) { return c.is_bitmap(); } ));
+  }
+
+/**
+ * @brief Approximate number of bytes used for values.
+ */
+  std::size_t memory_bytes() const noexcept {
+    std::size_t n = 0u;
+    for (const auto& c : m_containers) {
+      n += sizeof(container) + c.array.size() * sizeof(std::uint16_t) + c.bits.size() * sizeof(std::uint64_t);
+    }
+    return n;
+  }
+
+/**
+ * @brief Invoke a function object with each value, in increasing order.
+ */
+  template <typename F>
+  void for_each(F&& func) const {
+    for (const auto& c : m_containers) {
+      std::uint32_t base = std::uint32_t{c.key} << 16u;
+      if (c.is_bitmap()) {
+        for (std::uint32_t wi = 0u; wi < bitmap_words; ++wi) {
+          auto w = c.bits[wi];
+          while (w != 0u) {
+            func(base + wi * 64u + static_cast<std::uint32_t>(std::countr_zero(w)));
+            w &= w - 1u;
+          }
+        }
+      }
+      else {
+        for (auto lo : c.array) {
+          func(base + lo);
+        }
+      }
+    }
+  }
+
+/**
+ * @brief Convert to a dense bitmap of the given size; values not less than @c num_bits
+ * are dropped.
+ */
+  bitmap to_bitmap(std::size_t num_bits) const {
+    bitmap bm(num_bits);
+    for_each([&bm, num_bits] (std::uint32_t v) {
+      if (v < num_bits) {
+        bm.set(v);
+      }
+    } );
+    return bm;
+  }
+
+  friend compressed_bitmap operator&(const compressed_bitmap& lhs, const compressed_bitmap& rhs) {
+    compressed_bitmap result;
+    auto li = lhs.m_containers.begin();
+    auto ri = rhs.m_containers.begin();
+    while (li != lhs.m_containers.end() && ri != rhs.m_containers.end()) {
+      if (li->key < ri->key) {
+        ++li;
+      }
+      else if (ri->key < li->key) {
+        ++ri;
+      }
+      else {
+        auto c = intersect(*li, *ri);
+        if (c.cardinality != 0u) {
+          result.m_containers.push_back(std::move(c));
+        }
+        ++li;
+        ++ri;
+      }
+    }
+    return result;
+  }
+
+  friend compressed_bitmap operator|(const compressed_bitmap& lhs, const compressed_bitmap& rhs) {
+    compressed_bitmap result;
+    auto li = lhs.m_containers.begin();
+    auto ri = rhs.m_containers.begin();
+    while (li != lhs.m_containers.end() || ri != rhs.m_containers.end()) {
+      if (ri == rhs.m_containers.end() || (li != lhs.m_containers.end() && li->key < ri->key)) {
+        result.m_containers.push_back(*li++);
+      }
+      else if (li == lhs.m_containers.end() || ri->key < li->key) {
+        result.m_containers.push_back(*ri++);
+      }
+      else {
+        result.m_containers.push_back(unite(*li, *ri));
+        ++li;
+        ++ri;
+      }
+    }
+    return result;
+  }
+
+  friend bool operator==(const compressed_bitmap& lhs, const compressed_bitmap& rhs) noexcept {
+    return lhs.m_containers == rhs.m_containers;
+  }
+
+private:
+
+  static constexpr std::uint32_t array_max = 4096u;
+  static constexpr std::uint32_t bitmap_words = 65536u / 64u;
+
+  struct container {
+    std::uint16_t              key { 0u };
+    std::uint32_t              cardinality { 0u };
+    std::vector<std::uint16_t> array; // sorted, used when bits is empty
+    std::vector<std::uint64_t> bits;  // bitmap_words words when in bitmap form
+
+    bool is_bitmap() const noexcept { return !bits.empty(); }
+
+    void to_bitmap_form() {
+      bits.assign(bitmap_words, 0u);
+      for (auto lo : array) {
+        bits[lo / 64u] |= std::uint64_t{1u} << (lo % 64u);
+      }
+      array.clear();
+      array.shrink_to_fit();
+    }
+
+    void to_array_form() {
+      array.clear();
+      array.reserve(cardinality);
+      for (std::uint32_t wi = 0u; wi < bitmap_words; ++wi) {
+        auto w = bits[wi];
+        while (w != 0u) {
+          array.push_back(static_cast<std::uint16_t>(wi * 64u + static_cast<std::uint32_t>(std::countr_zero(w))));
+          w &= w - 1u;
+        }
+      }
+      bits.clear();
+      bits.shrink_to_fit();
+    }
+
+    // choose the form from the cardinality
+    void normalize() {
+      if (is_bitmap() && cardinality <= array_max) {
+        to_array_form();
+      }
+      else if (!is_bitmap() && cardinality > array_max) {
+        to_bitmap_form();
+      }
+    }
+
+    bool test(std::uint16_t lo) const noexcept {
+      return is_bitmap() ? ((bits[lo / 64u] >> (lo % 64u)) & 1u) :
+                           std::binary_search(array.begin(), array.end(), lo);
+    }
+
+    friend bool operator==(const container&, const container&) = default;
+  };
+
+  static std::uint16_t high(std::uint32_t val) noexcept { return static_cast<std::uint16_t>(val >> 16u); }
+  static std::uint16_t low(std::uint32_t val) noexcept { return static_cast<std::uint16_t>(val & 0xffffu); }
+
+  static container intersect(const container& a, const container& b) {
+    container c;
+    c.key = a.key;
+    if (a.is_bitmap() && b.is_bitmap()) {
+      c.bits.resize(bitmap_words);
+      for (std::uint32_t i = 0u; i < bitmap_words; ++i) {
+        c.bits[i] = a.bits[i] & b.bits[i];
+      }
+      c.cardinality = static_cast<std::uint32_t>(detail::popcount_words(c.bits.data(), bitmap_words));
+    }
+    else if (!a.is_bitmap() && !b.is_bitmap()) {
+      std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                            std::back_inserter(c.array));
+      c.cardinality = static_cast<std::uint32_t>(c.array.size());
+    }
+    else {
+      const auto& arr = a.is_bitmap() ? b : a;
+      const auto& bm = a.is_bitmap() ? a : b;
+      for (auto lo : arr.array) {
+        if (bm.test(lo)) {
+          c.array.push_back(lo);
+        }
+      }
+      c.cardinality = static_cast<std::uint32_t>(c.array.size());
+    }
+    c.normalize();
+    return c;
+  }
+
+  static container unite(const container& a, const container& b) {
+    container c;
+    c.key = a.key;
+    if (!a.is_bitmap() && !b.is_bitmap()) {
+      std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                     std::back_inserter(c.array));
+      c.cardinality = static_cast<std::uint32_t>(c.array.size());
+    }
+    else {
+      c.bits.assign(bitmap_words, 0u);
+      for (const auto* src : { &a, &b }) {
+        if (src->is_bitmap()) {
+          for (std::uint32_t i = 0u; i < bitmap_words; ++i) {
+            c.bits[i] |= src->bits[i];
+          }
+        }
+        else {
+          for (auto lo : src->array) {
+            c.bits[lo / 64u] |= std::uint64_t{1u} << (lo % 64u);
+          }
+        }
+      }
+      c.cardinality = static_cast<std::uint32_t>(detail::popcount_words(c.bits.data(), bitmap_words));
+    }
+    c.normalize();
+    return c;
+  }
+
+  std::vector<container>::iterator find_container(std::uint16_t key) noexcept {
+    auto it = std::lower_bound(m_containers.begin(), m_containers.end(), key,
+        [] (const container& c, std::uint16_t k) { return c.key < k; } );
+    return (it != m_containers.end() && it->key == key) ? it : m_containers.end();
+  }
+
+  std::vector<container>::const_iterator find_container(std::uint16_t key) const noexcept {
+    auto it = std::lower_bound(m_containers.begin(), m_containers.end(), key,
+        [] (const container& c, std::uint16_t k) { return c.key < k; } );
+    return (it != m_containers.end() && it->key == key) ? it : m_containers.end();
+  }
+
+  container& find_or_insert(std::uint16_t key) {
+    auto it = std::lower_bound(m_containers.begin(), m_containers.end(), key,
+        [] (const container& c, std::uint16_t k) { return c.key < k; } );
+    if (it == m_containers.end() || it->key != key) {
+      it = m_containers.insert(it, container { });
+      it->key = key;
+    }
+    return *it;
+  }
+
+private:
+  std::vector<container> m_containers; // sorted by key
+};
+
+} // end namespace
+
+#endif
+
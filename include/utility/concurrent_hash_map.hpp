@@ -0,0 +1,647 @@
+/** @file
+ *
+ * @brief A sharded concurrent hash map using open addressing with Swiss table style
+ * group probing.
+ *
+ * A @c std::unordered_map protected by a single mutex serializes every lookup, and
+ * each lookup chases node pointers. @c concurrent_hash_map splits the keys over a
+ * power of two number of shards, each with its own lock and its own open addressing
+ * table, so threads working on different shards do not contend.
+ *
+ * Each table stores one control byte per slot, holding either "empty", "deleted", or
+ * 7 bits of the key's hash. Slots are probed in groups of 16: the group's control
+ * bytes are compared against the hash bits in a single SSE2 instruction (or with SWAR
+ * arithmetic on other targets), so that most lookups compare the full key only once.
+ * Groups are visited with triangular probing and tables grow at 7/8 occupancy.
+ *
+ * Writers lock the shard (a @c spin_lock) and bump a per-shard sequence counter around
+ * each modification, as in @c seqlock. When both the key and mapped types are
+ * trivially copyable, reads are lock-free: a reader probes the table optimistically,
+ * copying keys and values through relaxed atomic words, and retries if the sequence
+ * changed. Tables replaced by a rehash are retired to an @c epoch_domain, so a reader
+ * still probing an old table never touches freed memory. For other types (e.g.
+ * @c std::string keys) reads take the shard lock.
+ *
+ * Values are returned by copy (@c find returns a @c std::optional), and in-place
+ * modification is done through @c update. @c erase_if (also available as an
+ * @c erase_where_if overload) removes the entries matching a predicate, one shard at
+ * a time, or in parallel on threads started for the call if requested.
+ *
+ * @code
+ * chops::concurrent_hash_map<std::uint64_t, session_info> sessions;
+ * sessions.insert(id, info);
+ * if (auto s = sessions.find(id); s) { ... }
+ * chops::erase_where_if(sessions, [now] (std::uint64_t, const session_info& si) {
+ *     return si.expiry < now; } );
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef CONCURRENT_HASH_MAP_HPP_INCLUDED
+#define CONCURRENT_HASH_MAP_HPP_INCLUDED
+
+#include <array>
+#include <atomic>
+#include <bit> // std::bit_ceil, std::bit_cast, std::countr_zero
+#include <cstddef> // std::byte, std::size_t
+#include <cstdint> // std::uint8_t, std::uint32_t, std::uint64_t
+#include <functional> // std::hash, std::equal_to
+#include <memory> // std::unique_ptr, std::make_unique
+#include <mutex> // std::lock_guard
+#include <new> // std::launder
+#include <optional>
+#include <thread>
+#include <type_traits> // std::is_trivially_copyable_v
+#include <utility> // std::pair, std::move, std::forward
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#include "utility/cache_padded.hpp"
+#include "utility/cast_ptr_to.hpp"
+#include "utility/memory_reclaim.hpp"
+#include "utility/seqlock.hpp"
+#include "utility/spin_lock.hpp"
+
+namespace chops {
+
+namespace detail {
+
+constexpr std::uint8_t ctrl_empty = 0x80u;
+constexpr std::uint8_t ctrl_deleted = 0xfeu;
+constexpr std::size_t group_width = 16u;
+
+// one bit per byte of a word whose high bit is set, in byte order
+inline std::uint32_t compress_high_bits(std::uint64_t w) noexcept {
+  return static_cast<std::uint32_t>((((w >> 7u) & 0x0101010101010101u) * 0x0102040810204080u) >> 56u);
+}
+
+// mask of the group's control bytes equal to b
+inline std::uint32_t group_match(std::uint64_t lo, std::uint64_t hi, std::uint8_t b) noexcept {
+#if defined(__SSE2__) || defined(_M_X64)
+  auto g = _mm_set_epi64x(static_cast<long long>(hi), static_cast<long long>(lo));
+  return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8(static_cast<char>(b)))));
+#else
+  constexpr std::uint64_t lsb = 0x0101010101010101u;
+  constexpr std::uint64_t low7 = 0x7f7f7f7f7f7f7f7fu;
+  auto zero_bytes = [] (std::uint64_t x) { return ~(((x & low7) + low7) | x | low7); };
+  return compress_high_bits(zero_bytes(lo ^ (lsb * b))) |
+         (compress_high_bits(zero_bytes(hi ^ (lsb * b))) << 8u);
+#endif
+}
+
+// mask of the group's empty or deleted control bytes (the high bit is set)
+inline std::uint32_t group_match_free(std::uint64_t lo, std::uint64_t hi) noexcept {
+#if defined(__SSE2__) || defined(_M_X64)
+  return static_cast<std::uint32_t>(_mm_movemask_epi8(
+      _mm_set_epi64x(static_cast<long long>(hi), static_cast<long long>(lo))));
+#else
+  return compress_high_bits(lo) | (compress_high_bits(hi) << 8u);
+#endif
+}
+
+inline std::uint64_t mix_hash(std::size_t h) noexcept {
+  auto m = static_cast<std::uint64_t>(h) * 0x9e3779b97f4a7c15u;
+  return m ^ (m >> 32u);
+}
+
+template <typename T>
+constexpr std::size_t word_count = (sizeof(T) + 7u) / 8u;
+
+// slot holding a trivially copyable key and value as relaxed atomic words, read
+// optimistically by lock-free readers
+template <typename Key, typename T, bool Optimistic>
+struct hash_slot {
+  std::array<std::atomic<std::uint64_t>, word_count<Key>> key_words;
+  std::array<std::atomic<std::uint64_t>, word_count<T>>   value_words;
+
+  void construct(const Key& k, const T& v) noexcept {
+    store_words<sizeof(Key)>(key_words, cast_ptr_to<std::byte>(&k));
+    set_value(v);
+  }
+  void destroy() noexcept { }
+
+  Key key() const noexcept {
+    std::array<std::byte, sizeof(Key)> buf;
+    load_words<sizeof(Key)>(key_words, buf.data());
+    return std::bit_cast<Key>(buf);
+  }
+  T value() const noexcept {
+    std::array<std::byte, sizeof(T)> buf;
+    load_words<sizeof(T)>(value_words, buf.data());
+    return std::bit_cast<T>(buf);
+  }
+  void set_value(const T& v) noexcept {
+    store_words<sizeof(T)>(value_words, cast_ptr_to<std::byte>(&v));
+  }
+  void move_to(hash_slot& dst) noexcept {
+    for (std::size_t i = 0u; i < key_words.size(); ++i) {
+      dst.key_words[i].store(key_words[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    for (std::size_t i = 0u; i < value_words.size(); ++i) {
+      dst.value_words[i].store(value_words[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+  }
+};
+
+// slot holding any key and value, only accessed with the shard lock held
+template <typename Key, typename T>
+struct hash_slot<Key, T, false> {
+  using pair_type = std::pair<Key, T>;
+
+  alignas(pair_type) std::byte storage[sizeof(pair_type)];
+
+  pair_type& entry() noexcept { return *std::launder(reinterpret_cast<pair_type*>(storage)); }
+  const pair_type& entry() const noexcept { return *std::launder(reinterpret_cast<const pair_type*>(storage)); }
+
+  template <typename K, typename V>
+  void construct(K&& k, V&& v) {
+    ::new (static_cast<void*>(storage)) pair_type(std::forward<K>(k), std::forward<V>(v));
+  }
+  void destroy() noexcept { entry().~pair_type(); }
+
+  const Key& key() const noexcept { return entry().first; }
+  const T& value() const noexcept { return entry().second; }
+  T& value() noexcept { return entry().second; }
+  template <typename V>
+  void set_value(V&& v) { entry().second = std::forward<V>(v); }
+  void move_to(hash_slot& dst) {
+    dst.construct(std::move(entry().first), std::move(entry().second));
+    destroy();
+  }
+};
+
+}
+
+/**
+ * @brief Sharded concurrent hash map.
+ *
+ * @tparam Key Key type, hashed with @c Hash and compared with @c KeyEqual.
+ *
+ * @tparam T Mapped type.
+ */
+template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class concurrent_hash_map {
+public:
+  using key_type = Key;
+  using mapped_type = T;
+
+/**
+ * @brief @c true if reads are lock-free (both types are trivially copyable).
+ */
+  static constexpr bool lock_free_reads = std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>;
+
+/**
+ * @brief Construct the map.
+ *
+ * @param num_shards Number of shards, rounded up to a power of two.
+ *
+ * @param initial_capacity Initial number of slots per shard, rounded up to a power of
+ * two of at least 16.
+ */
+  explicit concurrent_hash_map(std::size_t num_shards = 16u, std::size_t initial_capacity = 16u,
+                               const Hash& hash = Hash { }, const KeyEqual& equal = KeyEqual { }) :
+      m_hash(hash), m_equal(equal),
+      m_num_shards(std::bit_ceil(num_shards == 0u ? 1u : num_shards)),
+      m_shards(std::make_unique<shard[]>(m_num_shards)) {
+    auto cap = std::bit_ceil(initial_capacity < detail::group_width ? detail::group_width : initial_capacity);
+    for (std::size_t i = 0u; i < m_num_shards; ++i) {
+      m_shards[i].tbl.store(new table(cap), std::memory_order_relaxed);
+      m_shards[i].growth_left = cap / 8u * 7u;
+    }
+  }
+
+  ~concurrent_hash_map() {
+    for (std::size_t i = 0u; i < m_num_shards; ++i) {
+      auto* t = m_shards[i].tbl.load(std::memory_order_relaxed);
+      destroy_slots(*t);
+      delete t;
+    }
+  }
+
+  concurrent_hash_map(const concurrent_hash_map&) = delete;
+  concurrent_hash_map& operator=(const concurrent_hash_map&) = delete;
+
+/**
+ * @brief Insert a key and value if the key is not present.
+ *
+ * @return @c true if inserted, @c false if the key was already present (the existing
+ * value is unchanged).
+ */
+  bool insert(const Key& key, const T& val) {
+    auto h = detail::mix_hash(m_hash(key));
+    auto& s = shard_for(h);
+    std::lock_guard lk(s.lock);
+    if (find_index(*s.tbl.load(std::memory_order_relaxed), key, h) != npos) {
+      return false;
+    }
+    insert_new(s, key, val, h);
+    return true;
+  }
+
+/**
+ * @brief Insert a key and value, or assign the value if the key is present.
+ *
+ * @return @c true if inserted, @c false if assigned.
+ */
+  bool insert_or_assign(const Key& key, const T& val) {
+    auto h = detail::mix_hash(m_hash(key));
+    auto& s = shard_for(h);
+    std::lock_guard lk(s.lock);
+    auto* t = s.tbl.load(std::memory_order_relaxed);
+    if (auto i = find_index(*t, key, h); i != npos) {
+      write_begin(s);
+      t->slots[i].set_value(val);
+      write_end(s);
+      return false;
+    }
+    insert_new(s, key, val, h);
+    return true;
+  }
+
+/**
+ * @brief Modify the value of a key in place, invoking @c func with a @c T& while the
+ * shard is locked.
+ *
+ * @return @c true if the key was present.
+ */
+  template <typename F>
+  bool update(const Key& key, F&& func) {
+    auto h = detail::mix_hash(m_hash(key));
+    auto& s = shard_for(h);
+    std::lock_guard lk(s.lock);
+    auto* t = s.tbl.load(std::memory_order_relaxed);
+    auto i = find_index(*t, key, h);
+    if (i == npos) {
+      return false;
+    }
+    if constexpr (lock_free_reads) {
+      auto val = t->slots[i].value();
+      func(val);
+      write_begin(s);
+      t->slots[i].set_value(val);
+      write_end(s);
+    }
+    else {
+      func(t->slots[i].value());
+    }
+    return true;
+  }
+
+/**
+ * @brief Return a copy of the value for a key.
+ *
+ * @return The value, or an empty @c std::optional if the key is not present.
+ */
+  std::optional<T> find(const Key& key) const {
+    auto h = detail::mix_hash(m_hash(key));
+    const auto& s = shard_for(h);
+    if constexpr (lock_free_reads) {
+      epoch_guard g(m_epoch);
+      for (;;) {
+        auto seq1 = s.seq.load(std::memory_order_acquire);
+        if ((seq1 & 1u) == 0u) {
+          const auto* t = s.tbl.load(std::memory_order_acquire);
+          std::optional<T> result;
+          if (auto i = find_index(*t, key, h); i != npos) {
+            result = t->slots[i].value();
+          }
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if (s.seq.load(std::memory_order_relaxed) == seq1) {
+            return result;
+          }
+        }
+        cpu_relax();
+      }
+    }
+    else {
+      std::lock_guard lk(s.lock);
+      const auto* t = s.tbl.load(std::memory_order_relaxed);
+      if (auto i = find_index(*t, key, h); i != npos) {
+        return { t->slots[i].value() };
+      }
+      return { };
+    }
+  }
+
+  bool contains(const Key& key) const { return find(key).has_value(); }
+
+/**
+ * @brief Erase a key.
+ *
+ * @return @c true if the key was present.
+ */
+  bool erase(const Key& key) {
+    auto h = detail::mix_hash(m_hash(key));
+    auto& s = shard_for(h);
+    std::lock_guard lk(s.lock);
+    auto* t = s.tbl.load(std::memory_order_relaxed);
+    auto i = find_index(*t, key, h);
+    if (i == npos) {
+      return false;
+    }
+    write_begin(s);
+    erase_slot(s, *t, i);
+    write_end(s);
+    return true;
+  }
+
+/**
+ * @brief Erase the entries for which @c pred(key, value) returns @c true.
+ *
+ * The shards are processed by the calling thread, one at a time. With @c max_threads
+ * greater than 1 they are processed in parallel, by the calling thread and up to
+ * @c max_threads - 1 threads started for this call. Each shard is locked while it is
+ * processed; the predicate must not throw or access the map.
+ *
+ * @return Number of entries erased.
+ */
+  template <typename Pred>
+  std::size_t erase_if(Pred pred, std::size_t max_threads = 1u) {
+    std::atomic<std::size_t> next { 0u };
+    std::atomic<std::size_t> erased { 0u };
+    auto worker = [this, &pred, &next, &erased] {
+      std::vector<std::size_t> victims;
+      for (auto si = next.fetch_add(1u); si < m_num_shards; si = next.fetch_add(1u)) {
+        auto& s = m_shards[si];
+        std::lock_guard lk(s.lock);
+        auto* t = s.tbl.load(std::memory_order_relaxed);
+        victims.clear();
+        for (std::size_t i = 0u; i < t->capacity; ++i) {
+          if (is_full(*t, i) && pred(t->slots[i].key(), t->slots[i].value())) {
+            victims.push_back(i);
+          }
+        }
+        if (!victims.empty()) {
+          write_begin(s);
+          for (auto i : victims) {
+            erase_slot(s, *t, i);
+          }
+          write_end(s);
+          erased.fetch_add(victims.size(), std::memory_order_relaxed);
+        }
+      }
+    };
+    auto num_thrs = (max_threads < m_num_shards) ? max_threads : m_num_shards;
+    std::vector<std::thread> thrs;
+    for (std::size_t i = 1u; i < num_thrs; ++i) {
+      thrs.emplace_back(worker);
+    }
+    worker();
+    for (auto& thr : thrs) {
+      thr.join();
+    }
+    return erased.load();
+  }
+
+/**
+ * @brief Invoke @c func(key, value) for each entry, locking one shard at a time; the
+ * function must not access the map.
+ */
+  template <typename F>
+  void for_each(F&& func) const {
+    for (std::size_t si = 0u; si < m_num_shards; ++si) {
+      const auto& s = m_shards[si];
+      std::lock_guard lk(s.lock);
+      const auto* t = s.tbl.load(std::memory_order_relaxed);
+      for (std::size_t i = 0u; i < t->capacity; ++i) {
+        if (is_full(*t, i)) {
+          func(t->slots[i].key(), t->slots[i].value());
+        }
+      }
+    }
+  }
+
+/**
+ * @brief Erase all entries; table capacities are retained.
+ */
+  void clear() {
+    for (std::size_t si = 0u; si < m_num_shards; ++si) {
+      auto& s = m_shards[si];
+      std::lock_guard lk(s.lock);
+      auto* t = s.tbl.load(std::memory_order_relaxed);
+      write_begin(s);
+      destroy_slots(*t);
+      t->reset_ctrl();
+      s.size.store(0u, std::memory_order_relaxed);
+      s.growth_left = t->capacity / 8u * 7u;
+      write_end(s);
+    }
+  }
+
+/**
+ * @brief Number of entries; a snapshot that may be stale when modified concurrently.
+ */
+  std::size_t size() const noexcept {
+    std::size_t n = 0u;
+    for (std::size_t si = 0u; si < m_num_shards; ++si) {
+      n += m_shards[si].size.load(std::memory_order_relaxed);
+    }
+    return n;
+  }
+
+  bool empty() const noexcept { return size() == 0u; }
+
+  std::size_t shard_count() const noexcept { return m_num_shards; }
+
+private:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  using slot_type = detail::hash_slot<Key, T, lock_free_reads>;
+
+  struct table {
+    explicit table(std::size_t cap) :
+        capacity(cap), ctrl(std::make_unique<std::atomic<std::uint64_t>[]>(cap / 8u)),
+        slots(std::make_unique<slot_type[]>(cap)) {
+      reset_ctrl();
+    }
+
+    void reset_ctrl() noexcept {
+      for (std::size_t i = 0u; i < capacity / 8u; ++i) {
+        ctrl[i].store(0x0101010101010101u * detail::ctrl_empty, std::memory_order_relaxed);
+      }
+    }
+
+    std::size_t                                   capacity;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> ctrl; // 8 control bytes per word
+    std::unique_ptr<slot_type[]>                  slots;
+  };
+
+  struct alignas(cache_line_size) shard {
+    mutable spin_lock          lock;
+    std::atomic<std::uint64_t> seq { 0u };
+    std::atomic<table*>        tbl { nullptr };
+    std::atomic<std::size_t>   size { 0u };
+    std::size_t                growth_left { 0u }; // empty slots usable before a rehash
+  };
+
+  shard& shard_for(std::uint64_t h) noexcept { return m_shards[(h >> 48u) & (m_num_shards - 1u)]; }
+  const shard& shard_for(std::uint64_t h) const noexcept { return m_shards[(h >> 48u) & (m_num_shards - 1u)]; }
+
+  static std::uint8_t h2(std::uint64_t h) noexcept { return static_cast<std::uint8_t>(h & 0x7fu); }
+
+  static std::uint8_t ctrl_at(const table& t, std::size_t i) noexcept {
+    return static_cast<std::uint8_t>(t.ctrl[i / 8u].load(std::memory_order_relaxed) >> ((i % 8u) * 8u));
+  }
+
+  static bool is_full(const table& t, std::size_t i) noexcept { return (ctrl_at(t, i) & 0x80u) == 0u; }
+
+  static void set_ctrl(table& t, std::size_t i, std::uint8_t b) noexcept {
+    auto shift = (i % 8u) * 8u;
+    auto w = t.ctrl[i / 8u].load(std::memory_order_relaxed);
+    w = (w & ~(std::uint64_t{0xffu} << shift)) | (std::uint64_t{b} << shift);
+    t.ctrl[i / 8u].store(w, std::memory_order_relaxed);
+  }
+
+  // visits each group once, starting from the hash's home group; stops when f returns true
+  template <typename F>
+  static void probe(const table& t, std::uint64_t h, F&& f) {
+    auto num_groups = t.capacity / detail::group_width;
+    auto g = static_cast<std::size_t>(h >> 7u) & (num_groups - 1u);
+    for (std::size_t step = 1u; step <= num_groups; ++step) {
+      auto lo = t.ctrl[g * 2u].load(std::memory_order_relaxed);
+      auto hi = t.ctrl[g * 2u + 1u].load(std::memory_order_relaxed);
+      if (f(g * detail::group_width, lo, hi)) {
+        return;
+      }
+      g = (g + step) & (num_groups - 1u);
+    }
+  }
+
+  std::size_t find_index(const table& t, const Key& key, std::uint64_t h) const {
+    std::size_t result = npos;
+    probe(t, h, [&] (std::size_t base, std::uint64_t lo, std::uint64_t hi) {
+      for (auto m = detail::group_match(lo, hi, h2(h)); m != 0u; m &= m - 1u) {
+        auto i = base + static_cast<std::size_t>(std::countr_zero(m));
+        if (m_equal(t.slots[i].key(), key)) {
+          result = i;
+          return true;
+        }
+      }
+      return detail::group_match(lo, hi, detail::ctrl_empty) != 0u;
+    } );
+    return result;
+  }
+
+  static std::size_t find_free(const table& t, std::uint64_t h) noexcept {
+    std::size_t result = npos;
+    probe(t, h, [&result] (std::size_t base, std::uint64_t lo, std::uint64_t hi) {
+      if (auto m = detail::group_match_free(lo, hi); m != 0u) {
+        result = base + static_cast<std::size_t>(std::countr_zero(m));
+        return true;
+      }
+      return false;
+    } );
+    return result;
+  }
+
+  static void write_begin(shard& s) noexcept {
+    s.seq.store(s.seq.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  static void write_end(shard& s) noexcept {
+    s.seq.store(s.seq.load(std::memory_order_relaxed) + 1u, std::memory_order_release);
+  }
+
+  // key is known to be absent, shard lock is held
+  void insert_new(shard& s, const Key& key, const T& val, std::uint64_t h) {
+    if (s.growth_left == 0u) {
+      rehash(s);
+    }
+    auto* t = s.tbl.load(std::memory_order_relaxed);
+    auto i = find_free(*t, h);
+    write_begin(s);
+    if (ctrl_at(*t, i) == detail::ctrl_empty) {
+      --s.growth_left;
+    }
+    t->slots[i].construct(key, val);
+    set_ctrl(*t, i, h2(h));
+    write_end(s);
+    s.size.store(s.size.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+  }
+
+  // an emptied slot can be marked empty (rather than deleted) when its group still
+  // has an empty slot, since no probe sequence continues past such a group
+  void erase_slot(shard& s, table& t, std::size_t i) noexcept {
+    auto g = i / detail::group_width;
+    auto group_has_empty = detail::group_match(t.ctrl[g * 2u].load(std::memory_order_relaxed),
+                                               t.ctrl[g * 2u + 1u].load(std::memory_order_relaxed),
+                                               detail::ctrl_empty) != 0u;
+    set_ctrl(t, i, group_has_empty ? detail::ctrl_empty : detail::ctrl_deleted);
+    if (group_has_empty) {
+      ++s.growth_left;
+    }
+    t.slots[i].destroy();
+    s.size.store(s.size.load(std::memory_order_relaxed) - 1u, std::memory_order_relaxed);
+  }
+
+  // move the entries to a new table, doubling the capacity unless most of the used
+  // slots are deleted markers; the old table is retired, since readers may be probing it
+  void rehash(shard& s) {
+    auto* old = s.tbl.load(std::memory_order_relaxed);
+    auto sz = s.size.load(std::memory_order_relaxed);
+    auto cap = ((sz + 1u) * 16u > old->capacity * 7u) ? old->capacity * 2u : old->capacity;
+    auto* fresh = new table(cap);
+    for (std::size_t i = 0u; i < old->capacity; ++i) {
+      if (is_full(*old, i)) {
+        auto h = detail::mix_hash(m_hash(old->slots[i].key()));
+        auto j = find_free(*fresh, h);
+        old->slots[i].move_to(fresh->slots[j]);
+        set_ctrl(*fresh, j, h2(h));
+      }
+    }
+    write_begin(s);
+    s.tbl.store(fresh, std::memory_order_release);
+    s.growth_left = cap / 8u * 7u - sz;
+    write_end(s);
+    if constexpr (lock_free_reads) {
+      m_epoch.retire(old);
+    }
+    else {
+      delete old;
+    }
+  }
+
+  static void destroy_slots(table& t) noexcept {
+    if constexpr (!lock_free_reads) {
+      for (std::size_t i = 0u; i < t.capacity; ++i) {
+        if (is_full(t, i)) {
+          t.slots[i].destroy();
+        }
+      }
+    }
+  }
+
+private:
+  Hash                     m_hash;
+  KeyEqual                 m_equal;
+  mutable epoch_domain     m_epoch { 1u };
+  std::size_t              m_num_shards;
+  std::unique_ptr<shard[]> m_shards;
+};
+
+/**
+ * @brief Erase the entries of a @c concurrent_hash_map for which @c pred(key, value)
+ * returns @c true, processing one shard at a time.
+ *
+ * @return Number of entries erased.
+ */
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Pred>
+std::size_t erase_where_if(concurrent_hash_map<Key, T, Hash, KeyEqual>& m, Pred&& pred) {
+  return m.erase_if(std::forward<Pred>(pred));
+}
+
+} // end namespace
+
+#endif
+
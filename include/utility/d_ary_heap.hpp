@@ -0,0 +1,386 @@
+/** @file
+ *
+ * @brief A d-ary heap priority queue, and an indexed variant whose elements can be
+ * updated or erased through handles.
+ *
+ * @c std::priority_queue is a binary heap: each level of a sift down touches a new
+ * cache line and compares only two children, and it has no way to change or remove an
+ * element other than the top, so schedulers either rebuild it or leave cancelled
+ * entries in place as tombstones. @c d_ary_heap<T, D> stores @c D children per node
+ * (4 or 8 are the usual choices, so a node's children share one or two cache lines),
+ * which halves or thirds the tree height; the best child is chosen with a loop over
+ * a fixed @c D that compiles to conditional moves rather than branches.
+ *
+ * @c indexed_priority_queue<T, D> returns a @c slot_handle from @c push, and supports
+ * @c update (change an element's priority, e.g. a rescheduled deadline) and @c erase
+ * (cancel) by handle in O(log n), with stale handles detected as in @c slot_map.
+ *
+ * Both follow @c std::priority_queue ordering: with the default @c std::less, @c top
+ * is the largest element; use @c std::greater for a min heap (earliest deadline
+ * first). Neither is thread safe.
+ *
+ * @code
+ * chops::indexed_priority_queue<timer_entry, 4, by_deadline> timers;
+ * auto h = timers.push(timer_entry { deadline, id });
+ * timers.update(h, timer_entry { later_deadline, id });
+ * timers.erase(h); // cancelled
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef D_ARY_HEAP_HPP_INCLUDED
+#define D_ARY_HEAP_HPP_INCLUDED
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <functional> // std::less
+#include <limits>
+#include <span>
+#include <stdexcept> // std::length_error
+#include <utility> // std::move, std::forward
+#include <vector>
+
+#include "utility/slot_map.hpp" // slot_handle
+
+namespace chops {
+
+namespace detail {
+
+// index of the child preferred by cmp among children [first, first + cnt); with cnt
+// a constant the loop is unrolled into conditional moves
+template <std::size_t Cnt, typename T, typename Cmp>
+std::size_t best_child(const T* data, std::size_t first, const Cmp& cmp) {
+  std::size_t best = first;
+  for (std::size_t i = 1u; i < Cnt; ++i) {
+    best = cmp(data[best], data[first + i]) ? first + i : best;
+  }
+  return best;
+}
+
+template <typename T, typename Cmp>
+std::size_t best_child(const T* data, std::size_t first, std::size_t cnt, const Cmp& cmp) {
+  std::size_t best = first;
+  for (std::size_t i = 1u; i < cnt; ++i) {
+    best = cmp(data[best], data[first + i]) ? first + i : best;
+  }
+  return best;
+}
+
+// move the element at pos toward the root; moved(p) is called for each position that
+// receives a different element, including the final position
+template <std::size_t D, typename T, typename Cmp, typename Moved>
+void sift_up(std::vector<T>& v, std::size_t pos, const Cmp& cmp, Moved moved) {
+  T tmp = std::move(v[pos]);
+  while (pos > 0u) {
+    auto parent = (pos - 1u) / D;
+    if (!cmp(v[parent], tmp)) {
+      break;
+    }
+    v[pos] = std::move(v[parent]);
+    moved(pos);
+    pos = parent;
+  }
+  v[pos] = std::move(tmp);
+  moved(pos);
+}
+
+template <std::size_t D, typename T, typename Cmp, typename Moved>
+void sift_down(std::vector<T>& v, std::size_t pos, const Cmp& cmp, Moved moved) {
+  auto n = v.size();
+  T tmp = std::move(v[pos]);
+  for (;;) {
+    auto first = pos * D + 1u;
+    if (first >= n) {
+      break;
+    }
+    auto child = (first + D <= n) ? best_child<D>(v.data(), first, cmp) :
+                                    best_child(v.data(), first, n - first, cmp);
+    if (!cmp(tmp, v[child])) {
+      break;
+    }
+    v[pos] = std::move(v[child]);
+    moved(pos);
+    pos = child;
+  }
+  v[pos] = std::move(tmp);
+  moved(pos);
+}
+
+// refill the hole left at the root by pop: move the best child up at each level down
+// to a leaf, without comparing against the replacement element (which, taken from the
+// back, usually belongs near the bottom), then put the replacement in the leaf hole
+// and sift it up
+template <std::size_t D, typename T, typename Cmp, typename Moved>
+void pop_root(std::vector<T>& v, const Cmp& cmp, Moved moved) {
+  T tmp = std::move(v.back());
+  v.pop_back();
+  auto n = v.size();
+  if (n == 0u) {
+    return;
+  }
+  std::size_t pos = 0u;
+  for (;;) {
+    auto first = pos * D + 1u;
+    if (first >= n) {
+      break;
+    }
+    auto child = (first + D <= n) ? best_child<D>(v.data(), first, cmp) :
+                                    best_child(v.data(), first, n - first, cmp);
+    v[pos] = std::move(v[child]);
+    moved(pos);
+    pos = child;
+  }
+  v[pos] = std::move(tmp);
+  sift_up<D>(v, pos, cmp, moved);
+}
+
+}
+
+/**
+ * @brief Priority queue stored as a d-ary heap in a @c std::vector.
+ *
+ * @tparam T Element type.
+ *
+ * @tparam D Children per node, at least 2.
+ *
+ * @tparam Compare Ordering; @c top is an element no other element is greater than.
+ */
+template <typename T, std::size_t D = 4u, typename Compare = std::less<T>>
+class d_ary_heap {
+  static_assert(D >= 2u, "d_ary_heap needs at least two children per node");
+public:
+  using value_type = T;
+
+  d_ary_heap() = default;
+  explicit d_ary_heap(const Compare& cmp) : m_cmp(cmp) { }
+
+  void push(const T& val) { emplace(val); }
+  void push(T&& val) { emplace(std::move(val)); }
+
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    m_data.emplace_back(std::forward<Args>(args)...);
+    detail::sift_up<D>(m_data, m_data.size() - 1u, m_cmp, [] (std::size_t) { } );
+  }
+
+  const T& top() const noexcept { return m_data.front(); }
+
+  void pop() { detail::pop_root<D>(m_data, m_cmp, [] (std::size_t) { } ); }
+
+  std::size_t size() const noexcept { return m_data.size(); }
+  bool empty() const noexcept { return m_data.empty(); }
+  void reserve(std::size_t n) { m_data.reserve(n); }
+  void clear() noexcept { m_data.clear(); }
+
+/**
+ * @brief The elements in heap order (@c top first, the rest unsorted).
+ */
+  std::span<const T> data() const noexcept { return m_data; }
+
+private:
+  std::vector<T> m_data;
+  Compare        m_cmp { };
+};
+
+/**
+ * @brief D-ary heap priority queue with update and erase through handles.
+ *
+ * @tparam T Element type.
+ *
+ * @tparam D Children per node, at least 2.
+ *
+ * @tparam Compare Ordering; @c top is an element no other element is greater than.
+ */
+template <typename T, std::size_t D = 4u, typename Compare = std::less<T>>
+class indexed_priority_queue {
+  static_assert(D >= 2u, "indexed_priority_queue needs at least two children per node");
+public:
+  using value_type = T;
+  using handle = slot_handle;
+
+  indexed_priority_queue() = default;
+  explicit indexed_priority_queue(const Compare& cmp) : m_cmp_wrap { cmp } { }
+
+/**
+ * @brief Insert an element.
+ *
+ * @return Handle for @c update and @c erase, valid until the element is popped or
+ * erased.
+ *
+ * @throw std::length_error if 2^32 - 1 elements are queued.
+ */
+  handle push(const T& val) { return emplace(val); }
+  handle push(T&& val) { return emplace(std::move(val)); }
+
+  template <typename... Args>
+  handle emplace(Args&&... args) {
+    if (m_free_head == npos) {
+      if (m_slots.size() == npos) {
+        throw std::length_error("indexed_priority_queue: handle space exhausted");
+      }
+      m_slots.push_back(slot { npos, 1u });
+      m_free_head = static_cast<std::uint32_t>(m_slots.size() - 1u);
+    }
+    auto idx = m_free_head;
+    m_heap.push_back(entry { T(std::forward<Args>(args)...), idx });
+    m_free_head = m_slots[idx].m_pos;
+    auto h = handle(idx, m_slots[idx].m_generation);
+    sift_up(m_heap.size() - 1u);
+    return h;
+  }
+
+  const T& top() const noexcept { return m_heap.front().m_val; }
+
+  handle top_handle() const noexcept {
+    auto idx = m_heap.front().m_slot;
+    return handle(idx, m_slots[idx].m_generation);
+  }
+
+  void pop() {
+    release(m_heap.front().m_slot);
+    detail::pop_root<D>(m_heap, m_cmp_wrap, moved());
+  }
+
+/**
+ * @brief Element of a handle, or @c nullptr if the handle is stale.
+ */
+  const T* find(handle h) const noexcept {
+    auto pos = position(h);
+    return pos == npos ? nullptr : &m_heap[pos].m_val;
+  }
+
+  bool contains(handle h) const noexcept { return position(h) != npos; }
+
+/**
+ * @brief Replace the element of a handle, moving it up or down as needed.
+ *
+ * @return @c false if the handle is stale.
+ */
+  bool update(handle h, const T& val) { return update_with(h, [&val] (T& v) { v = val; } ); }
+  bool update(handle h, T&& val) { return update_with(h, [&val] (T& v) { v = std::move(val); } ); }
+
+/**
+ * @brief Modify the element of a handle in place with @c f(T&), then restore the
+ * heap order.
+ *
+ * @return @c false if the handle is stale.
+ */
+  template <typename F>
+  bool update_with(handle h, F&& f) {
+    auto pos = position(h);
+    if (pos == npos) {
+      return false;
+    }
+    f(m_heap[pos].m_val);
+    restore(pos);
+    return true;
+  }
+
+/**
+ * @brief Remove the element of a handle.
+ *
+ * @return @c false if the handle is stale.
+ */
+  bool erase(handle h) {
+    auto pos = position(h);
+    if (pos == npos) {
+      return false;
+    }
+    remove_at(pos);
+    return true;
+  }
+
+  std::size_t size() const noexcept { return m_heap.size(); }
+  bool empty() const noexcept { return m_heap.empty(); }
+
+  void reserve(std::size_t n) {
+    m_heap.reserve(n);
+    m_slots.reserve(n);
+  }
+
+  void clear() {
+    while (!m_heap.empty()) {
+      release(m_heap.back().m_slot);
+      m_heap.pop_back();
+    }
+  }
+
+private:
+  static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+  struct entry {
+    T             m_val;
+    std::uint32_t m_slot;
+  };
+
+  struct slot {
+    std::uint32_t m_pos;        // position in m_heap, or next free slot
+    std::uint32_t m_generation;
+  };
+
+  struct entry_compare {
+    Compare m_cmp;
+    bool operator()(const entry& a, const entry& b) const { return m_cmp(a.m_val, b.m_val); }
+  };
+
+  std::uint32_t position(handle h) const noexcept {
+    auto idx = h.index();
+    if (!h || idx >= m_slots.size() || m_slots[idx].m_generation != h.generation()) {
+      return npos;
+    }
+    return m_slots[idx].m_pos;
+  }
+
+  auto moved() noexcept {
+    return [this] (std::size_t pos) { m_slots[m_heap[pos].m_slot].m_pos = static_cast<std::uint32_t>(pos); };
+  }
+
+  void sift_up(std::size_t pos) { detail::sift_up<D>(m_heap, pos, m_cmp_wrap, moved()); }
+  void sift_down(std::size_t pos) { detail::sift_down<D>(m_heap, pos, m_cmp_wrap, moved()); }
+
+  void restore(std::size_t pos) {
+    if (pos > 0u && m_cmp_wrap(m_heap[(pos - 1u) / D], m_heap[pos])) {
+      sift_up(pos);
+    }
+    else {
+      sift_down(pos);
+    }
+  }
+
+  void release(std::uint32_t idx) noexcept {
+    auto& s = m_slots[idx];
+    s.m_generation = (s.m_generation == npos) ? 1u : s.m_generation + 1u;
+    s.m_pos = m_free_head;
+    m_free_head = idx;
+  }
+
+  void remove_at(std::size_t pos) {
+    release(m_heap[pos].m_slot);
+    if (pos + 1u < m_heap.size()) {
+      m_heap[pos] = std::move(m_heap.back());
+      m_heap.pop_back();
+      restore(pos);
+    }
+    else {
+      m_heap.pop_back();
+    }
+  }
+
+private:
+  std::vector<entry> m_heap;
+  std::vector<slot>  m_slots;
+  std::uint32_t      m_free_head { npos };
+  entry_compare      m_cmp_wrap { };
+};
+
+} // end namespace
+
+#endif
+
@@ -0,0 +1,218 @@
+/** @file
+ *
+ * @brief Fast 64-bit hashing of byte spans.
+ *
+ * @c std::hash is only specified for a fixed set of types, its quality varies between
+ * implementations (for integers it is often the identity function), and it cannot hash
+ * an arbitrary byte buffer without first creating a @c std::string. @c hash_bytes hashes
+ * a @c std::span of @c std::byte (or a @c std::string_view) to a well mixed 64-bit
+ * value using the wyhash algorithm by Wang Yi: the input is consumed 16 or 48 bytes at a
+ * time, combining words with 64 x 64 to 128-bit multiplies (@c mul_fold). Short inputs
+ * (16 bytes or less) take a branch-light path with no loop.
+ *
+ * The result depends on the seed, which allows independent hash functions to be derived
+ * and protects tables exposed to untrusted keys. The hash is not cryptographic.
+ * Words are read in little-endian order on every platform, and the @c std::string_view
+ * overload is @c constexpr, so a hash computed at compile time matches the hash of the
+ * same characters computed at run time.
+ *
+ * @c hash_value hashes the object representation of a trivially copyable value (one
+ * without padding bytes), and @c hash_mix is a strong finalizer for an existing 64-bit
+ * value such as an integer key or a @c std::hash result.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef HASH_BYTES_HPP_INCLUDED
+#define HASH_BYTES_HPP_INCLUDED
+
+#include <bit> // std::endian
+#include <cstddef> // std::byte, std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <cstring> // std::memcpy
+#include <span>
+#include <string_view>
+#include <type_traits> // std::has_unique_object_representations_v, std::is_constant_evaluated
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#include "utility/cast_ptr_to.hpp"
+
+namespace chops {
+
+namespace detail {
+
+constexpr std::uint64_t wy_p0 = 0xa0761d6478bd642fu;
+constexpr std::uint64_t wy_p1 = 0xe7037ed1a0b428dbu;
+constexpr std::uint64_t wy_p2 = 0x8ebc6af09c88c6e3u;
+constexpr std::uint64_t wy_p3 = 0x589965cc75374cc3u;
+
+// full 128-bit product of two 64-bit values, as low and high halves
+constexpr void mul128(std::uint64_t a, std::uint64_t b, std::uint64_t& lo, std::uint64_t& hi) noexcept {
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 uint128;
+  auto r = static_cast<uint128>(a) * b;
+  lo = static_cast<std::uint64_t>(r);
+  hi = static_cast<std::uint64_t>(r >> 64u);
+#else
+#if defined(_MSC_VER) && defined(_M_X64)
+  if (!std::is_constant_evaluated()) {
+    lo = _umul128(a, b, &hi);
+    return;
+  }
+#endif
+  auto ha = a >> 32u, hb = b >> 32u, la = a & 0xffffffffu, lb = b & 0xffffffffu;
+  auto rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  auto t = rl + (rm0 << 32u);
+  auto c = static_cast<std::uint64_t>(t < rl);
+  lo = t + (rm1 << 32u);
+  c += static_cast<std::uint64_t>(lo < t);
+  hi = rh + (rm0 >> 32u) + (rm1 >> 32u) + c;
+#endif
+}
+
+template <typename B>
+constexpr std::uint64_t byte_at(const B* p, std::size_t i) noexcept {
+  if constexpr (std::is_same_v<B, std::byte>) {
+    return std::to_integer<std::uint64_t>(p[i]);
+  }
+  else {
+    return static_cast<unsigned char>(p[i]);
+  }
+}
+
+// little-endian reads, so that constant evaluated and run-time hashes agree
+template <typename B>
+constexpr std::uint64_t read64(const B* p) noexcept {
+  if (std::is_constant_evaluated() || std::endian::native != std::endian::little) {
+    std::uint64_t v = 0u;
+    for (std::size_t i = 0u; i < 8u; ++i) {
+      v |= byte_at(p, i) << (8u * i);
+    }
+    return v;
+  }
+  std::uint64_t v;
+  std::memcpy(&v, p, 8u);
+  return v;
+}
+
+template <typename B>
+constexpr std::uint64_t read32(const B* p) noexcept {
+  if (std::is_constant_evaluated() || std::endian::native != std::endian::little) {
+    return byte_at(p, 0u) | (byte_at(p, 1u) << 8u) | (byte_at(p, 2u) << 16u) | (byte_at(p, 3u) << 24u);
+  }
+  std::uint32_t v;
+  std::memcpy(&v, p, 4u);
+  return v;
+}
+
+// 1 to 3 bytes, reading the first, middle, and last bytes
+template <typename B>
+constexpr std::uint64_t read_small(const B* p, std::size_t len) noexcept {
+  return (byte_at(p, 0u) << 16u) | (byte_at(p, len >> 1u) << 8u) | byte_at(p, len - 1u);
+}
+
+constexpr std::uint64_t mul_fold(std::uint64_t a, std::uint64_t b) noexcept {
+  std::uint64_t lo = 0u, hi = 0u;
+  mul128(a, b, lo, hi);
+  return lo ^ hi;
+}
+
+template <typename B>
+constexpr std::uint64_t wyhash(const B* p, std::size_t len, std::uint64_t seed) noexcept {
+  seed ^= mul_fold(seed ^ wy_p0, wy_p1);
+  std::uint64_t a = 0u, b = 0u;
+  if (len <= 16u) {
+    if (len >= 4u) {
+      auto off = (len >> 3u) << 2u;
+      a = (read32(p) << 32u) | read32(p + off);
+      b = (read32(p + len - 4u) << 32u) | read32(p + len - 4u - off);
+    }
+    else if (len > 0u) {
+      a = read_small(p, len);
+    }
+  }
+  else {
+    auto i = len;
+    if (i > 48u) {
+      auto s1 = seed, s2 = seed;
+      do {
+        seed = mul_fold(read64(p) ^ wy_p1, read64(p + 8u) ^ seed);
+        s1 = mul_fold(read64(p + 16u) ^ wy_p2, read64(p + 24u) ^ s1);
+        s2 = mul_fold(read64(p + 32u) ^ wy_p3, read64(p + 40u) ^ s2);
+        p += 48u;
+        i -= 48u;
+      } while (i > 48u);
+      seed ^= s1 ^ s2;
+    }
+    while (i > 16u) {
+      seed = mul_fold(read64(p) ^ wy_p1, read64(p + 8u) ^ seed);
+      p += 16u;
+      i -= 16u;
+    }
+    a = read64(p + i - 16u);
+    b = read64(p + i - 8u);
+  }
+  a ^= wy_p1;
+  b ^= seed;
+  mul128(a, b, a, b);
+  return mul_fold(a ^ wy_p0 ^ len, b ^ wy_p1);
+}
+
+}
+
+/**
+ * @brief Multiply two 64-bit values and fold the 128-bit product to 64 bits with xor.
+ */
+constexpr std::uint64_t mul_fold(std::uint64_t a, std::uint64_t b) noexcept {
+  return detail::mul_fold(a, b);
+}
+
+/**
+ * @brief Hash a span of bytes.
+ *
+ * @param bytes The bytes to hash.
+ *
+ * @param seed Seed value, selecting one of a family of hash functions.
+ */
+inline std::uint64_t hash_bytes(std::span<const std::byte> bytes, std::uint64_t seed = 0u) noexcept {
+  return detail::wyhash(bytes.data(), bytes.size(), seed);
+}
+
+/**
+ * @brief Hash the characters of a string; usable in constant expressions, with the
+ * same result as hashing the characters as bytes at run time.
+ */
+constexpr std::uint64_t hash_bytes(std::string_view str, std::uint64_t seed = 0u) noexcept {
+  return detail::wyhash(str.data(), str.size(), seed);
+}
+
+/**
+ * @brief Hash the object representation of a value, which must not contain padding
+ * bytes (so that equal values hash equally).
+ */
+template <typename T>
+  requires std::has_unique_object_representations_v<T>
+std::uint64_t hash_value(const T& val, std::uint64_t seed = 0u) noexcept {
+  return hash_bytes(std::span<const std::byte>(cast_ptr_to<std::byte>(&val), sizeof(T)), seed);
+}
+
+/**
+ * @brief Mix the bits of a 64-bit value, e.g. an integer key or a weak hash.
+ */
+constexpr std::uint64_t hash_mix(std::uint64_t val, std::uint64_t seed = 0u) noexcept {
+  return mul_fold(val ^ seed ^ detail::wy_p0, detail::wy_p1);
+}
+
+} // end namespace
+
+#endif
+
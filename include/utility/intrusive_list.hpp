@@ -0,0 +1,361 @@
+/** @file
+ *
+ * @brief An intrusive doubly linked list, where elements embed the link pointers in a
+ * hook base class instead of being held in separately allocated nodes.
+ *
+ * A @c std::list<T*> of objects owned elsewhere (an LRU list, a list of idle
+ * connections) allocates a node per element, and removing an object requires a search
+ * or a stored iterator. With @c intrusive_list<T> the object derives from
+ * @c list_hook, linking and unlinking never allocate, and an object removes itself from
+ * whatever list it is in with @c unlink in constant time. The list never owns, copies
+ * or destroys its elements.
+ *
+ * An object can be in several lists at once by deriving from several hooks with
+ * different tag types, one per list. A hook created with @c link_mode::auto_unlink
+ * unlinks itself when the object is destroyed; with the default mode, destroying a
+ * linked object is an error. Since objects can leave a list without the list being
+ * involved, the list does not store its size, and @c size is linear.
+ *
+ * @c erase_where_if (also in @c erase_where.hpp for standard containers) is overloaded
+ * for @c intrusive_list, unlinking (not destroying) each matching element.
+ *
+ * In debug builds, safe mode checks are enabled with @c assert: linking an object that
+ * is already linked, destroying a linked object with a non auto unlink hook, and
+ * popping from or removing an object that is not in a list. The checks compile out
+ * when @c NDEBUG is defined.
+ *
+ * @code
+ * struct lru_tag { };
+ * struct connection : chops::list_hook<lru_tag, chops::link_mode::auto_unlink> { ... };
+ * chops::intrusive_list<connection, lru_tag> lru;
+ * lru.push_front(conn);
+ * lru.move_to_front(conn); // on each use
+ * chops::erase_where_if(lru, [] (const connection& c) { return c.closed(); } );
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef INTRUSIVE_LIST_HPP_INCLUDED
+#define INTRUSIVE_LIST_HPP_INCLUDED
+
+#include <cassert>
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <iterator> // std::bidirectional_iterator_tag
+#include <type_traits> // std::conditional_t, std::is_base_of_v
+#include <utility> // std::swap
+
+namespace chops {
+
+/**
+ * @brief Whether a hook unlinks itself on destruction.
+ */
+enum class link_mode { normal, auto_unlink };
+
+namespace detail {
+
+template <typename Tag>
+struct list_node {
+  list_node* m_prev { nullptr };
+  list_node* m_next { nullptr };
+
+  bool linked() const noexcept { return m_next != nullptr; }
+
+  void unlink() noexcept {
+    m_prev->m_next = m_next;
+    m_next->m_prev = m_prev;
+    m_prev = nullptr;
+    m_next = nullptr;
+  }
+
+  // link this node before pos
+  void link_before(list_node* pos) noexcept {
+    assert(!linked());
+    m_prev = pos->m_prev;
+    m_next = pos;
+    pos->m_prev->m_next = this;
+    pos->m_prev = this;
+  }
+};
+
+}
+
+template <typename T, typename Tag = void>
+class intrusive_list;
+
+/**
+ * @brief Base class making an object linkable into an @c intrusive_list with the same
+ * tag.
+ *
+ * Copying an object does not copy its links; the copy starts unlinked.
+ */
+template <typename Tag = void, link_mode Mode = link_mode::normal>
+class list_hook : private detail::list_node<Tag> {
+public:
+  list_hook() noexcept = default;
+  list_hook(const list_hook&) noexcept { }
+  list_hook& operator=(const list_hook&) noexcept { return *this; }
+
+  ~list_hook() {
+    if constexpr (Mode == link_mode::auto_unlink) {
+      unlink();
+    }
+    else {
+      assert(!is_linked());
+    }
+  }
+
+/**
+ * @brief Whether the object is in a list.
+ */
+  bool is_linked() const noexcept { return this->linked(); }
+
+/**
+ * @brief Remove the object from its list, if any, in constant time.
+ */
+  void unlink() noexcept {
+    if (this->linked()) {
+      detail::list_node<Tag>::unlink();
+    }
+  }
+
+private:
+  template <typename T, typename U>
+  friend class intrusive_list;
+};
+
+/**
+ * @brief Doubly linked list of objects deriving from @c list_hook<Tag, Mode>.
+ */
+template <typename T, typename Tag>
+class intrusive_list {
+  static_assert(std::is_base_of_v<detail::list_node<Tag>, T>,
+                "intrusive_list element must derive from a list_hook with the list's tag");
+
+  using node = detail::list_node<Tag>;
+
+  static T* to_value(node* n) noexcept { return static_cast<T*>(n); }
+  static const T* to_value(const node* n) noexcept { return static_cast<const T*>(n); }
+  static node* to_node(T& val) noexcept { return static_cast<node*>(&val); }
+
+  template <bool Const>
+  class iter {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+    using node_ptr = std::conditional_t<Const, const node*, node*>;
+
+    iter() noexcept = default;
+    explicit iter(node_ptr n) noexcept : m_node(n) { }
+    operator iter<true>() const noexcept { return iter<true>(m_node); }
+
+    reference operator*() const noexcept { return *to_value(m_node); }
+    pointer operator->() const noexcept { return to_value(m_node); }
+
+    iter& operator++() noexcept { m_node = m_node->m_next; return *this; }
+    iter operator++(int) noexcept { auto t = *this; m_node = m_node->m_next; return t; }
+    iter& operator--() noexcept { m_node = m_node->m_prev; return *this; }
+    iter operator--(int) noexcept { auto t = *this; m_node = m_node->m_prev; return t; }
+
+    friend bool operator==(const iter& a, const iter& b) noexcept { return a.m_node == b.m_node; }
+
+  private:
+    friend class intrusive_list;
+    node_ptr m_node { nullptr };
+  };
+
+public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = iter<false>;
+  using const_iterator = iter<true>;
+
+  intrusive_list() noexcept { m_root.m_prev = &m_root; m_root.m_next = &m_root; }
+
+  intrusive_list(const intrusive_list&) = delete;
+  intrusive_list& operator=(const intrusive_list&) = delete;
+
+/**
+ * @brief Take over the elements of another list, which is left empty.
+ */
+  intrusive_list(intrusive_list&& rhs) noexcept : intrusive_list() { swap(rhs); }
+
+  intrusive_list& operator=(intrusive_list&& rhs) noexcept {
+    clear();
+    swap(rhs);
+    return *this;
+  }
+
+/**
+ * @brief Unlink any remaining objects.
+ */
+  ~intrusive_list() { clear(); }
+
+  void push_front(T& val) noexcept { to_node(val)->link_before(m_root.m_next); }
+  void push_back(T& val) noexcept { to_node(val)->link_before(&m_root); }
+
+  void pop_front() noexcept { assert(!empty()); m_root.m_next->unlink(); }
+  void pop_back() noexcept { assert(!empty()); m_root.m_prev->unlink(); }
+
+  T& front() noexcept { return *to_value(m_root.m_next); }
+  const T& front() const noexcept { return *to_value(m_root.m_next); }
+  T& back() noexcept { return *to_value(m_root.m_prev); }
+  const T& back() const noexcept { return *to_value(m_root.m_prev); }
+
+/**
+ * @brief Link an object before @c pos.
+ *
+ * @return Iterator to the inserted object.
+ */
+  iterator insert(const_iterator pos, T& val) noexcept {
+    auto n = to_node(val);
+    n->link_before(const_cast<node*>(pos.m_node));
+    return iterator(n);
+  }
+
+/**
+ * @brief Unlink the object at @c pos.
+ *
+ * @return Iterator to the following object.
+ */
+  iterator erase(const_iterator pos) noexcept {
+    auto n = const_cast<node*>(pos.m_node);
+    auto next = n->m_next;
+    n->unlink();
+    return iterator(next);
+  }
+
+/**
+ * @brief Unlink an object known to be in this list.
+ */
+  void remove(T& val) noexcept {
+    assert(to_node(val)->linked());
+    to_node(val)->unlink();
+  }
+
+/**
+ * @brief Move an object (linked in this list or not linked) to the front, e.g. on
+ * each use of an LRU entry.
+ */
+  void move_to_front(T& val) noexcept {
+    auto n = to_node(val);
+    if (n->linked()) {
+      n->unlink();
+    }
+    n->link_before(m_root.m_next);
+  }
+
+  void move_to_back(T& val) noexcept {
+    auto n = to_node(val);
+    if (n->linked()) {
+      n->unlink();
+    }
+    n->link_before(&m_root);
+  }
+
+/**
+ * @brief Unlink every object for which @c pred returns @c true.
+ *
+ * @return Number of objects unlinked.
+ */
+  template <typename Pred>
+  std::size_t remove_if(Pred pred) {
+    std::size_t cnt = 0u;
+    for (auto n = m_root.m_next; n != &m_root; ) {
+      auto next = n->m_next;
+      if (pred(static_cast<const T&>(*to_value(n)))) {
+        n->unlink();
+        ++cnt;
+      }
+      n = next;
+    }
+    return cnt;
+  }
+
+/**
+ * @brief Unlink all objects.
+ */
+  void clear() noexcept {
+    while (m_root.m_next != &m_root) {
+      m_root.m_next->unlink();
+    }
+  }
+
+/**
+ * @brief Iterator to an object known to be in this list.
+ */
+  iterator iterator_to(T& val) noexcept { return iterator(to_node(val)); }
+  const_iterator iterator_to(const T& val) const noexcept { return const_iterator(static_cast<const node*>(&val)); }
+
+  bool empty() const noexcept { return m_root.m_next == &m_root; }
+
+/**
+ * @brief Number of objects, counted by walking the list.
+ */
+  std::size_t size() const noexcept {
+    std::size_t cnt = 0u;
+    for (auto n = m_root.m_next; n != &m_root; n = n->m_next) {
+      ++cnt;
+    }
+    return cnt;
+  }
+
+  void swap(intrusive_list& rhs) noexcept {
+    auto lhs_empty = empty();
+    auto rhs_empty = rhs.empty();
+    std::swap(m_root.m_prev, rhs.m_root.m_prev);
+    std::swap(m_root.m_next, rhs.m_root.m_next);
+    fix_root(rhs_empty);
+    rhs.fix_root(lhs_empty);
+  }
+
+  iterator begin() noexcept { return iterator(m_root.m_next); }
+  iterator end() noexcept { return iterator(&m_root); }
+  const_iterator begin() const noexcept { return const_iterator(m_root.m_next); }
+  const_iterator end() const noexcept { return const_iterator(&m_root); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+private:
+
+  // after swapping root pointers, point the end elements back at this root, or make
+  // the root self linked if the swapped in list was empty
+  void fix_root(bool now_empty) noexcept {
+    if (now_empty) {
+      m_root.m_prev = &m_root;
+      m_root.m_next = &m_root;
+      return;
+    }
+    m_root.m_next->m_prev = &m_root;
+    m_root.m_prev->m_next = &m_root;
+  }
+
+private:
+  node m_root;
+};
+
+/**
+ * @brief Unlink (without destroying) every element of an @c intrusive_list for which
+ * @c f returns @c true, matching @c erase_where_if for standard containers.
+ *
+ * @return Number of elements unlinked.
+ */
+template <typename T, typename Tag, typename F>
+std::size_t erase_where_if(intrusive_list<T, Tag>& c, F&& f) {
+  return c.remove_if(f);
+}
+
+} // end namespace
+
+#endif
+
@@ -0,0 +1,696 @@
+/** @file
+ *
+ * @brief Safe memory reclamation for lock-free data structures: epoch based
+ * reclamation (EBR) and hazard pointers.
+ *
+ * In a lock-free list, stack, or map a thread may unlink a node while other threads
+ * are still reading it. The node cannot be deleted until no thread can hold a
+ * reference to it. Retiring the node to a reclamation domain defers the delete until
+ * it is safe, and also prevents the ABA problem since a retired node's address is not
+ * reused while it may still be referenced.
+ *
+ * @c epoch_domain implements epoch based reclamation. Readers wrap each operation in
+ * an @c epoch_guard, which announces the current global epoch for the calling thread
+ * (a store and a fence, no read-modify-write). Retired objects are tagged with the epoch
+ * at which they were retired and are deleted once the global epoch has advanced twice
+ * beyond it, which can only happen after every thread that was inside a guard at the
+ * time of retirement has left it. Retired objects are kept in per-thread batches, and
+ * reclamation is either amortized inline (attempted by @c retire each time a thread's
+ * batch fills) or performed by a background thread at a fixed interval. EBR is very
+ * cheap for readers, but a thread stalled inside a guard blocks all reclamation, so
+ * memory use is unbounded in that case.
+ *
+ * @c hazard_domain implements hazard pointers, for scenarios needing bounded memory.
+ * Each @c hazard_guard publishes the single pointer it is protecting, and a retired
+ * object is deleted once no hazard pointer refers to it. A stalled reader only holds
+ * back the objects it is protecting. Protecting a pointer costs a store and a fence for
+ * each pointer traversed, which is more than EBR.
+ *
+ * Both domains record statistics (objects retired and reclaimed, and the latency from
+ * retirement to deletion), available from the @c stats member function.
+ *
+ * Threads are registered with a domain automatically on first use, and their per-thread
+ * record is released (with any objects still pending moved to the domain) when the
+ * thread exits. A domain must outlive all guards using it; destroying a domain deletes
+ * all remaining retired objects.
+ *
+ * @code
+ * chops::epoch_domain domain;
+ * std::atomic<node*> head;
+ * // reader
+ * {
+ *   chops::epoch_guard g(domain);
+ *   for (auto* p = head.load(); p != nullptr; p = p->next.load()) { ... }
+ * }
+ * // writer, after unlinking old_node
+ * domain.retire(old_node);
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef MEMORY_RECLAIM_HPP_INCLUDED
+#define MEMORY_RECLAIM_HPP_INCLUDED
+
+#include <algorithm> // std::sort, std::binary_search, std::partition
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <memory> // std::shared_ptr, std::unique_ptr
+#include <mutex>
+#include <stdexcept> // std::length_error
+#include <thread>
+#include <utility> // std::pair
+#include <vector>
+
+#include "utility/cache_padded.hpp"
+#include "utility/spin_lock.hpp"
+
+namespace chops {
+
+/**
+ * @brief Reclamation statistics for a domain.
+ */
+struct reclamation_stats {
+  std::uint64_t            retired { 0u };
+  std::uint64_t            reclaimed { 0u };
+  std::chrono::nanoseconds max_latency { 0 };
+  std::chrono::nanoseconds mean_latency { 0 };
+
+  std::uint64_t pending() const noexcept { return retired - reclaimed; }
+};
+
+namespace detail {
+
+struct retired_ptr {
+  void*                                 ptr;
+  void                                  (*deleter)(void*);
+  std::uint64_t                         epoch;
+  std::chrono::steady_clock::time_point when;
+};
+
+template <typename T>
+void default_reclaim_deleter(void* p) {
+  delete static_cast<T*>(p);
+}
+
+// lock-free list of per-thread records, records are reused but not freed until the
+// owning domain state is destroyed
+template <typename Rec>
+class record_list {
+public:
+  record_list() = default;
+  record_list(const record_list&) = delete;
+  record_list& operator=(const record_list&) = delete;
+
+  ~record_list() {
+    auto* r = m_head.load();
+    while (r != nullptr) {
+      auto* nxt = r->next;
+      delete r;
+      r = nxt;
+    }
+  }
+
+  template <typename F>
+  Rec* acquire(F&& make) {
+    for (auto* r = head(); r != nullptr; r = r->next) {
+      bool expected = false;
+      if (!r->in_use.load(std::memory_order_relaxed) &&
+          r->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        return r;
+      }
+    }
+    auto* r = make();
+    r->in_use.store(true, std::memory_order_relaxed);
+    r->next = m_head.load(std::memory_order_relaxed);
+    while (!m_head.compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    return r;
+  }
+
+  Rec* head() const noexcept { return m_head.load(std::memory_order_acquire); }
+
+private:
+  std::atomic<Rec*> m_head { nullptr };
+};
+
+// common retire list handling and statistics
+class reclaim_state_base {
+public:
+
+  void add_orphans(std::vector<retired_ptr>& lst) {
+    std::lock_guard lk(m_orphan_mutex);
+    m_orphans.insert(m_orphans.end(), lst.begin(), lst.end());
+    lst.clear();
+  }
+
+  void count_retired() noexcept { m_retired.fetch_add(1u, std::memory_order_relaxed); }
+
+  // move the entries for which the predicate is true out of the list, called with
+  // the list's lock held
+  template <typename Pred>
+  static std::vector<retired_ptr> extract_if(std::vector<retired_ptr>& lst, Pred&& pred) {
+    auto it = std::partition(lst.begin(), lst.end(), [&pred] (const retired_ptr& r) { return !pred(r); } );
+    std::vector<retired_ptr> ret(it, lst.end());
+    lst.erase(it, lst.end());
+    return ret;
+  }
+
+  // delete extracted entries, called without any lock held since a deleter may retire
+  // other objects
+  std::size_t destroy(const std::vector<retired_ptr>& lst) {
+    if (lst.empty()) {
+      return 0u;
+    }
+    auto now = std::chrono::steady_clock::now();
+    std::uint64_t total = 0u;
+    std::uint64_t mx = 0u;
+    for (const auto& rp : lst) {
+      auto lat = static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(now - rp.when).count());
+      total += lat;
+      mx = (lat > mx) ? lat : mx;
+      rp.deleter(rp.ptr);
+    }
+    m_reclaimed.fetch_add(lst.size(), std::memory_order_relaxed);
+    m_latency_total.fetch_add(total, std::memory_order_relaxed);
+    auto cur = m_latency_max.load(std::memory_order_relaxed);
+    while (cur < mx && !m_latency_max.compare_exchange_weak(cur, mx, std::memory_order_relaxed)) {
+    }
+    return lst.size();
+  }
+
+  // reclaim from the orphans and from every record's retire list
+  template <typename Rec, typename Pred>
+  std::size_t reclaim_all_if(const record_list<Rec>& records, Pred&& pred) {
+    std::vector<retired_ptr> dead;
+    {
+      std::lock_guard lk(m_orphan_mutex);
+      dead = extract_if(m_orphans, pred);
+    }
+    for (auto* r = records.head(); r != nullptr; r = r->next) {
+      std::lock_guard lk(r->lock);
+      auto d = extract_if(r->retired, pred);
+      dead.insert(dead.end(), d.begin(), d.end());
+    }
+    return destroy(dead);
+  }
+
+  reclamation_stats stats() const noexcept {
+    reclamation_stats st;
+    st.retired = m_retired.load(std::memory_order_relaxed);
+    st.reclaimed = m_reclaimed.load(std::memory_order_relaxed);
+    st.max_latency = std::chrono::nanoseconds(m_latency_max.load(std::memory_order_relaxed));
+    if (st.reclaimed != 0u) {
+      st.mean_latency = std::chrono::nanoseconds(
+          m_latency_total.load(std::memory_order_relaxed) / st.reclaimed);
+    }
+    return st;
+  }
+
+  bool closed() const noexcept { return m_closed.load(std::memory_order_acquire); }
+  void close() noexcept { m_closed.store(true, std::memory_order_release); }
+
+private:
+  std::mutex                 m_orphan_mutex;
+  std::vector<retired_ptr>   m_orphans;
+  std::atomic<std::uint64_t> m_retired { 0u };
+  std::atomic<std::uint64_t> m_reclaimed { 0u };
+  std::atomic<std::uint64_t> m_latency_total { 0u };
+  std::atomic<std::uint64_t> m_latency_max { 0u };
+  std::atomic<bool>          m_closed { false };
+};
+
+// per-thread cache of the records this thread owns in each domain state; the
+// records are released when the thread exits
+template <typename State>
+typename State::record_type& thread_record(const std::shared_ptr<State>& st) {
+  struct cache {
+    std::vector<std::pair<std::shared_ptr<State>, typename State::record_type*>> entries;
+    ~cache() {
+      for (auto& e : entries) {
+        e.first->release(e.second);
+      }
+    }
+  };
+  thread_local cache c;
+  for (std::size_t i = 0u; i < c.entries.size(); ) {
+    if (c.entries[i].first == st) {
+      return *c.entries[i].second;
+    }
+    if (c.entries[i].first->closed()) {
+      c.entries[i].first->release(c.entries[i].second);
+      c.entries.erase(c.entries.begin() + static_cast<std::ptrdiff_t>(i));
+      continue;
+    }
+    ++i;
+  }
+  auto* r = st->acquire();
+  c.entries.emplace_back(st, r);
+  return *r;
+}
+
+struct alignas(cache_line_size) epoch_record {
+  std::atomic<std::uint64_t> local { 0u }; // (epoch << 1) | active
+  std::atomic<bool>          in_use { false };
+  epoch_record*              next { nullptr };
+  unsigned                   nesting { 0u }; // owning thread only
+  spin_lock                  lock;
+  std::vector<retired_ptr>   retired;        // guarded by lock
+};
+
+class epoch_state : public reclaim_state_base {
+public:
+  using record_type = epoch_record;
+
+  explicit epoch_state(std::size_t batch) : m_batch(batch) { }
+
+  epoch_record* acquire() {
+    return m_records.acquire([] { return new epoch_record; } );
+  }
+
+  void release(epoch_record* r) {
+    {
+      std::lock_guard lk(r->lock);
+      add_orphans(r->retired);
+    }
+    r->nesting = 0u;
+    r->local.store(0u, std::memory_order_release);
+    r->in_use.store(false, std::memory_order_release);
+  }
+
+  void enter(epoch_record& r) noexcept {
+    if (r.nesting++ == 0u) {
+      auto e = m_global.load(std::memory_order_relaxed);
+      r.local.store((e << 1u) | 1u, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+  }
+
+  void leave(epoch_record& r) noexcept {
+    if (--r.nesting == 0u) {
+      r.local.store(0u, std::memory_order_release);
+    }
+  }
+
+  void retire(epoch_record& r, void* p, void (*deleter)(void*), bool inline_reclaim) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto e = m_global.load(std::memory_order_relaxed);
+    count_retired();
+    std::vector<retired_ptr> dead;
+    {
+      std::lock_guard lk(r.lock);
+      r.retired.push_back(retired_ptr { p, deleter, e, std::chrono::steady_clock::now() });
+      if (inline_reclaim && r.retired.size() >= m_batch) {
+        try_advance();
+        auto g = m_global.load(std::memory_order_acquire);
+        dead = extract_if(r.retired, [g] (const retired_ptr& rp) { return rp.epoch + 2u <= g; } );
+      }
+    }
+    destroy(dead);
+  }
+
+  // advance the global epoch if every thread inside a guard has seen the current one
+  bool try_advance() noexcept {
+    auto e = m_global.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (auto* r = m_records.head(); r != nullptr; r = r->next) {
+      auto l = r->local.load(std::memory_order_acquire);
+      if ((l & 1u) && (l >> 1u) != e) {
+        return false;
+      }
+    }
+    return m_global.compare_exchange_strong(e, e + 1u, std::memory_order_acq_rel);
+  }
+
+  std::size_t collect() {
+    try_advance();
+    try_advance();
+    auto g = m_global.load(std::memory_order_acquire);
+    return reclaim_all_if(m_records, [g] (const retired_ptr& rp) { return rp.epoch + 2u <= g; } );
+  }
+
+  // with no guards active, everything can be deleted
+  void drain() {
+    reclaim_all_if(m_records, [] (const retired_ptr&) { return true; } );
+  }
+
+  std::uint64_t epoch() const noexcept { return m_global.load(std::memory_order_acquire); }
+
+private:
+  std::atomic<std::uint64_t>  m_global { 0u };
+  record_list<epoch_record>   m_records;
+  const std::size_t           m_batch;
+};
+
+struct alignas(cache_line_size) hazard_record {
+  explicit hazard_record(std::size_t num_slots) :
+    slots(std::make_unique<std::atomic<void*>[]>(num_slots)), used(num_slots, false) { }
+
+  std::unique_ptr<std::atomic<void*>[]> slots;
+  std::vector<bool>                     used;   // owning thread only
+  std::atomic<bool>                     in_use { false };
+  hazard_record*                        next { nullptr };
+  spin_lock                             lock;
+  std::vector<retired_ptr>              retired; // guarded by lock
+};
+
+class hazard_state : public reclaim_state_base {
+public:
+  using record_type = hazard_record;
+
+  hazard_state(std::size_t num_slots, std::size_t threshold) :
+    m_num_slots(num_slots), m_threshold(threshold) { }
+
+  hazard_record* acquire() {
+    return m_records.acquire([this] { return new hazard_record(m_num_slots); } );
+  }
+
+  void release(hazard_record* r) {
+    {
+      std::lock_guard lk(r->lock);
+      add_orphans(r->retired);
+    }
+    for (std::size_t i = 0u; i < m_num_slots; ++i) {
+      r->slots[i].store(nullptr, std::memory_order_release);
+      r->used[i] = false;
+    }
+    r->in_use.store(false, std::memory_order_release);
+  }
+
+  std::atomic<void*>& acquire_slot(hazard_record& r) {
+    for (std::size_t i = 0u; i < m_num_slots; ++i) {
+      if (!r.used[i]) {
+        r.used[i] = true;
+        return r.slots[i];
+      }
+    }
+    throw std::length_error("hazard_domain slots per thread exceeded");
+  }
+
+  void release_slot(hazard_record& r, std::atomic<void*>& slot) noexcept {
+    slot.store(nullptr, std::memory_order_release);
+    r.used[static_cast<std::size_t>(&slot - r.slots.get())] = false;
+  }
+
+  void retire(hazard_record& r, void* p, void (*deleter)(void*), bool inline_reclaim) {
+    count_retired();
+    std::vector<retired_ptr> dead;
+    {
+      std::lock_guard lk(r.lock);
+      r.retired.push_back(retired_ptr { p, deleter, 0u, std::chrono::steady_clock::now() });
+      if (inline_reclaim && r.retired.size() >= m_threshold) {
+        auto hazards = collect_hazards();
+        dead = extract_if(r.retired, [&hazards] (const retired_ptr& rp) {
+          return !std::binary_search(hazards.begin(), hazards.end(), rp.ptr);
+        } );
+      }
+    }
+    destroy(dead);
+  }
+
+  std::size_t collect() {
+    auto hazards = collect_hazards();
+    return reclaim_all_if(m_records, [&hazards] (const retired_ptr& rp) {
+      return !std::binary_search(hazards.begin(), hazards.end(), rp.ptr);
+    } );
+  }
+
+  void drain() {
+    reclaim_all_if(m_records, [] (const retired_ptr&) { return true; } );
+  }
+
+private:
+  std::vector<void*> collect_hazards() const {
+    std::vector<void*> hazards;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (auto* r = m_records.head(); r != nullptr; r = r->next) {
+      for (std::size_t i = 0u; i < m_num_slots; ++i) {
+        if (auto* p = r->slots[i].load(std::memory_order_acquire); p != nullptr) {
+          hazards.push_back(p);
+        }
+      }
+    }
+    std::sort(hazards.begin(), hazards.end());
+    return hazards;
+  }
+
+private:
+  record_list<hazard_record> m_records;
+  const std::size_t          m_num_slots;
+  const std::size_t          m_threshold;
+};
+
+// optional background reclamation thread, shared by both domain types
+template <typename State>
+class background_reclaimer {
+public:
+  background_reclaimer(std::shared_ptr<State> st, std::chrono::milliseconds interval) {
+    if (interval.count() > 0) {
+      m_thr = std::thread([this, st, interval] {
+        std::unique_lock lk(m_mutex);
+        while (!m_stop) {
+          m_cv.wait_for(lk, interval, [this] { return m_stop; } );
+          lk.unlock();
+          st->collect();
+          lk.lock();
+        }
+      } );
+    }
+  }
+
+  ~background_reclaimer() { stop(); }
+
+  void stop() {
+    if (m_thr.joinable()) {
+      {
+        std::lock_guard lk(m_mutex);
+        m_stop = true;
+      }
+      m_cv.notify_one();
+      m_thr.join();
+    }
+  }
+
+  bool running() const noexcept { return m_thr.joinable(); }
+
+private:
+  std::mutex              m_mutex;
+  std::condition_variable m_cv;
+  bool                    m_stop { false };
+  std::thread             m_thr;
+};
+
+} // end detail namespace
+
+/**
+ * @brief Epoch based reclamation domain.
+ */
+class epoch_domain {
+public:
+
+/**
+ * @brief Construct the domain.
+ *
+ * @param batch_size Number of objects a thread retires before attempting inline
+ * reclamation of its batch.
+ *
+ * @param background_interval If non-zero, reclamation is instead performed by a
+ * background thread at this interval, and @c retire never deletes objects.
+ */
+  explicit epoch_domain(std::size_t batch_size = 64u,
+                        std::chrono::milliseconds background_interval = std::chrono::milliseconds { 0 }) :
+      m_state(std::make_shared<detail::epoch_state>(batch_size)),
+      m_background(m_state, background_interval) { }
+
+  epoch_domain(const epoch_domain&) = delete;
+  epoch_domain& operator=(const epoch_domain&) = delete;
+
+/**
+ * @brief Stop any background thread and delete all retired objects; no guards may
+ * be active.
+ */
+  ~epoch_domain() {
+    m_state->close();
+    m_background.stop();
+    m_state->drain();
+  }
+
+/**
+ * @brief Retire an object allocated with @c new, to be deleted once no guard can
+ * reference it.
+ */
+  template <typename T>
+  void retire(T* p) {
+    retire(static_cast<void*>(p), &detail::default_reclaim_deleter<T>);
+  }
+
+/**
+ * @brief Retire an object with a custom deleter.
+ */
+  void retire(void* p, void (*deleter)(void*)) {
+    m_state->retire(detail::thread_record(m_state), p, deleter, !m_background.running());
+  }
+
+/**
+ * @brief Attempt to advance the epoch and delete all objects (from all threads) that
+ * are safe to delete.
+ *
+ * @return Number of objects deleted.
+ */
+  std::size_t collect() { return m_state->collect(); }
+
+  std::uint64_t epoch() const noexcept { return m_state->epoch(); }
+
+  reclamation_stats stats() const noexcept { return m_state->stats(); }
+
+private:
+  friend class epoch_guard;
+
+  std::shared_ptr<detail::epoch_state>              m_state;
+  detail::background_reclaimer<detail::epoch_state> m_background;
+};
+
+/**
+ * @brief RAII critical section for an @c epoch_domain; objects reachable while the
+ * guard is alive are not deleted. Guards may be nested.
+ */
+class epoch_guard {
+public:
+  explicit epoch_guard(epoch_domain& domain) :
+      m_state(domain.m_state.get()), m_record(detail::thread_record(domain.m_state)) {
+    m_state->enter(m_record);
+  }
+
+  ~epoch_guard() { m_state->leave(m_record); }
+
+  epoch_guard(const epoch_guard&) = delete;
+  epoch_guard& operator=(const epoch_guard&) = delete;
+
+private:
+  detail::epoch_state*  m_state;
+  detail::epoch_record& m_record;
+};
+
+/**
+ * @brief Hazard pointer reclamation domain.
+ */
+class hazard_domain {
+public:
+
+/**
+ * @brief Construct the domain.
+ *
+ * @param slots_per_thread Maximum number of simultaneously live @c hazard_guard
+ * objects per thread.
+ *
+ * @param scan_threshold Number of objects a thread retires before scanning the
+ * hazard pointers; pending objects per thread are bounded by this plus the total
+ * number of hazard pointers.
+ *
+ * @param background_interval If non-zero, reclamation is instead performed by a
+ * background thread at this interval.
+ */
+  explicit hazard_domain(std::size_t slots_per_thread = 4u, std::size_t scan_threshold = 64u,
+                         std::chrono::milliseconds background_interval = std::chrono::milliseconds { 0 }) :
+      m_state(std::make_shared<detail::hazard_state>(slots_per_thread, scan_threshold)),
+      m_background(m_state, background_interval) { }
+
+  hazard_domain(const hazard_domain&) = delete;
+  hazard_domain& operator=(const hazard_domain&) = delete;
+
+/**
+ * @brief Stop any background thread and delete all retired objects; no guards may
+ * be active.
+ */
+  ~hazard_domain() {
+    m_state->close();
+    m_background.stop();
+    m_state->drain();
+  }
+
+  template <typename T>
+  void retire(T* p) {
+    retire(static_cast<void*>(p), &detail::default_reclaim_deleter<T>);
+  }
+
+  void retire(void* p, void (*deleter)(void*)) {
+    m_state->retire(detail::thread_record(m_state), p, deleter, !m_background.running());
+  }
+
+/**
+ * @brief Delete all retired objects (from all threads) not currently protected.
+ *
+ * @return Number of objects deleted.
+ */
+  std::size_t collect() { return m_state->collect(); }
+
+  reclamation_stats stats() const noexcept { return m_state->stats(); }
+
+private:
+  friend class hazard_guard;
+
+  std::shared_ptr<detail::hazard_state>              m_state;
+  detail::background_reclaimer<detail::hazard_state> m_background;
+};
+
+/**
+ * @brief Owns one hazard pointer slot of the calling thread, protecting at most one
+ * object at a time.
+ *
+ * @throw std::length_error from the constructor if the thread already has
+ * @c slots_per_thread live guards for the domain.
+ */
+class hazard_guard {
+public:
+  explicit hazard_guard(hazard_domain& domain) :
+      m_state(domain.m_state.get()), m_record(detail::thread_record(domain.m_state)),
+      m_slot(m_state->acquire_slot(m_record)) { }
+
+  ~hazard_guard() { m_state->release_slot(m_record, m_slot); }
+
+  hazard_guard(const hazard_guard&) = delete;
+  hazard_guard& operator=(const hazard_guard&) = delete;
+
+/**
+ * @brief Load a pointer from an atomic and protect it, retrying until the published
+ * hazard pointer matches the atomic's value.
+ */
+  template <typename T>
+  T* protect(const std::atomic<T*>& src) noexcept {
+    T* p = src.load(std::memory_order_relaxed);
+    for (;;) {
+      m_slot.store(p, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      T* q = src.load(std::memory_order_acquire);
+      if (q == p) {
+        return p;
+      }
+      p = q;
+    }
+  }
+
+/**
+ * @brief Stop protecting the current pointer.
+ */
+  void reset() noexcept { m_slot.store(nullptr, std::memory_order_release); }
+
+private:
+  detail::hazard_state*  m_state;
+  detail::hazard_record& m_record;
+  std::atomic<void*>&    m_slot;
+};
+
+} // end namespace
+
+#endif
+
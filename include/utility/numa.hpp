@@ -0,0 +1,448 @@
+/** @file
+ *
+ * @brief Thread affinity, NUMA topology, and NUMA memory placement utilities.
+ *
+ * On multi-socket machines memory is attached to a specific socket (a NUMA node), and
+ * accessing memory on a remote node costs noticeably more than local access. Keeping a
+ * thread and the data it works on within the same node avoids cross-socket traffic.
+ *
+ * The utilities in this header:
+ *
+ * - Pin the calling thread (or any @c std::thread) to a CPU or a set of CPUs.
+ * - Read the NUMA topology (which CPUs belong to which node) from @c /sys.
+ * - Bind a memory range to a node (@c mbind) or set the calling thread's preferred
+ *   allocation node (@c set_mempolicy).
+ * - Create one instance of a type per NUMA node (@c numa_local), each allocated on its
+ *   own node, with access to the instance local to the calling thread.
+ *
+ * Thread pools and parallel loops place a worker next to its data by pinning the worker
+ * to the CPUs of a node (@c pin_current_thread_to_node) and allocating the data on the
+ * same node.
+ *
+ * The system calls are invoked directly, there is no dependency on @c libnuma. These
+ * facilities are Linux specific; on other platforms the topology reports a single node
+ * containing all hardware threads, and the pinning and binding functions do nothing and
+ * return @c false.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef NUMA_HPP_INCLUDED
+#define NUMA_HPP_INCLUDED
+
+#include <algorithm> // std::sort, std::unique
+#include <charconv> // std::from_chars
+#include <cstddef> // std::size_t
+#include <filesystem>
+#include <fstream>
+#include <iterator> // std::istreambuf_iterator
+#include <new> // std::align_val_t, placement new
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error> // std::errc, std::error_code
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace chops {
+
+namespace detail {
+
+// ids at or above this cannot be set in a cpu_set_t
+#if defined(__linux__)
+inline constexpr unsigned cpu_id_limit = CPU_SETSIZE;
+#else
+inline constexpr unsigned cpu_id_limit = 1024u;
+#endif
+
+}
+
+/**
+ * @brief Parse a Linux CPU (or node) list, such as "0-3,8,10-11", into a sorted
+ * vector of ids.
+ *
+ * Malformed entries, and entries with ids too large for an affinity mask
+ * (@c CPU_SETSIZE), are skipped.
+ */
+inline std::vector<unsigned> parse_cpu_list(std::string_view str) {
+  std::vector<unsigned> ids;
+  while (!str.empty()) {
+    auto pos = str.find(',');
+    auto item = str.substr(0, pos);
+    str = (pos == std::string_view::npos) ? std::string_view{} : str.substr(pos + 1u);
+    while (!item.empty() && (item.back() == '\n' || item.back() == ' ')) {
+      item.remove_suffix(1u);
+    }
+    unsigned first = 0u;
+    auto [p, ec] = std::from_chars(item.data(), item.data() + item.size(), first);
+    if (ec != std::errc{}) {
+      continue;
+    }
+    unsigned last = first;
+    if (p != item.data() + item.size()) {
+      if (*p != '-' ||
+          std::from_chars(p + 1, item.data() + item.size(), last).ec != std::errc{} || last < first) {
+        continue;
+      }
+    }
+    if (last >= detail::cpu_id_limit) {
+      continue;
+    }
+    for (auto i = first; i < last + 1u; ++i) {
+      ids.push_back(i);
+    }
+  }
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return ids;
+}
+
+/**
+ * @brief The NUMA nodes of the machine and the CPUs belonging to each.
+ */
+class numa_topology {
+public:
+
+/**
+ * @brief Read the topology from @c /sys, or from a different directory with the same
+ * layout (useful for testing).
+ *
+ * If no node information is found a single node containing all hardware threads
+ * is reported.
+ */
+  explicit numa_topology(const std::filesystem::path& node_dir = "/sys/devices/system/node") {
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(node_dir, ec)) {
+      auto name = entry.path().filename().string();
+      unsigned node = 0u;
+      if (name.rfind("node", 0u) != 0u ||
+          std::from_chars(name.data() + 4, name.data() + name.size(), node).ptr != name.data() + name.size()) {
+        continue;
+      }
+      std::ifstream ifs(entry.path() / "cpulist");
+      std::string contents { std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>() };
+      if (node >= m_node_cpus.size()) {
+        m_node_cpus.resize(node + 1u);
+      }
+      m_node_cpus[node] = parse_cpu_list(contents);
+    }
+    if (m_node_cpus.empty()) {
+      auto n = std::thread::hardware_concurrency();
+      m_node_cpus.emplace_back();
+      for (unsigned i = 0u; i < (n == 0u ? 1u : n); ++i) {
+        m_node_cpus.back().push_back(i);
+      }
+    }
+    for (unsigned node = 0u; node < m_node_cpus.size(); ++node) {
+      for (auto cpu : m_node_cpus[node]) {
+        if (cpu >= m_cpu_nodes.size()) {
+          m_cpu_nodes.resize(cpu + 1u, 0u);
+        }
+        m_cpu_nodes[cpu] = node;
+      }
+    }
+  }
+
+  std::size_t node_count() const noexcept { return m_node_cpus.size(); }
+
+/**
+ * @brief CPUs of a node; empty for a node id without CPUs (e.g. a memory-only node).
+ */
+  std::span<const unsigned> cpus_of_node(unsigned node) const noexcept {
+    return node < m_node_cpus.size() ? std::span<const unsigned>(m_node_cpus[node]) :
+                                       std::span<const unsigned>();
+  }
+
+/**
+ * @brief Node of a CPU, 0 if the CPU is unknown.
+ */
+  unsigned node_of_cpu(unsigned cpu) const noexcept {
+    return cpu < m_cpu_nodes.size() ? m_cpu_nodes[cpu] : 0u;
+  }
+
+private:
+  std::vector<std::vector<unsigned>> m_node_cpus;
+  std::vector<unsigned>              m_cpu_nodes;
+};
+
+/**
+ * @brief The topology of this machine, read once on first use.
+ */
+inline const numa_topology& system_numa_topology() {
+  static const numa_topology topo { };
+  return topo;
+}
+
+/**
+ * @brief CPU the calling thread is currently running on, 0 if unknown.
+ */
+inline unsigned current_cpu() noexcept {
+#if defined(__linux__)
+  int cpu = ::sched_getcpu();
+  return cpu < 0 ? 0u : static_cast<unsigned>(cpu);
+#else
+  return 0u;
+#endif
+}
+
+/**
+ * @brief NUMA node the calling thread is currently running on, 0 if unknown.
+ */
+inline unsigned current_numa_node() noexcept {
+#if defined(__linux__)
+  unsigned cpu = 0u;
+  unsigned node = 0u;
+  if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return node;
+  }
+#endif
+  return 0u;
+}
+
+/**
+ * @brief Pin a thread to a set of CPUs.
+ *
+ * A default constructed (not joinable) @c std::thread refers to the calling thread.
+ *
+ * @return @c true if the affinity was set.
+ */
+inline bool pin_thread(std::thread& thr, std::span<const unsigned> cpus) noexcept {
+#if defined(__linux__)
+  if (cpus.empty()) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (auto cpu : cpus) {
+    if (cpu >= CPU_SETSIZE) {
+      return false;
+    }
+    CPU_SET(cpu, &set);
+  }
+  auto hdl = thr.joinable() ? thr.native_handle() : ::pthread_self();
+  return ::pthread_setaffinity_np(hdl, sizeof(set), &set) == 0;
+#else
+  (void) thr;
+  (void) cpus;
+  return false;
+#endif
+}
+
+/**
+ * @brief Pin the calling thread to a set of CPUs.
+ */
+inline bool pin_current_thread(std::span<const unsigned> cpus) noexcept {
+  std::thread none;
+  return pin_thread(none, cpus);
+}
+
+/**
+ * @brief Pin the calling thread to a single CPU.
+ */
+inline bool pin_current_thread(unsigned cpu) noexcept {
+  return pin_current_thread(std::span<const unsigned>(&cpu, 1u));
+}
+
+/**
+ * @brief Pin the calling thread to all CPUs of a NUMA node.
+ */
+inline bool pin_current_thread_to_node(unsigned node) {
+  return pin_current_thread(system_numa_topology().cpus_of_node(node));
+}
+
+namespace detail {
+
+#if defined(__linux__)
+// values from <linux/mempolicy.h>
+inline constexpr int mpol_default = 0;
+inline constexpr int mpol_preferred = 1;
+inline constexpr int mpol_bind = 2;
+inline constexpr unsigned mpol_mf_move = (1u << 1u);
+
+inline constexpr std::size_t max_numa_nodes = 1024u;
+inline constexpr std::size_t bits_per_ulong = sizeof(unsigned long) * 8u;
+
+struct node_mask {
+  unsigned long bits[max_numa_nodes / bits_per_ulong] { };
+  explicit node_mask(unsigned node) noexcept {
+    bits[node / bits_per_ulong] = 1ul << (node % bits_per_ulong);
+  }
+  // the kernel reads one less than the max node value passed in
+  static constexpr unsigned long max_node = max_numa_nodes + 1u;
+};
+#endif
+
+inline std::size_t page_size() noexcept {
+#if defined(__linux__)
+  auto sz = ::sysconf(_SC_PAGESIZE);
+  return sz > 0 ? static_cast<std::size_t>(sz) : 4096u;
+#else
+  return 4096u;
+#endif
+}
+
+}
+
+/**
+ * @brief Bind a page aligned memory range to a NUMA node, moving any pages already
+ * touched.
+ *
+ * @return @c true if the policy was applied.
+ */
+inline bool bind_memory_to_node(void* addr, std::size_t len, unsigned node) noexcept {
+#if defined(__linux__)
+  if (node >= detail::max_numa_nodes) {
+    return false;
+  }
+  detail::node_mask mask(node);
+  return ::syscall(SYS_mbind, addr, len, detail::mpol_bind, mask.bits,
+                   detail::node_mask::max_node, detail::mpol_mf_move) == 0;
+#else
+  (void) addr;
+  (void) len;
+  (void) node;
+  return false;
+#endif
+}
+
+/**
+ * @brief Set the preferred node for future allocations made by the calling thread.
+ */
+inline bool set_preferred_numa_node(unsigned node) noexcept {
+#if defined(__linux__)
+  if (node >= detail::max_numa_nodes) {
+    return false;
+  }
+  detail::node_mask mask(node);
+  return ::syscall(SYS_set_mempolicy, detail::mpol_preferred, mask.bits,
+                   detail::node_mask::max_node) == 0;
+#else
+  (void) node;
+  return false;
+#endif
+}
+
+/**
+ * @brief Restore the default (local allocation) memory policy for the calling thread.
+ */
+inline bool reset_numa_memory_policy() noexcept {
+#if defined(__linux__)
+  return ::syscall(SYS_set_mempolicy, detail::mpol_default, nullptr, 0ul) == 0;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief One instance of @c T per NUMA node, each allocated in memory bound to its node.
+ *
+ * The instance for the node the calling thread is running on is accessed with
+ * @c local. This is useful for per-node pools, free lists, and statistics, where
+ * threads mostly touch the instance on their own node.
+ *
+ * @tparam T Type of each instance, which is neither copied nor moved.
+ */
+template <typename T>
+class numa_local {
+public:
+
+/**
+ * @brief Construct one instance per node of the system topology, each constructed
+ * from (copies of) the same arguments.
+ */
+  template <typename... Args>
+  explicit numa_local(const Args&... args) {
+    auto nodes = system_numa_topology().node_count();
+    m_ptrs.reserve(nodes);
+    try {
+      for (std::size_t node = 0u; node < nodes; ++node) {
+        void* mem = ::operator new(alloc_size(), align());
+        // binding before construction places the pages on first touch
+        bind_memory_to_node(mem, alloc_size(), static_cast<unsigned>(node));
+        try {
+          m_ptrs.push_back(new (mem) T(args...));
+        }
+        catch (...) {
+          ::operator delete(mem, align());
+          throw;
+        }
+      }
+    }
+    catch (...) {
+      destroy();
+      throw;
+    }
+  }
+
+  numa_local(const numa_local&) = delete;
+  numa_local& operator=(const numa_local&) = delete;
+
+  ~numa_local() { destroy(); }
+
+  std::size_t size() const noexcept { return m_ptrs.size(); }
+
+  T& operator[](std::size_t node) noexcept { return *m_ptrs[node]; }
+  const T& operator[](std::size_t node) const noexcept { return *m_ptrs[node]; }
+
+/**
+ * @brief Instance for the node the calling thread is currently running on.
+ */
+  T& local() noexcept { return *m_ptrs[local_index()]; }
+  const T& local() const noexcept { return *m_ptrs[local_index()]; }
+
+/**
+ * @brief Invoke a function object on each instance, in node order.
+ */
+  template <typename F>
+  void for_each(F&& func) {
+    for (auto* p : m_ptrs) {
+      func(*p);
+    }
+  }
+
+private:
+
+  std::size_t local_index() const noexcept {
+    auto node = current_numa_node();
+    return node < m_ptrs.size() ? node : 0u;
+  }
+
+  static std::align_val_t align() noexcept {
+    auto pg = detail::page_size();
+    return std::align_val_t { alignof(T) > pg ? alignof(T) : pg };
+  }
+
+  static std::size_t alloc_size() noexcept {
+    auto pg = detail::page_size();
+    return ((sizeof(T) + pg - 1u) / pg) * pg;
+  }
+
+  void destroy() noexcept {
+    for (auto* p : m_ptrs) {
+      p->~T();
+      ::operator delete(static_cast<void*>(p), align());
+    }
+    m_ptrs.clear();
+  }
+
+private:
+  std::vector<T*> m_ptrs;
+};
+
+} // end namespace
+
+#endif
+
@@ -0,0 +1,398 @@
+/** @file
+ *
+ * @brief Allocation-free formatting and parsing of numbers as text, directly into
+ * and out of @c std::byte buffers.
+ *
+ * Text protocols (FIX, HTTP headers, JSON fields, etc) need numbers formatted as
+ * characters. Formatting into a @c std::string and then copying into a @c std::byte
+ * buffer costs an allocation and a copy per field. The @c append_decimal, @c append_hex,
+ * and @c append_fixed functions format straight into the destination, either a
+ * @c std::span<std::byte> (returning the number of bytes written, or 0 if the value does
+ * not fit) or the end of a resizable byte container such as @c std::vector<std::byte>.
+ *
+ * Integer formatting uses a two-digits-at-a-time table and computes the output length
+ * up front from the bit width of the value, so each digit pair is written exactly once
+ * without reversing. Floating point fixed formatting uses @c std::to_chars.
+ *
+ * The @c parse_decimal, @c parse_hex, and @c parse_fixed functions convert an entire
+ * @c std::span<const std::byte> back to a number, returning an empty @c std::optional
+ * if the span is empty, contains any non-numeric character, or the value overflows
+ * the requested type. Decimal parsing converts eight digits at a time using SWAR
+ * ("SIMD within a register") arithmetic on a 64-bit word.
+ *
+ * @code
+ * std::array<std::byte, 32> buf;
+ * auto n = chops::append_decimal(buf, 1234567);
+ * auto val = chops::parse_decimal<int>(std::span<const std::byte>(buf.data(), n));
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef NUMERIC_TEXT_HPP_INCLUDED
+#define NUMERIC_TEXT_HPP_INCLUDED
+
+#include <array>
+#include <bit> // std::bit_width, std::endian
+#include <charconv> // std::to_chars, std::from_chars
+#include <concepts> // std::integral, std::unsigned_integral
+#include <cerrno> // errno, ERANGE
+#include <cstddef> // std::byte, std::size_t
+#include <cstdint> // std::uint64_t
+#include <cstdlib> // std::strtod
+#include <cstring> // std::memcpy
+#include <limits>
+#include <optional>
+#include <span>
+#include <system_error> // std::errc
+#include <type_traits> // std::make_unsigned_t
+
+#include "utility/cast_ptr_to.hpp"
+
+namespace chops {
+
+namespace detail {
+
+inline constexpr char digit_pairs[] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+inline constexpr char hex_digits[] = "0123456789abcdef";
+
+inline constexpr std::array<std::uint64_t, 20> powers_of_10 = [] {
+  std::array<std::uint64_t, 20> arr { };
+  std::uint64_t p = 1u;
+  for (auto& e : arr) {
+    e = p;
+    p *= 10u;
+  }
+  return arr;
+} ();
+
+// number of decimal digits, computed from the bit width with one table compare
+constexpr int decimal_digits(std::uint64_t val) noexcept {
+  int t = (static_cast<int>(std::bit_width(val | 1u)) * 1233) >> 12;
+  return t + ((val | 1u) >= powers_of_10[t]);
+}
+
+constexpr int hex_digit_count(std::uint64_t val) noexcept {
+  return (static_cast<int>(std::bit_width(val | 1u)) + 3) / 4;
+}
+
+// writes exactly ndigits characters ending at last
+inline void write_decimal(char* last, std::uint64_t val) noexcept {
+  while (val >= 100u) {
+    auto i = static_cast<std::size_t>(val % 100u) * 2u;
+    val /= 100u;
+    last -= 2;
+    std::memcpy(last, digit_pairs + i, 2u);
+  }
+  if (val >= 10u) {
+    last -= 2;
+    std::memcpy(last, digit_pairs + static_cast<std::size_t>(val) * 2u, 2u);
+  }
+  else {
+    *--last = static_cast<char>('0' + val);
+  }
+}
+
+template <std::integral T>
+constexpr std::size_t max_decimal_chars = std::numeric_limits<T>::digits10 + 2u;
+
+template <std::unsigned_integral T>
+constexpr std::size_t max_hex_chars = sizeof(T) * 2u;
+
+template <typename C>
+concept resizable_byte_buffer = requires (C c) {
+  c.resize(std::size_t{});
+  { c.data() } -> std::same_as<std::byte*>;
+  { c.size() } -> std::convertible_to<std::size_t>;
+};
+
+template <typename C, typename F>
+void append_to_container(C& buf, std::size_t max_sz, F&& func) {
+  auto old_sz = buf.size();
+  buf.resize(old_sz + max_sz);
+  auto n = func(std::span<std::byte>(buf.data() + old_sz, max_sz));
+  buf.resize(old_sz + n);
+}
+
+inline bool is_eight_digits(std::uint64_t v) noexcept {
+  return (((v & 0xF0F0F0F0F0F0F0F0ull) |
+          (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4u)) ==
+           0x3333333333333333ull);
+}
+
+// first character in the lowest byte, i.e. a little-endian load
+inline std::uint64_t parse_eight_digits(std::uint64_t v) noexcept {
+  v -= 0x3030303030303030ull;
+  v = (v * 10u) + (v >> 8u);
+  v = (((v & 0x000000FF000000FFull) * (100u + (1000000ull << 32u))) +
+       (((v >> 16u) & 0x000000FF000000FFull) * (1u + (10000ull << 32u)))) >> 32u;
+  return v;
+}
+
+// parse an unsigned magnitude from the whole of [first, last)
+inline std::optional<std::uint64_t> parse_magnitude(const char* first, const char* last) noexcept {
+  if (first == last) {
+    return { };
+  }
+  std::uint64_t val = 0u;
+  if constexpr (std::endian::native == std::endian::little) {
+    while (last - first >= 8) {
+      std::uint64_t chunk;
+      std::memcpy(&chunk, first, 8u);
+      if (!is_eight_digits(chunk)) {
+        return { };
+      }
+      chunk = parse_eight_digits(chunk);
+      if (val > (std::numeric_limits<std::uint64_t>::max() - chunk) / 100000000u) {
+        return { };
+      }
+      val = val * 100000000u + chunk;
+      first += 8;
+    }
+  }
+  for (; first != last; ++first) {
+    unsigned d = static_cast<unsigned char>(*first) - static_cast<unsigned>('0');
+    if (d > 9u) {
+      return { };
+    }
+    if (val > (std::numeric_limits<std::uint64_t>::max() - d) / 10u) {
+      return { };
+    }
+    val = val * 10u + d;
+  }
+  return { val };
+}
+
+} // end detail namespace
+
+/**
+ * @brief Format an integer in decimal into the front of a byte span.
+ *
+ * @return Number of bytes written, 0 if the span is too small.
+ */
+template <std::integral T>
+std::size_t append_decimal(std::span<std::byte> buf, T val) noexcept {
+  using U = std::make_unsigned_t<T>;
+  auto mag = static_cast<U>(val);
+  std::size_t neg = 0u;
+  if constexpr (std::is_signed_v<T>) {
+    if (val < 0) {
+      mag = static_cast<U>(U{0} - mag);
+      neg = 1u;
+    }
+  }
+  auto n = static_cast<std::size_t>(detail::decimal_digits(mag)) + neg;
+  if (n > buf.size()) {
+    return 0u;
+  }
+  char* p = cast_ptr_to<char>(buf.data());
+  if (neg) {
+    *p = '-';
+  }
+  detail::write_decimal(p + n, mag);
+  return n;
+}
+
+/**
+ * @brief Format an unsigned integer in lower case hexadecimal (no prefix) into the
+ * front of a byte span.
+ *
+ * @return Number of bytes written, 0 if the span is too small.
+ */
+template <std::unsigned_integral T>
+std::size_t append_hex(std::span<std::byte> buf, T val) noexcept {
+  auto n = static_cast<std::size_t>(detail::hex_digit_count(val));
+  if (n > buf.size()) {
+    return 0u;
+  }
+  char* last = cast_ptr_to<char>(buf.data()) + n;
+  std::uint64_t v = val;
+  do {
+    *--last = detail::hex_digits[v & 0xFu];
+    v >>= 4u;
+  } while (v != 0u);
+  return n;
+}
+
+/**
+ * @brief Format a @c double in fixed notation with the given number of digits after
+ * the decimal point into the front of a byte span.
+ *
+ * @return Number of bytes written, 0 if the span is too small.
+ */
+inline std::size_t append_fixed(std::span<std::byte> buf, double val, int precision) noexcept {
+  char* first = cast_ptr_to<char>(buf.data());
+  auto [ptr, ec] = std::to_chars(first, first + buf.size(), val, std::chars_format::fixed, precision);
+  return (ec == std::errc{}) ? static_cast<std::size_t>(ptr - first) : 0u;
+}
+
+/**
+ * @brief Append an integer in decimal to the end of a resizable byte container, such
+ * as @c std::vector<std::byte>.
+ */
+template <detail::resizable_byte_buffer C, std::integral T>
+void append_decimal(C& buf, T val) {
+  detail::append_to_container(buf, detail::max_decimal_chars<T>,
+      [val] (std::span<std::byte> sp) { return append_decimal(sp, val); } );
+}
+
+/**
+ * @brief Append an unsigned integer in hexadecimal to the end of a resizable byte container.
+ */
+template <detail::resizable_byte_buffer C, std::unsigned_integral T>
+void append_hex(C& buf, T val) {
+  detail::append_to_container(buf, detail::max_hex_chars<T>,
+      [val] (std::span<std::byte> sp) { return append_hex(sp, val); } );
+}
+
+/**
+ * @brief Append a @c double in fixed notation to the end of a resizable byte container.
+ */
+template <detail::resizable_byte_buffer C>
+void append_fixed(C& buf, double val, int precision) {
+  // covers all but very large magnitudes without a second attempt
+  constexpr std::size_t typical = 32u;
+  constexpr std::size_t largest = std::numeric_limits<double>::max_exponent10 + 3u;
+  auto prec = static_cast<std::size_t>(precision < 0 ? 0 : precision);
+  auto func = [val, precision] (std::span<std::byte> sp) { return append_fixed(sp, val, precision); };
+  auto old_sz = buf.size();
+  detail::append_to_container(buf, typical + prec, func);
+  if (buf.size() == old_sz) {
+    detail::append_to_container(buf, largest + prec, func);
+  }
+}
+
+/**
+ * @brief Parse the entire byte span as a decimal integer, with an optional leading
+ * '-' for signed types.
+ *
+ * @return The value, or an empty @c std::optional on a format error or overflow.
+ */
+template <std::integral T>
+std::optional<T> parse_decimal(std::span<const std::byte> buf) noexcept {
+  using U = std::make_unsigned_t<T>;
+  const char* first = cast_ptr_to<char>(buf.data());
+  const char* last = first + buf.size();
+  bool neg = false;
+  if constexpr (std::is_signed_v<T>) {
+    if (first != last && *first == '-') {
+      neg = true;
+      ++first;
+    }
+  }
+  auto mag = detail::parse_magnitude(first, last);
+  if (!mag) {
+    return { };
+  }
+  std::uint64_t limit = std::numeric_limits<U>::max();
+  if constexpr (std::is_signed_v<T>) {
+    limit = static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + (neg ? 1u : 0u);
+  }
+  if (*mag > limit) {
+    return { };
+  }
+  auto uval = static_cast<U>(*mag);
+  return { static_cast<T>(neg ? static_cast<U>(U{0} - uval) : uval) };
+}
+
+/**
+ * @brief Parse the entire byte span as an unsigned hexadecimal integer (upper or lower
+ * case, no prefix).
+ *
+ * @return The value, or an empty @c std::optional on a format error or overflow.
+ */
+template <std::unsigned_integral T>
+std::optional<T> parse_hex(std::span<const std::byte> buf) noexcept {
+  if (buf.empty()) {
+    return { };
+  }
+  // leading zeros do not count toward the digit limit
+  auto zeros = buf.size() - 1u;
+  for (std::size_t i = 0u; i < buf.size() - 1u; ++i) {
+    if (buf[i] != std::byte{'0'}) {
+      zeros = i;
+      break;
+    }
+  }
+  buf = buf.subspan(zeros);
+  if (buf.size() > detail::max_hex_chars<T>) {
+    return { };
+  }
+  T val = 0u;
+  for (auto b : buf) {
+    auto c = std::to_integer<unsigned>(b);
+    unsigned d;
+    if (c - '0' <= 9u) {
+      d = c - '0';
+    }
+    else if ((c | 0x20u) - 'a' <= 5u) {
+      d = (c | 0x20u) - 'a' + 10u;
+    }
+    else {
+      return { };
+    }
+    val = static_cast<T>((val << 4u) | d);
+  }
+  return { val };
+}
+
+/**
+ * @brief Parse the entire byte span as a @c double in fixed notation.
+ *
+ * @return The value, or an empty @c std::optional on a format error or if the value
+ * is out of range.
+ */
+inline std::optional<double> parse_fixed(std::span<const std::byte> buf) noexcept {
+  const char* first = cast_ptr_to<char>(buf.data());
+  const char* last = first + buf.size();
+  double val;
+#if defined(__cpp_lib_to_chars)
+  auto [ptr, ec] = std::from_chars(first, last, val, std::chars_format::fixed);
+  if (ec != std::errc{} || ptr != last) {
+    return { };
+  }
+#else
+  // standard libraries without floating point from_chars, e.g. older libc++
+  constexpr std::size_t max_chars = 512u;
+  if (buf.empty() || buf.size() >= max_chars) {
+    return { };
+  }
+  for (const char* p = first; p != last; ++p) {
+    if (!((*p >= '0' && *p <= '9') || *p == '.' || (*p == '-' && p == first))) {
+      return { };
+    }
+  }
+  char tmp[max_chars];
+  std::memcpy(tmp, first, buf.size());
+  tmp[buf.size()] = '\0';
+  char* end = nullptr;
+  errno = 0;
+  val = std::strtod(tmp, &end);
+  if (errno == ERANGE || end != tmp + buf.size()) {
+    return { };
+  }
+#endif
+  return { val };
+}
+
+} // end namespace
+
+#endif
+
@@ -0,0 +1,306 @@
+/** @file
+ *
+ * @brief Parallel @c for_each, @c transform, @c reduce and @c repeat over random
+ * access ranges, running on a @c thread_pool.
+ *
+ * The standard parallel algorithms depend on TBB with libstdc++ and give no control
+ * over the threads used. These algorithms run on a @c thread_pool (the process wide
+ * @c default_thread_pool unless one is passed), with the calling thread taking part,
+ * and share one scheduling core, @c par_for_chunks:
+ *
+ * - The index range is cut into chunks of @c grain elements (by default about eight
+ *   chunks per thread), and the chunks into one contiguous block per participating
+ *   thread. Since pool workers are numbered in NUMA node order, consecutive blocks go to
+ *   workers on the same node, so data first touched by a parallel loop is processed by
+ *   the same node in later loops with the same size.
+ * - Each thread works through its own block, then takes chunks from the other blocks
+ *   (nearest first), so uneven chunk costs are balanced.
+ * - The first exception thrown by the body is rethrown in the caller after all started
+ *   chunks finish; remaining chunks are skipped.
+ * - Calls from inside a pool task are safe: the calling worker processes the chunks
+ *   itself if no other worker is free.
+ *
+ * @c par_reduce keeps a partial result per chunk and combines them in chunk order, so
+ * the operation only needs to be associative (string concatenation works). The
+ * default grain depends on the thread count, so a floating point sum can differ
+ * between pools of different sizes; with @c par_options::deterministic the default
+ * grain depends only on the range size, and the result is identical for any number of
+ * threads.
+ *
+ * For cheap loop bodies, set the grain so each chunk runs for at least a few
+ * microseconds.
+ *
+ * @code
+ * chops::par_for_each(prices, [] (double& p) { p *= 1.01; } );
+ * auto total = chops::par_reduce(prices, 0.0, std::plus<> { }, { .deterministic = true } );
+ * chops::repeat_par(pool, 64, [&] (int i) { simulate(i); } );
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef PARALLEL_HPP_INCLUDED
+#define PARALLEL_HPP_INCLUDED
+
+#include <atomic>
+#include <cstddef> // std::size_t
+#include <exception> // std::exception_ptr
+#include <iterator> // std::random_access_iterator
+#include <memory> // std::make_shared
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <type_traits> // std::is_invocable_v
+#include <utility> // std::forward, std::move
+#include <vector>
+
+#include "utility/cache_padded.hpp"
+#include "utility/thread_pool.hpp"
+
+namespace chops {
+
+/**
+ * @brief Options for the parallel algorithms.
+ */
+struct par_options {
+/** @brief Elements per chunk, 0 for a default based on the range size. */
+  std::size_t grain { 0u };
+/** @brief Default grain independent of the thread count, so reductions give the same result on any pool. */
+  bool        deterministic { false };
+};
+
+namespace detail {
+
+struct par_state {
+  explicit par_state(std::size_t blocks, std::size_t chunks) :
+      m_next(blocks), m_block_end(blocks), m_remaining(chunks) {
+    for (std::size_t b = 0u; b < blocks; ++b) {
+      m_next[b]->store(b * chunks / blocks, std::memory_order_relaxed);
+      m_block_end[b] = (b + 1u) * chunks / blocks;
+    }
+  }
+
+  std::vector<cache_padded<std::atomic<std::size_t>>> m_next;
+  std::vector<std::size_t>                            m_block_end;
+  std::atomic<std::size_t>                            m_remaining;
+  std::atomic<bool>                                   m_failed { false };
+  std::mutex                                          m_error_mutex;
+  std::exception_ptr                                  m_error;
+};
+
+// claim and run chunks, own block first, then the following blocks
+template <typename F>
+void par_participate(par_state& st, std::size_t start_block, std::size_t participant,
+                     std::size_t n, std::size_t grain, F& body) {
+  auto blocks = st.m_block_end.size();
+  for (std::size_t k = 0u; k < blocks; ++k) {
+    auto b = (start_block + k) % blocks;
+    for (;;) {
+      auto c = st.m_next[b]->fetch_add(1u, std::memory_order_relaxed);
+      if (c >= st.m_block_end[b]) {
+        break;
+      }
+      if (!st.m_failed.load(std::memory_order_relaxed)) {
+        try {
+          auto first = c * grain;
+          body(first, (n - first < grain) ? n : first + grain, participant);
+        }
+        catch (...) {
+          std::lock_guard lk(st.m_error_mutex);
+          if (!st.m_error) {
+            st.m_error = std::current_exception();
+          }
+          st.m_failed.store(true, std::memory_order_relaxed);
+        }
+      }
+      if (st.m_remaining.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+        st.m_remaining.notify_all();
+      }
+    }
+  }
+}
+
+inline std::size_t par_grain(const thread_pool& pool, std::size_t n, const par_options& opts) noexcept {
+  if (opts.grain != 0u) {
+    return opts.grain;
+  }
+  auto chunks = opts.deterministic ? std::size_t{256u} : (pool.size() + 1u) * 8u;
+  auto g = (n + chunks - 1u) / chunks;
+  return g == 0u ? 1u : g;
+}
+
+}
+
+/**
+ * @brief Number of threads (pool workers plus the caller) that can take part in a
+ * parallel algorithm on @c pool; @c par_for_chunks participant indices are less than
+ * this.
+ */
+inline std::size_t par_participants(const thread_pool& pool) noexcept { return pool.size() + 1u; }
+
+/**
+ * @brief Scheduling core of the parallel algorithms: invoke @c body(begin, end,
+ * participant) for consecutive index chunks covering [0, n), in parallel.
+ *
+ * @c participant identifies the calling thread within this call, from 0 to
+ * @c par_participants(pool) - 1; no two concurrent invocations have the same value.
+ */
+template <typename F>
+void par_for_chunks(thread_pool& pool, std::size_t n, const par_options& opts, F&& body) {
+  if (n == 0u) {
+    return;
+  }
+  auto grain = detail::par_grain(pool, n, opts);
+  auto chunks = (n + grain - 1u) / grain;
+  auto blocks = (chunks < pool.size() + 1u) ? chunks : pool.size() + 1u;
+  if (blocks <= 1u) {
+    for (std::size_t first = 0u; first < n; first += grain) {
+      body(first, (n - first < grain) ? n : first + grain, std::size_t{0u});
+    }
+    return;
+  }
+  auto st = std::make_shared<detail::par_state>(blocks, chunks);
+  auto* bp = &body;
+  // block b + 1 goes to worker b; the body is only invoked for a claimed chunk, which
+  // cannot happen after the caller returns
+  for (std::size_t t = 1u; t < blocks; ++t) {
+    pool.post_to(t - 1u, [st, bp, n, grain, t, &pool, blocks] {
+        auto w = pool.current_worker();
+        auto start = (w == thread_pool::npos) ? t : (w + 1u) % blocks;
+        detail::par_participate(*st, start, t, n, grain, *bp);
+      } );
+  }
+  auto w = pool.current_worker();
+  detail::par_participate(*st, (w == thread_pool::npos) ? 0u : (w + 1u) % blocks, 0u, n, grain, body);
+  for (auto r = st->m_remaining.load(std::memory_order_acquire); r != 0u;
+       r = st->m_remaining.load(std::memory_order_acquire)) {
+    st->m_remaining.wait(r, std::memory_order_acquire);
+  }
+  if (st->m_error) {
+    std::rethrow_exception(st->m_error);
+  }
+}
+
+/**
+ * @brief Invoke @c f on each element of a random access range, in parallel.
+ */
+template <std::ranges::random_access_range R, typename F>
+void par_for_each(thread_pool& pool, R&& range, F f, const par_options& opts = par_options { }) {
+  auto first = std::ranges::begin(range);
+  auto n = static_cast<std::size_t>(std::ranges::distance(range));
+  par_for_chunks(pool, n, opts, [first, &f] (std::size_t b, std::size_t e, std::size_t) {
+      for (auto i = b; i < e; ++i) {
+        f(first[static_cast<std::ptrdiff_t>(i)]);
+      }
+    } );
+}
+
+template <std::ranges::random_access_range R, typename F>
+void par_for_each(R&& range, F f, const par_options& opts = par_options { }) {
+  par_for_each(default_thread_pool(), std::forward<R>(range), std::move(f), opts);
+}
+
+/**
+ * @brief Write @c f(x) for each element @c x of a random access range to the
+ * corresponding position of @c out, in parallel.
+ *
+ * @return Iterator past the last element written.
+ */
+template <std::ranges::random_access_range R, std::random_access_iterator Out, typename F>
+Out par_transform(thread_pool& pool, R&& range, Out out, F f, const par_options& opts = par_options { }) {
+  auto first = std::ranges::begin(range);
+  auto n = static_cast<std::size_t>(std::ranges::distance(range));
+  par_for_chunks(pool, n, opts, [first, out, &f] (std::size_t b, std::size_t e, std::size_t) {
+      for (auto i = b; i < e; ++i) {
+        auto d = static_cast<std::ptrdiff_t>(i);
+        out[d] = f(first[d]);
+      }
+    } );
+  return out + static_cast<std::ptrdiff_t>(n);
+}
+
+template <std::ranges::random_access_range R, std::random_access_iterator Out, typename F>
+Out par_transform(R&& range, Out out, F f, const par_options& opts = par_options { }) {
+  return par_transform(default_thread_pool(), std::forward<R>(range), out, std::move(f), opts);
+}
+
+/**
+ * @brief Combine @c init and the elements of a random access range with @c op, which
+ * must be associative, in parallel.
+ *
+ * Each chunk is reduced in element order, and the chunk results are combined with
+ * @c init in chunk order; with @c par_options::deterministic the chunking, and so the
+ * result, is the same for any thread count.
+ */
+template <std::ranges::random_access_range R, typename T, typename Op>
+T par_reduce(thread_pool& pool, R&& range, T init, Op op, const par_options& opts = par_options { }) {
+  auto first = std::ranges::begin(range);
+  auto n = static_cast<std::size_t>(std::ranges::distance(range));
+  if (n == 0u) {
+    return init;
+  }
+  auto grain = detail::par_grain(pool, n, opts);
+  std::vector<std::optional<T>> partials((n + grain - 1u) / grain);
+  auto fixed = opts;
+  fixed.grain = grain;
+  par_for_chunks(pool, n, fixed, [&] (std::size_t b, std::size_t e, std::size_t) {
+      auto& acc = partials[b / grain];
+      for (auto i = b; i < e; ++i) {
+        const auto& x = first[static_cast<std::ptrdiff_t>(i)];
+        if (acc) {
+          acc = op(std::move(*acc), x);
+        }
+        else {
+          acc.emplace(x);
+        }
+      }
+    } );
+  for (auto& p : partials) {
+    if (p) {
+      init = op(std::move(init), std::move(*p));
+    }
+  }
+  return init;
+}
+
+template <std::ranges::random_access_range R, typename T, typename Op>
+T par_reduce(R&& range, T init, Op op, const par_options& opts = par_options { }) {
+  return par_reduce(default_thread_pool(), std::forward<R>(range), std::move(init), std::move(op), opts);
+}
+
+/**
+ * @brief Invoke @c f @c n times in parallel, like @c repeat, passing the iteration
+ * index if @c f accepts an @c int.
+ */
+template <typename F>
+void repeat_par(thread_pool& pool, int n, F&& f, const par_options& opts = par_options { }) {
+  if (n <= 0) {
+    return;
+  }
+  par_for_chunks(pool, static_cast<std::size_t>(n), opts, [&f] (std::size_t b, std::size_t e, std::size_t) {
+      for (auto i = b; i < e; ++i) {
+        if constexpr (std::is_invocable_v<F&, int>) {
+          f(static_cast<int>(i));
+        }
+        else {
+          f();
+        }
+      }
+    } );
+}
+
+template <typename F>
+void repeat_par(int n, F&& f, const par_options& opts = par_options { }) {
+  repeat_par(default_thread_pool(), n, std::forward<F>(f), opts);
+}
+
+} // end namespace
+
+#endif
+
@@ -0,0 +1,397 @@
+/** @file
+ *
+ * @brief Fast, reproducible pseudo random number generators, bulk fill of byte
+ * buffers, and bounded integer and floating point helpers.
+ *
+ * @c std::mt19937 has 2.5 KB of state and a comparatively slow update, and
+ * @c std::uniform_int_distribution typically uses a division (or several) per value.
+ * For generating load and test data, where statistical quality matters but
+ * cryptographic strength does not, this header provides:
+ *
+ * - @c xoshiro256ss, the xoshiro256** generator by Blackman and Vigna: 32 bytes of
+ *   state, a period of 2^256 - 1, and @c jump / @c long_jump functions advancing the
+ *   state by 2^128 / 2^192 steps, so parallel streams are guaranteed not to overlap.
+ * - @c wyrand, by Wang Yi: 8 bytes of state and one 128-bit multiply per value, the
+ *   fastest generator here; @c discard is constant time, and @c jump advances by 2^48
+ *   steps, giving 65536 non-overlapping streams.
+ * - @c xoshiro256ss_x4, four interleaved xoshiro256** streams stepped together, which
+ *   fills large @c std::byte buffers using AVX2 when enabled (@c -mavx2 or
+ *   @c -march=native); the output is identical with or without AVX2.
+ * - @c uniform_below and @c uniform_int, bounded integers using Lemire's nearly
+ *   divisionless method (a multiply, with a division only on rare rejections), and
+ *   @c uniform_double, @c uniform_float, and @c uniform_real for floating point values.
+ *
+ * The generators meet the @c std::uniform_random_bit_generator requirements, so they can
+ * also be used with the standard distributions and algorithms such as @c std::shuffle.
+ * The output for a given seed is the same on every platform.
+ *
+ * @code
+ * chops::xoshiro256ss gen { 42u };
+ * auto die = chops::uniform_int(gen, 1, 6);
+ * std::vector<std::byte> payload(1024u);
+ * chops::fill_random(payload, gen);
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef RANDOM_HPP_INCLUDED
+#define RANDOM_HPP_INCLUDED
+
+#include <array>
+#include <bit> // std::rotl, std::endian
+#include <concepts> // std::integral, std::floating_point
+#include <cstddef> // std::byte, std::size_t
+#include <cstdint> // std::uint64_t
+#include <cstring> // std::memcpy
+#include <limits>
+#include <random> // std::uniform_random_bit_generator
+#include <span>
+#include <type_traits> // std::make_unsigned_t
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "utility/hash_bytes.hpp"
+
+namespace chops {
+
+/**
+ * @brief SplitMix64 step, used to expand a 64-bit seed into generator state.
+ */
+constexpr std::uint64_t splitmix64(std::uint64_t& state) noexcept {
+  auto z = (state += 0x9e3779b97f4a7c15u);
+  z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9u;
+  z = (z ^ (z >> 27u)) * 0x94d049bb133111ebu;
+  return z ^ (z >> 31u);
+}
+
+/**
+ * @brief The xoshiro256** generator.
+ */
+class xoshiro256ss {
+public:
+  using result_type = std::uint64_t;
+
+  static constexpr result_type min() noexcept { return 0u; }
+  static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+  constexpr xoshiro256ss() noexcept : xoshiro256ss(0u) { }
+
+/**
+ * @brief Seed the generator, expanding the seed with SplitMix64.
+ */
+  constexpr explicit xoshiro256ss(std::uint64_t seed) noexcept { this->seed(seed); }
+
+/**
+ * @brief Set the state directly; the state must not be all zero.
+ */
+  constexpr explicit xoshiro256ss(const std::array<std::uint64_t, 4u>& state) noexcept : m_s(state) { }
+
+  constexpr void seed(std::uint64_t seed) noexcept {
+    for (auto& s : m_s) {
+      s = splitmix64(seed);
+    }
+  }
+
+  constexpr result_type operator()() noexcept {
+    auto result = std::rotl(m_s[1] * 5u, 7) * 9u;
+    auto t = m_s[1] << 17u;
+    m_s[2] ^= m_s[0];
+    m_s[3] ^= m_s[1];
+    m_s[1] ^= m_s[2];
+    m_s[0] ^= m_s[3];
+    m_s[2] ^= t;
+    m_s[3] = std::rotl(m_s[3], 45);
+    return result;
+  }
+
+  constexpr void discard(unsigned long long n) noexcept {
+    for (; n != 0u; --n) {
+      (*this)();
+    }
+  }
+
+/**
+ * @brief Advance by 2^128 steps, e.g. to create up to 2^128 non-overlapping streams.
+ */
+  constexpr void jump() noexcept {
+    apply_jump({ 0x180ec6d33cfd0abau, 0xd5a61266f0c9392cu, 0xa9582618e03fc9aau, 0x39abdc4529b1661cu });
+  }
+
+/**
+ * @brief Advance by 2^192 steps, e.g. to separate groups of @c jump streams.
+ */
+  constexpr void long_jump() noexcept {
+    apply_jump({ 0x76e15d3efefdcbbfu, 0xc5004e441c522fb3u, 0x77710069854ee241u, 0x39109bb02acbe635u });
+  }
+
+  constexpr const std::array<std::uint64_t, 4u>& state() const noexcept { return m_s; }
+
+  friend constexpr bool operator==(const xoshiro256ss&, const xoshiro256ss&) = default;
+
+private:
+
+  constexpr void apply_jump(const std::array<std::uint64_t, 4u>& poly) noexcept {
+    std::array<std::uint64_t, 4u> acc { };
+    for (auto p : poly) {
+      for (unsigned b = 0u; b < 64u; ++b) {
+        if ((p >> b) & 1u) {
+          for (std::size_t i = 0u; i < acc.size(); ++i) {
+            acc[i] ^= m_s[i];
+          }
+        }
+        (*this)();
+      }
+    }
+    m_s = acc;
+  }
+
+private:
+  std::array<std::uint64_t, 4u> m_s { };
+};
+
+/**
+ * @brief The wyrand generator.
+ */
+class wyrand {
+public:
+  using result_type = std::uint64_t;
+
+  static constexpr result_type min() noexcept { return 0u; }
+  static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+  constexpr explicit wyrand(std::uint64_t seed = 0u) noexcept : m_s(seed) { }
+
+  constexpr void seed(std::uint64_t seed) noexcept { m_s = seed; }
+
+  result_type operator()() noexcept {
+    m_s += detail::wy_p0;
+    return mul_fold(m_s, m_s ^ detail::wy_p1);
+  }
+
+/**
+ * @brief Advance by @c n steps, in constant time.
+ */
+  constexpr void discard(unsigned long long n) noexcept { m_s += detail::wy_p0 * n; }
+
+/**
+ * @brief Advance by 2^48 steps.
+ */
+  constexpr void jump() noexcept { discard(1ull << 48u); }
+
+  constexpr std::uint64_t state() const noexcept { return m_s; }
+
+  friend constexpr bool operator==(const wyrand&, const wyrand&) = default;
+
+private:
+  std::uint64_t m_s;
+};
+
+/**
+ * @brief Four xoshiro256** streams, separated by @c jump, stepped together to fill
+ * buffers in bulk.
+ *
+ * Output word @c 4i+j is the i-th value of stream @c j.
+ */
+class xoshiro256ss_x4 {
+public:
+
+  explicit xoshiro256ss_x4(std::uint64_t seed = 0u) noexcept {
+    xoshiro256ss gen { seed };
+    for (std::size_t lane = 0u; lane < lanes; ++lane) {
+      for (std::size_t w = 0u; w < 4u; ++w) {
+        m_s[w][lane] = gen.state()[w];
+      }
+      gen.jump();
+    }
+  }
+
+/**
+ * @brief Fill a span of 64-bit words.
+ */
+  void fill(std::span<std::uint64_t> out) noexcept {
+    std::size_t i = 0u;
+    for (; i + lanes <= out.size(); i += lanes) {
+      next4(out.data() + i);
+    }
+    if (i < out.size()) {
+      std::array<std::uint64_t, lanes> tmp;
+      next4(tmp.data());
+      std::memcpy(out.data() + i, tmp.data(), (out.size() - i) * sizeof(std::uint64_t));
+    }
+  }
+
+/**
+ * @brief Fill a span of bytes, in the same byte order on every platform.
+ */
+  void fill(std::span<std::byte> out) noexcept {
+    constexpr std::size_t chunk = lanes * sizeof(std::uint64_t);
+    std::array<std::uint64_t, lanes> tmp;
+    std::size_t i = 0u;
+    for (; i + chunk <= out.size(); i += chunk) {
+      next4(tmp.data());
+      store_le(out.data() + i, tmp.data(), chunk);
+    }
+    if (i < out.size()) {
+      next4(tmp.data());
+      store_le(out.data() + i, tmp.data(), out.size() - i);
+    }
+  }
+
+private:
+  static constexpr std::size_t lanes = 4u;
+
+  void next4(std::uint64_t* out) noexcept {
+#if defined(__AVX2__)
+    auto ld = [this] (std::size_t w) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m_s[w].data())); };
+    auto rotl = [] (__m256i x, int k) { return _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - k)); };
+    __m256i s0 = ld(0u), s1 = ld(1u), s2 = ld(2u), s3 = ld(3u);
+    // multiplies by 5 and 9 as shift and add, AVX2 has no 64-bit multiply
+    auto m5 = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1);
+    auto r = rotl(m5, 7);
+    auto result = _mm256_add_epi64(_mm256_slli_epi64(r, 3), r);
+    auto t = _mm256_slli_epi64(s1, 17);
+    s2 = _mm256_xor_si256(s2, s0);
+    s3 = _mm256_xor_si256(s3, s1);
+    s1 = _mm256_xor_si256(s1, s2);
+    s0 = _mm256_xor_si256(s0, s3);
+    s2 = _mm256_xor_si256(s2, t);
+    s3 = rotl(s3, 45);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), result);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(m_s[0].data()), s0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(m_s[1].data()), s1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(m_s[2].data()), s2);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(m_s[3].data()), s3);
+#else
+    for (std::size_t j = 0u; j < lanes; ++j) {
+      out[j] = std::rotl(m_s[1][j] * 5u, 7) * 9u;
+      auto t = m_s[1][j] << 17u;
+      m_s[2][j] ^= m_s[0][j];
+      m_s[3][j] ^= m_s[1][j];
+      m_s[1][j] ^= m_s[2][j];
+      m_s[0][j] ^= m_s[3][j];
+      m_s[2][j] ^= t;
+      m_s[3][j] = std::rotl(m_s[3][j], 45);
+    }
+#endif
+  }
+
+  static void store_le(std::byte* dst, const std::uint64_t* src, std::size_t n) noexcept {
+    if constexpr (std::endian::native == std::endian::little) {
+      std::memcpy(dst, src, n);
+    }
+    else {
+      for (std::size_t i = 0u; i < n; ++i) {
+        dst[i] = static_cast<std::byte>(src[i / 8u] >> ((i % 8u) * 8u));
+      }
+    }
+  }
+
+private:
+  alignas(32) std::array<std::array<std::uint64_t, lanes>, 4u> m_s; // [state word][lane]
+};
+
+/**
+ * @brief A generator producing uniformly distributed 64-bit values.
+ */
+template <typename G>
+concept full_range_64_generator = std::uniform_random_bit_generator<G> &&
+    std::same_as<typename G::result_type, std::uint64_t> &&
+    G::min() == 0u && G::max() == std::numeric_limits<std::uint64_t>::max();
+
+/**
+ * @brief Fill a span of bytes from a 64-bit generator, a word at a time, in the same
+ * byte order on every platform.
+ */
+template <full_range_64_generator G>
+void fill_random(std::span<std::byte> out, G& gen) noexcept(noexcept(gen())) {
+  std::size_t i = 0u;
+  for (; i < out.size(); i += 8u) {
+    auto w = gen();
+    auto n = (out.size() - i < 8u) ? out.size() - i : 8u;
+    if constexpr (std::endian::native == std::endian::little) {
+      std::memcpy(out.data() + i, &w, n);
+    }
+    else {
+      for (std::size_t b = 0u; b < n; ++b) {
+        out[i + b] = static_cast<std::byte>(w >> (b * 8u));
+      }
+    }
+  }
+}
+
+/**
+ * @brief Fill a span of bytes using the four stream SIMD generator.
+ */
+inline void fill_random(std::span<std::byte> out, xoshiro256ss_x4& gen) noexcept {
+  gen.fill(out);
+}
+
+/**
+ * @brief Uniform integer in [0, bound), using Lemire's nearly divisionless method;
+ * @c bound must be greater than zero.
+ */
+template <full_range_64_generator G>
+std::uint64_t uniform_below(G& gen, std::uint64_t bound) noexcept(noexcept(gen())) {
+  std::uint64_t lo, hi;
+  detail::mul128(gen(), bound, lo, hi);
+  if (lo < bound) {
+    auto threshold = (0u - bound) % bound;
+    while (lo < threshold) {
+      detail::mul128(gen(), bound, lo, hi);
+    }
+  }
+  return hi;
+}
+
+/**
+ * @brief Uniform integer in the closed range [lo, hi].
+ */
+template <std::integral T, full_range_64_generator G>
+T uniform_int(G& gen, T lo, T hi) noexcept(noexcept(gen())) {
+  using U = std::make_unsigned_t<T>;
+  auto range = static_cast<std::uint64_t>(static_cast<U>(static_cast<U>(hi) - static_cast<U>(lo)));
+  if (range == std::numeric_limits<std::uint64_t>::max()) {
+    return static_cast<T>(gen());
+  }
+  return static_cast<T>(static_cast<U>(static_cast<U>(lo) + static_cast<U>(uniform_below(gen, range + 1u))));
+}
+
+/**
+ * @brief Uniform @c double in [0, 1), with 53 random bits.
+ */
+template <full_range_64_generator G>
+double uniform_double(G& gen) noexcept(noexcept(gen())) {
+  return static_cast<double>(gen() >> 11u) * 0x1.0p-53;
+}
+
+/**
+ * @brief Uniform @c float in [0, 1), with 24 random bits.
+ */
+template <full_range_64_generator G>
+float uniform_float(G& gen) noexcept(noexcept(gen())) {
+  return static_cast<float>(gen() >> 40u) * 0x1.0p-24f;
+}
+
+/**
+ * @brief Uniform floating point value in [lo, hi).
+ */
+template <std::floating_point T, full_range_64_generator G>
+T uniform_real(G& gen, T lo, T hi) noexcept(noexcept(gen())) {
+  auto u = static_cast<T>(uniform_double(gen));
+  auto r = lo + (hi - lo) * u;
+  return (r < hi) ? r : lo; // guard against rounding up to hi
+}
+
+} // end namespace
+
+#endif
+
@@ -0,0 +1,434 @@
+/** @file
+ *
+ * @brief Lock-free token bucket and sliding window rate limiters, and a sharded
+ * limiter keeping a separate limit for each of many keys.
+ *
+ * A rate limiter checked on every request must be cheap and must not serialize the
+ * calling threads. Each limiter here keeps its entire state in a single 64-bit word,
+ * updated with a compare and swap loop, and reads time with @c tsc_clock::ticks (the
+ * raw CPU time stamp counter), so an allowed request costs one counter read and one
+ * successful CAS.
+ *
+ * @c token_bucket holds up to @c burst tokens, refilled continuously at @c rate tokens
+ * per second; a request for @c n tokens is allowed if @c n tokens are available. The
+ * state word holds a 40-bit time stamp (in units of about a microsecond, derived from
+ * the counter by a shift) and a 24-bit token count with 8 fractional bits, so the
+ * burst size is limited to 65535 tokens. Refill time is only advanced by the time
+ * corresponding to the whole token fractions credited, so the rate is accurate no
+ * matter how frequently the bucket is checked.
+ *
+ * @c sliding_window_limiter allows at most @c limit requests in any window of the
+ * given length, estimated (as in the sliding window counter algorithm) from the count
+ * in the current fixed window plus the count in the previous window weighted by how
+ * much of it overlaps the sliding window. The state word holds a 24-bit window number
+ * and two 20-bit counts, so the limit is at most 1048575 requests per window.
+ *
+ * @c keyed_rate_limiter applies a limiter (a @c token_bucket or
+ * @c sliding_window_limiter prototype) independently to each key, such as a client
+ * id, storing only the 64-bit state word per key in a @c concurrent_hash_map. Keys
+ * are added on first use, and @c purge_idle removes keys whose state has returned to
+ * that of a new key (a full bucket, or no requests in the last two windows), so memory
+ * stays proportional to the number of recently active keys.
+ *
+ * All functions also accept an explicit counter value (from @c tsc_clock::ticks), to
+ * share one clock read between several limiters or to drive the limiters in tests.
+ * Time stamps are kept modulo the width of their field (a wrap period of 6 to 13 days
+ * for the token bucket, 2^24 windows for the sliding window). A counter value slightly
+ * older than the state (read before another thread updated it; up to 4 ms for the
+ * token bucket, one window for the sliding window) leaves the state unchanged, and any
+ * other gap counts as elapsed time, so a long idle period refills the bucket or resets
+ * the window. Only an idle period within that skew of a multiple of the wrap period is
+ * limited more strictly than necessary, until the next refill or window.
+ *
+ * @code
+ * chops::keyed_rate_limiter<std::uint64_t> limiter(chops::token_bucket(1000.0, 50.0));
+ * if (!limiter.try_acquire(client_id)) {
+ *   // reject the request
+ * }
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef RATE_LIMITER_HPP_INCLUDED
+#define RATE_LIMITER_HPP_INCLUDED
+
+#include <atomic>
+#include <bit> // std::bit_width
+#include <chrono>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <functional> // std::hash, std::equal_to
+#include <stdexcept> // std::invalid_argument
+
+#include "utility/concurrent_hash_map.hpp"
+#include "utility/tsc_clock.hpp"
+
+namespace chops {
+
+namespace detail {
+
+// token bucket state: time (40 bits) << 24 | tokens (24 bits, 8 fractional)
+class token_bucket_rule {
+public:
+  static constexpr int token_bits = 24;
+  static constexpr int frac_bits = 8;
+  static constexpr std::uint64_t token_mask = (std::uint64_t{1u} << token_bits) - 1u;
+  static constexpr std::uint64_t time_mask = (std::uint64_t{1u} << 40u) - 1u;
+  static constexpr double max_skew_seconds = 0.004;
+
+  token_bucket_rule(double rate, double burst) {
+    if (!(rate > 0.0) || !(burst >= 1.0) || burst * (1u << frac_bits) > static_cast<double>(token_mask)) {
+      throw std::invalid_argument("token_bucket rate or burst out of range");
+    }
+    // time unit of about a microsecond, a power of two number of counter ticks
+    auto freq = tsc_clock::frequency();
+    auto ticks_per_us = static_cast<std::uint64_t>(freq / 1e6);
+    m_shift = (ticks_per_us > 1u) ? static_cast<int>(std::bit_width(ticks_per_us)) - 1 : 0;
+    auto units_per_second = freq / static_cast<double>(std::uint64_t{1u} << m_shift);
+    auto refill = rate * (1u << frac_bits) / units_per_second * 4294967296.0;
+    if (refill >= 9.2e18) {
+      throw std::invalid_argument("token_bucket rate out of range");
+    }
+    m_refill = (refill < 1.0) ? 1u : static_cast<std::uint64_t>(refill);
+    m_capacity = static_cast<std::uint64_t>(burst * (1u << frac_bits));
+    m_fill_time = ((m_capacity << 32u) + m_refill - 1u) / m_refill;
+    auto skew = static_cast<std::uint64_t>(units_per_second * max_skew_seconds);
+    m_max_skew = (skew == 0u) ? 1u : skew;
+    m_rate = rate;
+  }
+
+  std::uint64_t initial_state(std::uint64_t ticks) const noexcept {
+    return (time_units(ticks) << token_bits) | m_capacity;
+  }
+
+  // refilled token units and time, given the state and current time
+  void refill(std::uint64_t state, std::uint64_t ticks, std::uint64_t& tokens, std::uint64_t& time) const noexcept {
+    time = state >> token_bits;
+    tokens = state & token_mask;
+    auto elapsed = (time_units(ticks) - time) & time_mask;
+    if (elapsed > time_mask - m_max_skew) {
+      return; // counter read shortly before another thread advanced the state
+    }
+    if (elapsed >= m_fill_time) {
+      tokens = m_capacity;
+      time = time_units(ticks);
+      return;
+    }
+    auto add = (elapsed * m_refill) >> 32u;
+    if (add == 0u) {
+      return;
+    }
+    tokens += add;
+    if (tokens >= m_capacity) {
+      tokens = m_capacity;
+      time = time_units(ticks);
+    }
+    else {
+      // advance only by the time the credited units took to accumulate
+      time = (time + ((add << 32u) + m_refill - 1u) / m_refill) & time_mask;
+    }
+  }
+
+  bool try_acquire(std::uint64_t& state, std::uint64_t ticks, std::uint32_t n) const noexcept {
+    std::uint64_t tokens, time;
+    refill(state, ticks, tokens, time);
+    auto need = std::uint64_t{n} << frac_bits;
+    if (tokens < need) {
+      return false;
+    }
+    state = (time << token_bits) | (tokens - need);
+    return true;
+  }
+
+  bool idle(std::uint64_t state, std::uint64_t ticks) const noexcept {
+    std::uint64_t tokens, time;
+    refill(state, ticks, tokens, time);
+    return tokens == m_capacity;
+  }
+
+  double available(std::uint64_t state, std::uint64_t ticks) const noexcept {
+    std::uint64_t tokens, time;
+    refill(state, ticks, tokens, time);
+    return static_cast<double>(tokens) / (1u << frac_bits);
+  }
+
+  double rate() const noexcept { return m_rate; }
+  double burst() const noexcept { return static_cast<double>(m_capacity) / (1u << frac_bits); }
+
+private:
+  std::uint64_t time_units(std::uint64_t ticks) const noexcept { return (ticks >> m_shift) & time_mask; }
+
+private:
+  int           m_shift;
+  std::uint64_t m_refill;    // token units per time unit, 32.32 fixed point
+  std::uint64_t m_capacity;  // token units
+  std::uint64_t m_fill_time; // time units to fill an empty bucket
+  std::uint64_t m_max_skew;  // time units an older counter value is tolerated
+  double        m_rate;
+};
+
+// sliding window state: window number (24 bits) << 40 | previous count << 20 | current count
+class sliding_window_rule {
+public:
+  static constexpr int count_bits = 20;
+  static constexpr std::uint64_t count_mask = (std::uint64_t{1u} << count_bits) - 1u;
+  static constexpr std::uint64_t window_mask = (std::uint64_t{1u} << 24u) - 1u;
+
+  sliding_window_rule(std::uint32_t limit, std::chrono::nanoseconds window) :
+      m_limit(limit),
+      m_window_ticks(static_cast<std::uint64_t>(static_cast<double>(window.count()) * tsc_clock::frequency() / 1e9)) {
+    if (limit == 0u || limit > count_mask || m_window_ticks == 0u) {
+      throw std::invalid_argument("sliding_window_limiter limit or window out of range");
+    }
+  }
+
+  std::uint64_t initial_state(std::uint64_t ticks) const noexcept {
+    return ((ticks / m_window_ticks) & window_mask) << 2u * count_bits;
+  }
+
+  // window number and previous and current counts as of the window containing ticks
+  std::uint64_t advance(std::uint64_t state, std::uint64_t ticks, std::uint64_t& prev, std::uint64_t& cur) const noexcept {
+    auto win = state >> 2u * count_bits;
+    auto diff = ((ticks / m_window_ticks) - win) & window_mask;
+    prev = (state >> count_bits) & count_mask;
+    cur = state & count_mask;
+    if (diff == 0u || diff == window_mask) {
+      return win; // same window, or counter read in the window before another thread advanced it
+    }
+    prev = (diff == 1u) ? cur : 0u;
+    cur = 0u;
+    return (win + diff) & window_mask;
+  }
+
+  bool try_acquire(std::uint64_t& state, std::uint64_t ticks, std::uint32_t n) const noexcept {
+    std::uint64_t prev, cur;
+    auto win = advance(state, ticks, prev, cur);
+    // previous window weighted by its overlap with the sliding window
+    auto overlap = 1.0 - static_cast<double>(ticks % m_window_ticks) / static_cast<double>(m_window_ticks);
+    if (static_cast<double>(prev) * overlap + static_cast<double>(cur + n) > static_cast<double>(m_limit)) {
+      return false;
+    }
+    state = (win << 2u * count_bits) | (prev << count_bits) | (cur + n);
+    return true;
+  }
+
+  bool idle(std::uint64_t state, std::uint64_t ticks) const noexcept {
+    std::uint64_t prev, cur;
+    advance(state, ticks, prev, cur);
+    return prev == 0u && cur == 0u;
+  }
+
+  std::uint32_t limit() const noexcept { return m_limit; }
+  std::uint64_t window_ticks() const noexcept { return m_window_ticks; }
+
+private:
+  std::uint32_t m_limit;
+  std::uint64_t m_window_ticks;
+};
+
+template <typename Rule>
+bool cas_acquire(std::atomic<std::uint64_t>& word, const Rule& rule, std::uint64_t ticks, std::uint32_t n) noexcept {
+  auto state = word.load(std::memory_order_relaxed);
+  for (;;) {
+    auto next = state;
+    if (!rule.try_acquire(next, ticks, n)) {
+      return false;
+    }
+    if (word.compare_exchange_weak(state, next, std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+}
+
+} // end detail namespace
+
+/**
+ * @brief Lock-free token bucket rate limiter.
+ */
+class token_bucket {
+public:
+  using rule_type = detail::token_bucket_rule;
+
+/**
+ * @brief Construct a full bucket.
+ *
+ * @param rate Tokens added per second.
+ *
+ * @param burst Maximum number of tokens, at least 1 and at most 65535.
+ *
+ * @throw std::invalid_argument if the rate or burst is out of range.
+ */
+  token_bucket(double rate, double burst) :
+      m_rule(rate, burst), m_state(m_rule.initial_state(tsc_clock::ticks())) { }
+
+  token_bucket(const token_bucket& other) :
+      m_rule(other.m_rule), m_state(other.m_state.load(std::memory_order_relaxed)) { }
+
+/**
+ * @brief Take @c n tokens if available.
+ *
+ * @return @c true if the tokens were taken, i.e. the request is allowed.
+ */
+  bool try_acquire(std::uint32_t n = 1u) noexcept { return try_acquire(n, tsc_clock::ticks()); }
+
+/**
+ * @brief Take @c n tokens if available at the time given by a @c tsc_clock::ticks
+ * value.
+ */
+  bool try_acquire(std::uint32_t n, std::uint64_t ticks) noexcept {
+    return detail::cas_acquire(m_state, m_rule, ticks, n);
+  }
+
+/**
+ * @brief Number of tokens currently available, including fractions.
+ */
+  double available() const noexcept {
+    return m_rule.available(m_state.load(std::memory_order_relaxed), tsc_clock::ticks());
+  }
+
+  double rate() const noexcept { return m_rule.rate(); }
+  double burst() const noexcept { return m_rule.burst(); }
+
+  const rule_type& rule() const noexcept { return m_rule; }
+
+private:
+  rule_type                  m_rule;
+  std::atomic<std::uint64_t> m_state;
+};
+
+/**
+ * @brief Lock-free sliding window counter rate limiter.
+ */
+class sliding_window_limiter {
+public:
+  using rule_type = detail::sliding_window_rule;
+
+/**
+ * @brief Construct the limiter, with no requests counted.
+ *
+ * @param limit Maximum number of requests in any window, at most 1048575.
+ *
+ * @param window Length of the sliding window.
+ *
+ * @throw std::invalid_argument if the limit or window is out of range.
+ */
+  sliding_window_limiter(std::uint32_t limit, std::chrono::nanoseconds window) :
+      m_rule(limit, window), m_state(m_rule.initial_state(tsc_clock::ticks())) { }
+
+  sliding_window_limiter(const sliding_window_limiter& other) :
+      m_rule(other.m_rule), m_state(other.m_state.load(std::memory_order_relaxed)) { }
+
+/**
+ * @brief Count @c n requests if they fit in the limit.
+ *
+ * @return @c true if the requests are allowed.
+ */
+  bool try_acquire(std::uint32_t n = 1u) noexcept { return try_acquire(n, tsc_clock::ticks()); }
+
+/**
+ * @brief Count @c n requests if they fit in the limit at the time given by a
+ * @c tsc_clock::ticks value.
+ */
+  bool try_acquire(std::uint32_t n, std::uint64_t ticks) noexcept {
+    return detail::cas_acquire(m_state, m_rule, ticks, n);
+  }
+
+  std::uint32_t limit() const noexcept { return m_rule.limit(); }
+
+/**
+ * @brief Window length in @c tsc_clock::ticks units.
+ */
+  std::uint64_t window_ticks() const noexcept { return m_rule.window_ticks(); }
+
+  const rule_type& rule() const noexcept { return m_rule; }
+
+private:
+  rule_type                  m_rule;
+  std::atomic<std::uint64_t> m_state;
+};
+
+/**
+ * @brief Rate limiter applying a separate limit to each key.
+ *
+ * @tparam Key Key type, such as a client id.
+ *
+ * @tparam Limiter @c token_bucket or @c sliding_window_limiter.
+ */
+template <typename Key, typename Limiter = token_bucket,
+          typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class keyed_rate_limiter {
+public:
+
+/**
+ * @brief Construct the limiter.
+ *
+ * @param prototype Limiter whose parameters are applied to each key (its current
+ * state is not used).
+ *
+ * @param num_shards Number of @c concurrent_hash_map shards, rounded up to a power
+ * of two; more shards reduce contention between threads using different keys.
+ *
+ * @param initial_capacity Initial number of keys per shard.
+ */
+  explicit keyed_rate_limiter(const Limiter& prototype, std::size_t num_shards = 64u,
+                              std::size_t initial_capacity = 256u) :
+      m_rule(prototype.rule()), m_map(num_shards, initial_capacity) { }
+
+/**
+ * @brief Apply the limiter for @c key to a request for @c n tokens (or @c n requests),
+ * adding the key if it is not present.
+ *
+ * @return @c true if the request is allowed.
+ */
+  bool try_acquire(const Key& key, std::uint32_t n = 1u) { return try_acquire(key, n, tsc_clock::ticks()); }
+
+  bool try_acquire(const Key& key, std::uint32_t n, std::uint64_t ticks) {
+    bool allowed = false;
+    auto func = [this, ticks, n, &allowed] (std::uint64_t& state) {
+      allowed = m_rule.try_acquire(state, ticks, n);
+    };
+    if (!m_map.update(key, func)) {
+      m_map.insert(key, m_rule.initial_state(ticks));
+      m_map.update(key, func);
+    }
+    return allowed;
+  }
+
+/**
+ * @brief Remove the keys whose state is the same as that of a new key.
+ *
+ * The shards are walked by the calling thread unless @c max_threads is greater than 1
+ * (see @c concurrent_hash_map::erase_if).
+ *
+ * @return Number of keys removed.
+ */
+  std::size_t purge_idle(std::size_t max_threads = 1u) {
+    return purge_idle(tsc_clock::ticks(), max_threads);
+  }
+
+  std::size_t purge_idle(std::uint64_t ticks, std::size_t max_threads) {
+    return m_map.erase_if([this, ticks] (const Key&, std::uint64_t state) {
+        return m_rule.idle(state, ticks); }, max_threads);
+  }
+
+/**
+ * @brief Number of keys present.
+ */
+  std::size_t size() const noexcept { return m_map.size(); }
+
+private:
+  typename Limiter::rule_type                             m_rule;
+  concurrent_hash_map<Key, std::uint64_t, Hash, KeyEqual> m_map;
+};
+
+} // end namespace
+
+#endif
+
@@ -0,0 +1,161 @@
+/** @file
+ *
+ * @brief A sequence lock for read-mostly snapshot data with a single writer.
+ *
+ * Reader-writer locks force readers to write the lock's cache line (to register as a
+ * reader), so many readers on different cores contend with each other even when there
+ * is no writer. A sequence lock ("seqlock") avoids this: readers never write shared
+ * memory. The writer increments a sequence counter (making it odd) before updating
+ * the data and increments it again (making it even) afterwards. A reader copies the
+ * data optimistically and retries if the sequence was odd or changed during the copy.
+ *
+ * The writer never waits for readers. Readers only retry while a write is in progress,
+ * which makes a seqlock a good fit for small snapshots (quotes, configuration, statistics)
+ * read by many threads and written by one.
+ *
+ * The data is restricted to trivially copyable types, since a reader may copy a torn
+ * (partially written) value before detecting the conflict and discarding it. To keep
+ * this race well defined (and clean under ThreadSanitizer, with no annotations needed),
+ * the value is stored as an array of 64-bit words accessed with relaxed atomic
+ * operations; the value's object representation is copied to and from the words through
+ * a @c std::byte pointer (@c cast_ptr_to).
+ *
+ * Writes must be serialized by the caller - there is one writer at a time.
+ *
+ * @code
+ * struct quote { double bid; double ask; std::uint64_t seq_num; };
+ * chops::seqlock<quote> latest;
+ * // writer thread
+ * latest.store(quote { 100.25, 100.50, 17u });
+ * // any reader thread
+ * auto q = latest.load();
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef SEQLOCK_HPP_INCLUDED
+#define SEQLOCK_HPP_INCLUDED
+
+#include <array>
+#include <atomic>
+#include <bit> // std::bit_cast
+#include <cstddef> // std::byte, std::size_t
+#include <cstdint> // std::uint64_t
+#include <cstring> // std::memcpy
+#include <optional>
+#include <type_traits> // std::is_trivially_copyable_v
+
+#include "utility/cast_ptr_to.hpp"
+#include "utility/cache_padded.hpp"
+#include "utility/spin_lock.hpp"
+
+namespace chops {
+
+namespace detail {
+
+// race tolerant copies of an object representation to and from relaxed atomic words
+template <std::size_t N>
+void store_words(std::array<std::atomic<std::uint64_t>, (N + 7u) / 8u>& words, const std::byte* src) noexcept {
+  for (std::size_t i = 0u; i < words.size(); ++i) {
+    std::uint64_t w = 0u;
+    std::memcpy(&w, src + i * 8u, (i * 8u + 8u <= N) ? 8u : N - i * 8u);
+    words[i].store(w, std::memory_order_relaxed);
+  }
+}
+
+template <std::size_t N>
+void load_words(const std::array<std::atomic<std::uint64_t>, (N + 7u) / 8u>& words, std::byte* dst) noexcept {
+  for (std::size_t i = 0u; i < words.size(); ++i) {
+    auto w = words[i].load(std::memory_order_relaxed);
+    std::memcpy(dst + i * 8u, &w, (i * 8u + 8u <= N) ? 8u : N - i * 8u);
+  }
+}
+
+}
+
+/**
+ * @brief Single writer, multiple reader sequence lock holding a value of type @c T.
+ *
+ * @tparam T A trivially copyable type.
+ */
+template <typename T>
+class alignas(cache_line_size) seqlock {
+  static_assert(std::is_trivially_copyable_v<T>, "seqlock requires a trivially copyable type");
+public:
+
+  seqlock() noexcept : seqlock(T{}) { }
+
+  explicit seqlock(const T& val) noexcept {
+    detail::store_words<sizeof(T)>(m_words, cast_ptr_to<std::byte>(&val));
+  }
+
+  seqlock(const seqlock&) = delete;
+  seqlock& operator=(const seqlock&) = delete;
+
+/**
+ * @brief Publish a new value; never blocks, but must not be called concurrently with
+ * another @c store.
+ */
+  void store(const T& val) noexcept {
+    auto seq = m_seq.load(std::memory_order_relaxed);
+    m_seq.store(seq + 1u, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    detail::store_words<sizeof(T)>(m_words, cast_ptr_to<std::byte>(&val));
+    m_seq.store(seq + 2u, std::memory_order_release);
+  }
+
+/**
+ * @brief Return a consistent copy of the value, retrying while a store is in progress.
+ */
+  T load() const noexcept {
+    for (;;) {
+      if (auto val = try_load(); val) {
+        return *val;
+      }
+      cpu_relax();
+    }
+  }
+
+/**
+ * @brief Make a single attempt to copy the value.
+ *
+ * @return The value, or an empty @c std::optional if a store was in progress.
+ */
+  std::optional<T> try_load() const noexcept {
+    auto seq1 = m_seq.load(std::memory_order_acquire);
+    if (seq1 & 1u) {
+      return { };
+    }
+    std::array<std::byte, sizeof(T)> buf;
+    detail::load_words<sizeof(T)>(m_words, buf.data());
+    std::atomic_thread_fence(std::memory_order_acquire);
+    auto seq2 = m_seq.load(std::memory_order_relaxed);
+    if (seq1 != seq2) {
+      return { };
+    }
+    return { std::bit_cast<T>(buf) };
+  }
+
+/**
+ * @brief Sequence number, incremented by two for each completed store.
+ */
+  std::uint64_t sequence() const noexcept {
+    return m_seq.load(std::memory_order_acquire);
+  }
+
+private:
+  std::atomic<std::uint64_t>                                  m_seq { 0u };
+  std::array<std::atomic<std::uint64_t>, (sizeof(T) + 7u) / 8u> m_words;
+};
+
+} // end namespace
+
+#endif
+
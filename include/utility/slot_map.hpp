@@ -0,0 +1,295 @@
+/** @file
+ *
+ * @brief A slot map, storing values contiguously and referring to them by 64-bit
+ * handles (index plus generation) that detect use after erase.
+ *
+ * Referring to long lived objects (connections, timers) by raw pointer leaves dangling
+ * pointers when the object goes away, and @c std::shared_ptr or @c std::weak_ptr costs
+ * an allocation and atomic reference counting on every copy. A @c slot_map<T> owns its
+ * values and hands out @c slot_handle values, which are plain 64-bit integers: a slot
+ * index and the generation of that slot when the value was inserted. Erasing a value
+ * increments its slot's generation, so every existing handle to it becomes stale, and a
+ * lookup with a stale handle returns @c nullptr instead of another value.
+ *
+ * Values are kept densely packed in a @c std::vector, so iteration (@c begin, @c end,
+ * @c values) is a plain vector traversal. A lookup is two array reads: the slot (index
+ * into the dense array and generation) and the value. Erase moves the last value into
+ * the erased value's position and pops the back (so it is constant time, and iteration
+ * order is not insertion order); freed slots are reused, last freed first.
+ *
+ * A @c slot_map is not thread safe. Pointers and references to values are invalidated
+ * by inserts (which may reallocate) and erases (which move the last value); handles
+ * stay valid until their value is erased.
+ *
+ * @code
+ * chops::slot_map<timer> timers;
+ * auto h = timers.insert(timer { deadline, callback });
+ * ...
+ * if (auto* t = timers.find(h)) { t->cancel(); }
+ * timers.erase(h);
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef SLOT_MAP_HPP_INCLUDED
+#define SLOT_MAP_HPP_INCLUDED
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <functional> // std::hash
+#include <limits>
+#include <span>
+#include <stdexcept> // std::out_of_range, std::length_error
+#include <utility> // std::move, std::forward
+#include <vector>
+
+namespace chops {
+
+/**
+ * @brief Handle to a value in a @c slot_map: a 32-bit slot index and a 32-bit
+ * generation, convertible to and from a single 64-bit value.
+ *
+ * A default constructed handle never refers to a value.
+ */
+class slot_handle {
+public:
+  constexpr slot_handle() noexcept = default;
+  constexpr slot_handle(std::uint32_t index, std::uint32_t generation) noexcept :
+    m_value((static_cast<std::uint64_t>(generation) << 32u) | index) { }
+
+  constexpr std::uint32_t index() const noexcept { return static_cast<std::uint32_t>(m_value); }
+  constexpr std::uint32_t generation() const noexcept { return static_cast<std::uint32_t>(m_value >> 32u); }
+
+/**
+ * @brief The handle as one 64-bit value, e.g. for a C API or a message field.
+ */
+  constexpr std::uint64_t value() const noexcept { return m_value; }
+  static constexpr slot_handle from_value(std::uint64_t v) noexcept { slot_handle h; h.m_value = v; return h; }
+
+/**
+ * @brief @c false for a default constructed handle (generation 0 is never used).
+ */
+  constexpr explicit operator bool() const noexcept { return generation() != 0u; }
+
+  friend constexpr bool operator==(slot_handle, slot_handle) noexcept = default;
+
+private:
+  std::uint64_t m_value { 0u };
+};
+
+/**
+ * @brief Container of values addressed by generational handles, with dense storage.
+ *
+ * @tparam T Value type, which must be move constructible and move assignable.
+ */
+template <typename T>
+class slot_map {
+public:
+  using value_type = T;
+  using handle = slot_handle;
+  using iterator = typename std::vector<T>::iterator;
+  using const_iterator = typename std::vector<T>::const_iterator;
+
+/**
+ * @brief Insert a value.
+ *
+ * @return Handle to the value.
+ *
+ * @throw std::length_error if all 2^32 - 1 slots are in use.
+ */
+  handle insert(const T& val) { return emplace(val); }
+  handle insert(T&& val) { return emplace(std::move(val)); }
+
+  template <typename... Args>
+  handle emplace(Args&&... args) {
+    if (m_free_head == npos) {
+      if (m_slots.size() == npos) {
+        throw std::length_error("slot_map: slot index space exhausted");
+      }
+      m_slots.push_back(slot { npos, 1u });
+      m_free_head = static_cast<std::uint32_t>(m_slots.size() - 1u);
+    }
+    auto idx = m_free_head;
+    m_dense_to_slot.push_back(idx);
+    try {
+      m_values.emplace_back(std::forward<Args>(args)...);
+    }
+    catch (...) {
+      m_dense_to_slot.pop_back();
+      throw;
+    }
+    m_free_head = m_slots[idx].m_pos;
+    m_slots[idx].m_pos = static_cast<std::uint32_t>(m_values.size() - 1u);
+    return handle(idx, m_slots[idx].m_generation);
+  }
+
+/**
+ * @brief Pointer to the value of a handle, or @c nullptr if the handle is stale or
+ * empty.
+ */
+  T* find(handle h) noexcept {
+    auto pos = position(h);
+    return pos == npos ? nullptr : &m_values[pos];
+  }
+
+  const T* find(handle h) const noexcept {
+    auto pos = position(h);
+    return pos == npos ? nullptr : &m_values[pos];
+  }
+
+  bool contains(handle h) const noexcept { return position(h) != npos; }
+
+/**
+ * @brief Value of a handle.
+ *
+ * @throw std::out_of_range if the handle is stale or empty.
+ */
+  T& at(handle h) {
+    auto p = find(h);
+    if (p == nullptr) {
+      throw std::out_of_range("slot_map: stale or empty handle");
+    }
+    return *p;
+  }
+
+  const T& at(handle h) const {
+    auto p = find(h);
+    if (p == nullptr) {
+      throw std::out_of_range("slot_map: stale or empty handle");
+    }
+    return *p;
+  }
+
+/**
+ * @brief Value of a handle known to be valid (unchecked).
+ */
+  T& operator[](handle h) noexcept { return m_values[m_slots[h.index()].m_pos]; }
+  const T& operator[](handle h) const noexcept { return m_values[m_slots[h.index()].m_pos]; }
+
+/**
+ * @brief Erase the value of a handle, invalidating all handles to it.
+ *
+ * @return @c false if the handle was already stale or empty.
+ */
+  bool erase(handle h) {
+    auto pos = position(h);
+    if (pos == npos) {
+      return false;
+    }
+    erase_at(pos);
+    return true;
+  }
+
+/**
+ * @brief Erase every value for which @c pred returns @c true.
+ *
+ * @return Number of values erased.
+ */
+  template <typename Pred>
+  std::size_t erase_if(Pred pred) {
+    std::size_t cnt = 0u;
+    for (std::size_t pos = 0u; pos < m_values.size(); ) {
+      if (pred(static_cast<const T&>(m_values[pos]))) {
+        erase_at(static_cast<std::uint32_t>(pos));
+        ++cnt;
+      }
+      else {
+        ++pos;
+      }
+    }
+    return cnt;
+  }
+
+/**
+ * @brief Erase all values; all existing handles become stale.
+ */
+  void clear() {
+    while (!m_values.empty()) {
+      erase_at(static_cast<std::uint32_t>(m_values.size() - 1u));
+    }
+  }
+
+/**
+ * @brief Handle of the value at a position in the dense storage, e.g. while iterating.
+ */
+  handle handle_at(std::size_t pos) const noexcept {
+    auto idx = m_dense_to_slot[pos];
+    return handle(idx, m_slots[idx].m_generation);
+  }
+
+  std::size_t size() const noexcept { return m_values.size(); }
+  bool empty() const noexcept { return m_values.empty(); }
+
+  void reserve(std::size_t n) {
+    m_values.reserve(n);
+    m_dense_to_slot.reserve(n);
+    m_slots.reserve(n);
+  }
+
+/**
+ * @brief The values, densely packed, in unspecified order.
+ */
+  std::span<T> values() noexcept { return m_values; }
+  std::span<const T> values() const noexcept { return m_values; }
+
+  iterator begin() noexcept { return m_values.begin(); }
+  iterator end() noexcept { return m_values.end(); }
+  const_iterator begin() const noexcept { return m_values.begin(); }
+  const_iterator end() const noexcept { return m_values.end(); }
+
+private:
+  static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+  struct slot {
+    std::uint32_t m_pos;        // index into m_values, or next free slot
+    std::uint32_t m_generation;
+  };
+
+  std::uint32_t position(handle h) const noexcept {
+    auto idx = h.index();
+    if (idx >= m_slots.size() || m_slots[idx].m_generation != h.generation() || !h) {
+      return npos;
+    }
+    return m_slots[idx].m_pos;
+  }
+
+  void erase_at(std::uint32_t pos) {
+    auto idx = m_dense_to_slot[pos];
+    auto last = static_cast<std::uint32_t>(m_values.size() - 1u);
+    if (pos != last) {
+      m_values[pos] = std::move(m_values[last]);
+      m_dense_to_slot[pos] = m_dense_to_slot[last];
+      m_slots[m_dense_to_slot[pos]].m_pos = pos;
+    }
+    m_values.pop_back();
+    m_dense_to_slot.pop_back();
+    auto& s = m_slots[idx];
+    // generation 0 is reserved for empty handles
+    s.m_generation = (s.m_generation == std::numeric_limits<std::uint32_t>::max()) ? 1u : s.m_generation + 1u;
+    s.m_pos = m_free_head;
+    m_free_head = idx;
+  }
+
+private:
+  std::vector<T>             m_values;
+  std::vector<std::uint32_t> m_dense_to_slot;
+  std::vector<slot>          m_slots;
+  std::uint32_t              m_free_head { npos };
+};
+
+} // end namespace
+
+template <>
+struct std::hash<chops::slot_handle> {
+  std::size_t operator()(chops::slot_handle h) const noexcept { return std::hash<std::uint64_t>{}(h.value()); }
+};
+
+#endif
+
@@ -0,0 +1,207 @@
+/** @file
+ *
+ * @brief A single producer, single consumer ring buffer of variable length byte
+ * records.
+ *
+ * A producer thread reserves space for a record directly in the ring, writes the record
+ * bytes in place, and commits it; a consumer thread reads committed records in place
+ * and releases them. There are no allocations, no locks, and no copies beyond the
+ * producer's own writes, which makes the ring suitable for handing data (e.g. log
+ * entries or messages) from a latency sensitive thread to a background thread.
+ *
+ * Each record is prefixed with a 4-byte length and padded to a multiple of 8 bytes. A
+ * record never wraps around the end of the buffer: if it does not fit in the space
+ * remaining before the end, a wrap marker is written and the record starts at the
+ * beginning. The producer and consumer positions are on separate cache lines, and each
+ * side caches the other's position so that it only reads the shared (contended) cache
+ * line when the cached value shows the ring as full or empty.
+ *
+ * @code
+ * chops::spsc_byte_ring ring(1u << 16u);
+ * // producer thread
+ * if (auto sp = ring.try_reserve(msg_size); sp.data() != nullptr) {
+ *   std::memcpy(sp.data(), msg, msg_size);
+ *   ring.commit();
+ * }
+ * // consumer thread
+ * ring.consume_all([] (std::span<const std::byte> rec) { ... } );
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef SPSC_BYTE_RING_HPP_INCLUDED
+#define SPSC_BYTE_RING_HPP_INCLUDED
+
+#include <atomic>
+#include <bit> // std::bit_ceil
+#include <cstddef> // std::byte, std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <cstring> // std::memcpy
+#include <memory> // std::unique_ptr
+#include <span>
+
+#include "utility/cache_padded.hpp"
+
+namespace chops {
+
+/**
+ * @brief Single producer, single consumer ring of byte records.
+ */
+class spsc_byte_ring {
+public:
+
+/**
+ * @brief Construct the ring.
+ *
+ * @param capacity Buffer size in bytes, rounded up to a power of two of at least 64.
+ */
+  explicit spsc_byte_ring(std::size_t capacity) :
+      m_capacity(std::bit_ceil(capacity < 64u ? std::size_t{64u} : capacity)),
+      m_buf(new std::byte[m_capacity]) { }
+
+  spsc_byte_ring(const spsc_byte_ring&) = delete;
+  spsc_byte_ring& operator=(const spsc_byte_ring&) = delete;
+
+  std::size_t capacity() const noexcept { return m_capacity; }
+
+/**
+ * @brief Largest record size that can be reserved.
+ */
+  std::size_t max_record_size() const noexcept { return m_capacity / 2u - header_size; }
+
+/**
+ * @brief Reserve space for a record; producer only.
+ *
+ * @return A span of @c size bytes to write the record into, or a default constructed
+ * span (with a null data pointer) if the ring is full or the size exceeds
+ * @c max_record_size. A reservation is completed by @c commit, or abandoned by not
+ * calling @c commit.
+ */
+  std::span<std::byte> try_reserve(std::size_t size) noexcept {
+    if (size > max_record_size()) {
+      return { };
+    }
+    auto& p = *m_producer;
+    auto total = padded(size + header_size);
+    auto pos = p.head;
+    auto idx = static_cast<std::size_t>(pos & (m_capacity - 1u));
+    auto to_end = m_capacity - idx;
+    auto needed = total + ((to_end < total) ? to_end : 0u);
+    if (needed > m_capacity - static_cast<std::size_t>(pos - p.cached_tail)) {
+      p.cached_tail = m_tail->load(std::memory_order_acquire);
+      if (needed > m_capacity - static_cast<std::size_t>(pos - p.cached_tail)) {
+        return { };
+      }
+    }
+    if (to_end < total) {
+      put_u32(m_buf.get() + idx, wrap_marker);
+      pos += to_end;
+      idx = 0u;
+    }
+    put_u32(m_buf.get() + idx, static_cast<std::uint32_t>(size));
+    p.pending = pos + total;
+    return { m_buf.get() + idx + header_size, size };
+  }
+
+/**
+ * @brief Publish the most recently reserved record to the consumer; producer only.
+ */
+  void commit() noexcept {
+    auto& p = *m_producer;
+    p.head = p.pending;
+    m_head->store(p.head, std::memory_order_release);
+  }
+
+/**
+ * @brief Reserve, write with @c func (passed the span), and commit a record.
+ *
+ * @return @c false if the ring was full.
+ */
+  template <typename F>
+  bool try_push(std::size_t size, F&& func) {
+    auto sp = try_reserve(size);
+    if (sp.data() == nullptr) {
+      return false;
+    }
+    func(sp);
+    commit();
+    return true;
+  }
+
+/**
+ * @brief Invoke @c func with each committed record, in order, then release them;
+ * consumer only.
+ *
+ * @return Number of records consumed.
+ */
+  template <typename F>
+  std::size_t consume_all(F&& func) {
+    auto& c = *m_consumer;
+    auto head = m_head->load(std::memory_order_acquire);
+    std::size_t n = 0u;
+    auto pos = c.tail;
+    while (pos != head) {
+      auto idx = static_cast<std::size_t>(pos & (m_capacity - 1u));
+      auto size = get_u32(m_buf.get() + idx);
+      if (size == wrap_marker) {
+        pos += m_capacity - idx;
+        continue;
+      }
+      func(std::span<const std::byte>(m_buf.get() + idx + header_size, size));
+      pos += padded(size + header_size);
+      ++n;
+    }
+    c.tail = pos;
+    m_tail->store(pos, std::memory_order_release);
+    return n;
+  }
+
+/**
+ * @brief @c true if there are no committed records; may be called from either side.
+ */
+  bool empty() const noexcept {
+    return m_head->load(std::memory_order_acquire) == m_tail->load(std::memory_order_acquire);
+  }
+
+private:
+  static constexpr std::size_t header_size = 4u;
+  static constexpr std::uint32_t wrap_marker = 0xffffffffu;
+
+  static std::size_t padded(std::size_t n) noexcept { return (n + 7u) & ~std::size_t{7u}; }
+
+  static void put_u32(std::byte* p, std::uint32_t v) noexcept { std::memcpy(p, &v, sizeof(v)); }
+  static std::uint32_t get_u32(const std::byte* p) noexcept {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+  }
+
+  struct producer_state {
+    std::uint64_t head { 0u };
+    std::uint64_t pending { 0u };
+    std::uint64_t cached_tail { 0u };
+  };
+  struct consumer_state {
+    std::uint64_t tail { 0u };
+  };
+
+private:
+  std::size_t                               m_capacity;
+  std::unique_ptr<std::byte[]>              m_buf;
+  cache_padded<std::atomic<std::uint64_t>>  m_head { 0u };
+  cache_padded<std::atomic<std::uint64_t>>  m_tail { 0u };
+  cache_padded<producer_state>              m_producer;
+  cache_padded<consumer_state>              m_consumer;
+};
+
+} // end namespace
+
+#endif
+
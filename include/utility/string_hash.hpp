@@ -0,0 +1,266 @@
+/** @file
+ *
+ * @brief Compile-time string hashing for @c switch statements on strings, and a
+ * compile-time perfect hash table for a fixed set of keywords.
+ *
+ * Parsers that compare an incoming token against dozens of literals one after another
+ * spend most of their time in failed comparisons. Two alternatives are provided:
+ *
+ * - @c switch on a hash of the token, with case labels computed at compile time by the
+ *   @c _hash literal (@c hash_bytes, a fast multiply and fold hash, usable in constant
+ *   expressions) or by @c fnv1a_64. Two labels with the same hash are a compile error
+ *   (duplicate case value), but a token that is not one of the labels may still collide
+ *   with one, so each case must confirm the token with one string comparison.
+ *
+ * - @c make_perfect_hash, which builds (at compile time) a table mapping each of a
+ *   fixed set of keywords to its index with no collisions, using the hash and displace
+ *   method: keys are grouped into buckets by one hash, and each bucket stores either
+ *   the seed of a second hash that places all of its keys in free slots, or (for single
+ *   key buckets) the slot itself. A lookup costs one or two hashes and one string
+ *   comparison. @c index_of gives the index of a keyword as a constant, for use as a
+ *   verified case label, and @c dispatch_keyword invokes one of a set of handlers by
+ *   keyword, in the same spirit as @c overloaded for variants.
+ *
+ * @code
+ * using namespace chops::literals;
+ * switch (chops::hash_bytes(token)) {
+ *   case "get"_hash: if (token == "get") { ... } break;
+ *   case "set"_hash: if (token == "set") { ... } break;
+ * }
+ *
+ * constexpr auto commands = chops::make_perfect_hash({ "get", "set", "delete" });
+ * switch (commands.find(token)) {
+ *   case commands.index_of("get"): ... break;
+ *   case commands.index_of("delete"): ... break;
+ *   default: ... // not a command
+ * }
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef STRING_HASH_HPP_INCLUDED
+#define STRING_HASH_HPP_INCLUDED
+
+#include <array>
+#include <bit> // std::bit_ceil
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t, std::int64_t
+#include <stdexcept> // std::invalid_argument
+#include <string_view>
+#include <utility> // std::forward
+
+#include "utility/hash_bytes.hpp"
+
+namespace chops {
+
+/**
+ * @brief 32-bit FNV-1a hash of a string.
+ */
+constexpr std::uint32_t fnv1a_32(std::string_view str) noexcept {
+  std::uint32_t h = 0x811c9dc5u;
+  for (unsigned char c : str) {
+    h ^= c;
+    h *= 0x01000193u;
+  }
+  return h;
+}
+
+/**
+ * @brief 64-bit FNV-1a hash of a string.
+ */
+constexpr std::uint64_t fnv1a_64(std::string_view str) noexcept {
+  std::uint64_t h = 0xcbf29ce484222325u;
+  for (unsigned char c : str) {
+    h ^= c;
+    h *= 0x100000001b3u;
+  }
+  return h;
+}
+
+namespace literals {
+
+/**
+ * @brief Compile-time @c hash_bytes of a string literal, e.g. @c "get"_hash.
+ */
+consteval std::uint64_t operator""_hash(const char* str, std::size_t len) noexcept {
+  return hash_bytes(std::string_view(str, len));
+}
+
+/**
+ * @brief Compile-time @c fnv1a_64 of a string literal.
+ */
+consteval std::uint64_t operator""_fnv1a(const char* str, std::size_t len) noexcept {
+  return fnv1a_64(std::string_view(str, len));
+}
+
+}
+
+/**
+ * @brief Collision free lookup table for a fixed set of @c N keywords, built by
+ * @c make_perfect_hash.
+ */
+template <std::size_t N>
+class perfect_hash_table {
+public:
+  static constexpr std::size_t npos = ~std::size_t{0u};
+  static constexpr std::size_t table_size = std::bit_ceil(N == 0u ? std::size_t{1u} : N);
+
+/**
+ * @brief Index (in the list passed to @c make_perfect_hash) of a token, or @c npos if
+ * the token is not a keyword.
+ */
+  constexpr std::size_t find(std::string_view token) const noexcept {
+    auto slot = slot_of(token);
+    return (m_keys[slot] == token && m_index[slot] != npos) ? m_index[slot] : npos;
+  }
+
+  constexpr bool contains(std::string_view token) const noexcept { return find(token) != npos; }
+
+/**
+ * @brief Index of a keyword; in a constant expression, a token that is not a keyword
+ * is a compile error, which makes the result safe to use as a @c case label.
+ */
+  constexpr std::size_t index_of(std::string_view keyword) const {
+    auto i = find(keyword);
+    if (i == npos) {
+      throw std::invalid_argument("perfect_hash_table: not a keyword");
+    }
+    return i;
+  }
+
+  constexpr std::string_view key(std::size_t index) const noexcept { return m_by_index[index]; }
+
+  constexpr std::size_t size() const noexcept { return N; }
+
+private:
+  template <std::size_t M>
+  friend constexpr perfect_hash_table<M> make_perfect_hash(const std::string_view (&)[M]);
+
+  static constexpr std::size_t mask = table_size - 1u;
+  static constexpr std::uint64_t bucket_seed = 0x9e3779b97f4a7c15u;
+
+  constexpr std::size_t slot_of(std::string_view token) const noexcept {
+    auto d = m_disp[static_cast<std::size_t>(hash_bytes(token, bucket_seed)) & mask];
+    return (d < 0) ? static_cast<std::size_t>(-d - 1) :
+                     static_cast<std::size_t>(hash_bytes(token, static_cast<std::uint64_t>(d))) & mask;
+  }
+
+private:
+  // per bucket: 0 empty, > 0 seed of the second hash, < 0 -(slot + 1)
+  std::array<std::int64_t, table_size>     m_disp { };
+  std::array<std::string_view, table_size> m_keys { };
+  std::array<std::size_t, table_size>      m_index { };
+  std::array<std::string_view, N>          m_by_index { };
+};
+
+/**
+ * @brief Build a @c perfect_hash_table from a braced list of keywords, normally in a
+ * constant expression.
+ *
+ * @throw std::invalid_argument (a compile error when constant evaluated) if the
+ * keywords contain duplicates.
+ */
+template <std::size_t N>
+constexpr perfect_hash_table<N> make_perfect_hash(const std::string_view (&keys)[N]) {
+  using table = perfect_hash_table<N>;
+  table t;
+  for (std::size_t i = 0u; i < N; ++i) {
+    t.m_by_index[i] = keys[i];
+  }
+  for (auto& i : t.m_index) {
+    i = table::npos;
+  }
+  // group the keys into buckets by the first hash
+  std::array<std::size_t, table::table_size> bucket_of { };
+  std::array<std::size_t, table::table_size> bucket_size { };
+  for (std::size_t i = 0u; i < N; ++i) {
+    for (std::size_t j = 0u; j < i; ++j) {
+      if (keys[i] == keys[j]) {
+        throw std::invalid_argument("make_perfect_hash: duplicate keyword");
+      }
+    }
+    bucket_of[i] = static_cast<std::size_t>(hash_bytes(keys[i], table::bucket_seed)) & table::mask;
+    ++bucket_size[bucket_of[i]];
+  }
+  std::array<bool, table::table_size> used { };
+  // place the largest buckets first, while most slots are free
+  for (std::size_t sz = N; sz > 1u; --sz) {
+    for (std::size_t b = 0u; b < table::table_size; ++b) {
+      if (bucket_size[b] != sz) {
+        continue;
+      }
+      for (std::uint64_t seed = 1u; ; ++seed) {
+        std::array<std::size_t, N> slots { };
+        std::size_t cnt = 0u;
+        bool ok = true;
+        for (std::size_t i = 0u; i < N && ok; ++i) {
+          if (bucket_of[i] != b) {
+            continue;
+          }
+          auto s = static_cast<std::size_t>(hash_bytes(keys[i], seed)) & table::mask;
+          ok = !used[s];
+          for (std::size_t k = 0u; k < cnt && ok; ++k) {
+            ok = slots[k] != s;
+          }
+          slots[cnt++] = s;
+        }
+        if (ok) {
+          cnt = 0u;
+          for (std::size_t i = 0u; i < N; ++i) {
+            if (bucket_of[i] == b) {
+              auto s = slots[cnt++];
+              used[s] = true;
+              t.m_keys[s] = keys[i];
+              t.m_index[s] = i;
+            }
+          }
+          t.m_disp[b] = static_cast<std::int64_t>(seed);
+          break;
+        }
+      }
+    }
+  }
+  // single key buckets take any free slot directly
+  std::size_t next_free = 0u;
+  for (std::size_t i = 0u; i < N; ++i) {
+    if (bucket_size[bucket_of[i]] == 1u) {
+      while (used[next_free]) {
+        ++next_free;
+      }
+      used[next_free] = true;
+      t.m_keys[next_free] = keys[i];
+      t.m_index[next_free] = i;
+      t.m_disp[bucket_of[i]] = -static_cast<std::int64_t>(next_free) - 1;
+    }
+  }
+  return t;
+}
+
+/**
+ * @brief Invoke the handler at the index of a keyword, e.g. one handler per command.
+ *
+ * @return @c false if the token is not a keyword (no handler is invoked).
+ */
+template <std::size_t N, typename... Fs>
+  requires (sizeof...(Fs) == N)
+bool dispatch_keyword(const perfect_hash_table<N>& table, std::string_view token, Fs&&... handlers) {
+  auto idx = table.find(token);
+  if (idx == table.npos) {
+    return false;
+  }
+  std::size_t i = 0u;
+  ((i++ == idx ? static_cast<void>(std::forward<Fs>(handlers)()) : static_cast<void>(0)), ...);
+  return true;
+}
+
+} // end namespace
+
+#endif
+
@@ -0,0 +1,215 @@
+/** @file
+ *
+ * @brief A concurrent string interning table, mapping strings to stable 32-bit
+ * symbol ids.
+ *
+ * Message routing code often hashes and compares the same small set of names (topics,
+ * field names, etc) over and over. Interning each name once produces a small integer
+ * id, after which comparisons are integer compares and the storage for duplicate names
+ * is shared.
+ *
+ * The table has a fixed maximum number of symbols, set at construction. Lookups
+ * (@c find and @c view) are lock-free - they probe an open addressing table of atomic
+ * slots and never block, even while another thread is interning a new string. Inserts
+ * (@c intern of a string not yet in the table) are serialized with a mutex, which is
+ * acceptable since the set of names is expected to stabilize quickly.
+ *
+ * String contents are copied into an arena of large blocks owned by the interner, so
+ * the @c std::string_view returned by @c view (and the characters it refers to) stays
+ * valid for the lifetime of the interner.
+ *
+ * All lookup functions take a @c std::string_view, so a @c std::string, string literal,
+ * or a view into a receive buffer can be used for lookup without creating a temporary
+ * @c std::string (heterogeneous lookup).
+ *
+ * @code
+ * chops::string_interner names;
+ * auto id = names.intern("market.quotes");
+ * // ... later, in the routing path
+ * if (auto sym = names.find(topic_view); sym && *sym == id) { ... }
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef STRING_INTERNER_HPP_INCLUDED
+#define STRING_INTERNER_HPP_INCLUDED
+
+#include <atomic>
+#include <bit> // std::bit_ceil
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <cstring> // std::memcpy
+#include <memory> // std::unique_ptr
+#include <mutex>
+#include <optional>
+#include <stdexcept> // std::length_error
+#include <string_view>
+#include <vector>
+
+namespace chops {
+
+using symbol_id = std::uint32_t;
+
+namespace detail {
+
+// FNV-1a, 64 bit
+inline std::uint64_t intern_hash(std::string_view str) noexcept {
+  std::uint64_t h = 0xcbf29ce484222325ull;
+  for (unsigned char c : str) {
+    h ^= c;
+    h *= 0x100000001b3ull;
+  }
+  return h;
+}
+
+}
+
+/**
+ * @brief Concurrent string to symbol id table with lock-free lookups.
+ *
+ * Symbol ids are assigned sequentially starting at 0, in order of interning.
+ */
+class string_interner {
+public:
+
+/**
+ * @brief Construct the interner, allocating the hash table and symbol table.
+ *
+ * @param max_symbols Maximum number of distinct strings that can be interned.
+ *
+ * @param block_size Size of each arena block used for string storage. Strings
+ * larger than this are given their own block.
+ */
+  explicit string_interner(std::uint32_t max_symbols = 4096u, std::size_t block_size = 16384u) :
+      m_mask(std::bit_ceil(std::size_t{max_symbols} * 2u) - 1u),
+      m_slots(std::make_unique<std::atomic<std::uint64_t>[]>(m_mask + 1u)),
+      m_views(std::make_unique<std::string_view[]>(max_symbols)),
+      m_max(max_symbols), m_block_size(block_size) { }
+
+  string_interner(const string_interner&) = delete;
+  string_interner& operator=(const string_interner&) = delete;
+
+/**
+ * @brief Return the symbol id for a string, adding it to the table if needed.
+ *
+ * @throw std::length_error if the string is not present and the table already
+ * holds @c max_symbols strings.
+ */
+  symbol_id intern(std::string_view str) {
+    const auto h = detail::intern_hash(str);
+    if (auto id = lookup(str, h); id) {
+      return *id;
+    }
+    std::lock_guard lk(m_mutex);
+    // another thread may have inserted the string while the lock was acquired
+    std::size_t idx = h & m_mask;
+    for (;;) {
+      auto slot = m_slots[idx].load(std::memory_order_acquire);
+      if (slot == 0u) {
+        break;
+      }
+      if (matches(slot, str, h)) {
+        return id_of(slot);
+      }
+      idx = (idx + 1u) & m_mask;
+    }
+    auto id = m_size.load(std::memory_order_relaxed);
+    if (id == m_max) {
+      throw std::length_error("string_interner capacity exceeded");
+    }
+    m_views[id] = store(str);
+    m_size.store(id + 1u, std::memory_order_release);
+    m_slots[idx].store(((h >> 32u) << 32u) | (std::uint64_t{id} + 1u), std::memory_order_release);
+    return id;
+  }
+
+/**
+ * @brief Lock-free lookup of a string, without inserting.
+ *
+ * @return The symbol id, or an empty @c std::optional if the string has not been
+ * interned.
+ */
+  std::optional<symbol_id> find(std::string_view str) const noexcept {
+    return lookup(str, detail::intern_hash(str));
+  }
+
+/**
+ * @brief Return the interned string for a symbol id; the view is valid for the
+ * lifetime of the interner.
+ *
+ * The id must have been returned from @c intern or @c find.
+ */
+  std::string_view view(symbol_id id) const noexcept {
+    return m_views[id];
+  }
+
+  std::uint32_t size() const noexcept { return m_size.load(std::memory_order_acquire); }
+  std::uint32_t capacity() const noexcept { return m_max; }
+
+private:
+
+  static symbol_id id_of(std::uint64_t slot) noexcept {
+    return static_cast<symbol_id>((slot & 0xffffffffull) - 1u);
+  }
+
+  bool matches(std::uint64_t slot, std::string_view str, std::uint64_t h) const noexcept {
+    return (slot >> 32u) == (h >> 32u) && m_views[id_of(slot)] == str;
+  }
+
+  std::optional<symbol_id> lookup(std::string_view str, std::uint64_t h) const noexcept {
+    std::size_t idx = h & m_mask;
+    for (;;) {
+      auto slot = m_slots[idx].load(std::memory_order_acquire);
+      if (slot == 0u) {
+        return { };
+      }
+      if (matches(slot, str, h)) {
+        return { id_of(slot) };
+      }
+      idx = (idx + 1u) & m_mask;
+    }
+  }
+
+  // called with the mutex held
+  std::string_view store(std::string_view str) {
+    if (str.size() > m_remaining) {
+      auto sz = (str.size() > m_block_size) ? str.size() : m_block_size;
+      m_blocks.push_back(std::make_unique<char[]>(sz));
+      m_next = m_blocks.back().get();
+      m_remaining = sz;
+    }
+    if (!str.empty()) {
+      std::memcpy(m_next, str.data(), str.size());
+    }
+    std::string_view ret { m_next, str.size() };
+    m_next += str.size();
+    m_remaining -= str.size();
+    return ret;
+  }
+
+private:
+  const std::size_t                             m_mask;
+  std::unique_ptr<std::atomic<std::uint64_t>[]> m_slots;
+  std::unique_ptr<std::string_view[]>           m_views;
+  const std::uint32_t                           m_max;
+  std::atomic<std::uint32_t>                    m_size { 0u };
+
+  // arena, only accessed with the mutex held
+  std::mutex                                    m_mutex;
+  std::vector<std::unique_ptr<char[]>>          m_blocks;
+  const std::size_t                             m_block_size;
+  char*                                         m_next { nullptr };
+  std::size_t                                   m_remaining { 0u };
+};
+
+} // end namespace
+
+#endif
+
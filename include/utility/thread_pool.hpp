@@ -0,0 +1,282 @@
+/** @file
+ *
+ * @brief A fixed size thread pool with per-worker task queues, work stealing, and
+ * optional placement of workers on NUMA nodes.
+ *
+ * Each worker has its own queue; @c post distributes tasks round robin and @c post_to
+ * targets a specific worker (e.g. the one on the NUMA node holding a task's data). An
+ * idle worker takes tasks from the other queues before sleeping, so targeting is a
+ * placement hint and never leaves a task waiting behind a busy worker.
+ *
+ * With NUMA pinning enabled (the default) on a machine with more than one node, workers
+ * are assigned to nodes in proportion to each node's CPU count, in node order (workers
+ * 0 .. k on node 0, and so on), and each worker is pinned to the CPUs of its node, so
+ * memory it first touches is allocated on that node. The parallel algorithms in
+ * @c parallel.hpp rely on this ordering to keep contiguous parts of a range on the same
+ * node. On a single node machine no pinning is done.
+ *
+ * The destructor runs all tasks already queued, then joins the workers. A task that
+ * throws terminates the program, as an exception escaping a @c std::thread would; use
+ * @c submit to get exceptions (and results) through a @c std::future.
+ *
+ * @code
+ * chops::thread_pool pool; // one worker per hardware thread
+ * auto fut = pool.submit([] { return compute(); } );
+ * pool.post([] { background_work(); } );
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef THREAD_POOL_HPP_INCLUDED
+#define THREAD_POOL_HPP_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef> // std::size_t
+#include <deque>
+#include <functional> // std::function
+#include <future>
+#include <memory> // std::make_shared, std::unique_ptr
+#include <mutex>
+#include <thread>
+#include <type_traits> // std::invoke_result_t
+#include <utility> // std::move, std::forward
+#include <vector>
+
+#include "utility/cache_padded.hpp"
+#include "utility/numa.hpp"
+
+namespace chops {
+
+class thread_pool;
+
+namespace detail {
+
+struct current_worker_info {
+  const thread_pool* m_pool { nullptr };
+  std::size_t        m_index { ~std::size_t{0u} };
+};
+
+}
+
+/**
+ * @brief Fixed size pool of worker threads.
+ */
+class thread_pool {
+public:
+  using task_type = std::function<void ()>;
+
+  static constexpr std::size_t npos = ~std::size_t{0u};
+
+/**
+ * @brief Start the workers.
+ *
+ * @param num_threads Number of workers, 0 for @c std::thread::hardware_concurrency.
+ *
+ * @param numa_pinning Pin workers to NUMA nodes when the machine has more than one.
+ */
+  explicit thread_pool(std::size_t num_threads = 0u, bool numa_pinning = true) {
+    if (num_threads == 0u) {
+      auto hw = std::thread::hardware_concurrency();
+      num_threads = (hw == 0u) ? 1u : hw;
+    }
+    m_nodes = assign_nodes(num_threads, numa_pinning);
+    m_pinned = numa_pinning && system_numa_topology().node_count() > 1u;
+    m_queues = std::vector<cache_padded<worker_queue>>(num_threads);
+    m_workers.reserve(num_threads);
+    try {
+      for (std::size_t i = 0u; i < num_threads; ++i) {
+        m_workers.emplace_back([this, i] { run(i); } );
+      }
+    }
+    catch (...) {
+      shutdown();
+      throw;
+    }
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+/**
+ * @brief Run the queued tasks, then stop and join the workers.
+ */
+  ~thread_pool() { shutdown(); }
+
+/**
+ * @brief Queue a task on the next worker in round robin order.
+ */
+  void post(task_type task) {
+    auto w = m_next.fetch_add(1u, std::memory_order_relaxed) % m_queues.size();
+    post_to(w, std::move(task));
+  }
+
+/**
+ * @brief Queue a task on a specific worker (other workers may take it if idle).
+ */
+  void post_to(std::size_t worker, task_type task) {
+    // counted before queueing, so a worker taking the task never sees a count of zero
+    m_pending.fetch_add(1u, std::memory_order_seq_cst);
+    try {
+      auto& q = *m_queues[worker % m_queues.size()];
+      std::lock_guard lk(q.m_mutex);
+      q.m_tasks.push_back(std::move(task));
+    }
+    catch (...) {
+      m_pending.fetch_sub(1u, std::memory_order_relaxed);
+      throw;
+    }
+    // a worker registers as a sleeper before checking the count, so either it sees
+    // the new task or it is seen here; the lock orders the notify after its wait starts
+    if (m_sleepers.load(std::memory_order_seq_cst) != 0u) {
+      { std::lock_guard lk(m_sleep_mutex); }
+      m_wake.notify_one();
+    }
+  }
+
+/**
+ * @brief Queue a function, returning a @c std::future for its result or exception.
+ */
+  template <typename F>
+  auto submit(F&& func) -> std::future<std::invoke_result_t<F>> {
+    using R = std::invoke_result_t<F>;
+    auto task = std::make_shared<std::packaged_task<R ()>>(std::forward<F>(func));
+    auto fut = task->get_future();
+    post([task] { (*task)(); } );
+    return fut;
+  }
+
+  std::size_t size() const noexcept { return m_workers.size(); }
+
+/**
+ * @brief NUMA node of a worker (0 without pinning).
+ */
+  unsigned worker_node(std::size_t worker) const noexcept { return m_nodes[worker]; }
+
+/**
+ * @brief Index of the calling thread in this pool, or @c npos if it is not one of this
+ * pool's workers.
+ */
+  std::size_t current_worker() const noexcept {
+    return (tl_current.m_pool == this) ? tl_current.m_index : npos;
+  }
+
+private:
+  struct worker_queue {
+    std::mutex            m_mutex;
+    std::deque<task_type> m_tasks;
+  };
+
+  static inline thread_local detail::current_worker_info tl_current { };
+
+  // nodes for each worker, contiguous groups in node order, sized by CPU count
+  static std::vector<unsigned> assign_nodes(std::size_t num_threads, bool numa_pinning) {
+    std::vector<unsigned> nodes(num_threads, 0u);
+    const auto& topo = system_numa_topology();
+    if (!numa_pinning || topo.node_count() < 2u) {
+      return nodes;
+    }
+    std::vector<unsigned> cpu_nodes;
+    for (unsigned n = 0u; n < topo.node_count(); ++n) {
+      for ([[maybe_unused]] auto cpu : topo.cpus_of_node(n)) {
+        cpu_nodes.push_back(n);
+      }
+    }
+    if (cpu_nodes.empty()) {
+      return nodes;
+    }
+    for (std::size_t i = 0u; i < num_threads; ++i) {
+      nodes[i] = cpu_nodes[i * cpu_nodes.size() / num_threads];
+    }
+    return nodes;
+  }
+
+  bool try_pop(std::size_t self, task_type& task) {
+    auto n = m_queues.size();
+    for (std::size_t k = 0u; k < n; ++k) {
+      auto& q = *m_queues[(self + k) % n];
+      std::lock_guard lk(q.m_mutex);
+      if (q.m_tasks.empty()) {
+        continue;
+      }
+      // own queue from the front, others from the back
+      if (k == 0u) {
+        task = std::move(q.m_tasks.front());
+        q.m_tasks.pop_front();
+      }
+      else {
+        task = std::move(q.m_tasks.back());
+        q.m_tasks.pop_back();
+      }
+      return true;
+    }
+    return false;
+  }
+
+  void run(std::size_t index) {
+    tl_current = detail::current_worker_info { this, index };
+    if (m_pinned) {
+      pin_current_thread_to_node(m_nodes[index]);
+    }
+    task_type task;
+    for (;;) {
+      if (try_pop(index, task)) {
+        m_pending.fetch_sub(1u, std::memory_order_relaxed);
+        task();
+        task = nullptr;
+        continue;
+      }
+      std::unique_lock lk(m_sleep_mutex);
+      m_sleepers.fetch_add(1u, std::memory_order_seq_cst);
+      m_wake.wait(lk, [this] { return m_pending.load(std::memory_order_seq_cst) > 0u || m_stop; } );
+      m_sleepers.fetch_sub(1u, std::memory_order_relaxed);
+      if (m_stop && m_pending.load(std::memory_order_relaxed) == 0u) {
+        return;
+      }
+    }
+  }
+
+  void shutdown() noexcept {
+    {
+      std::lock_guard lk(m_sleep_mutex);
+      m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& w : m_workers) {
+      w.join();
+    }
+    m_workers.clear();
+  }
+
+private:
+  std::vector<unsigned>                  m_nodes;
+  bool                                   m_pinned { false };
+  std::vector<cache_padded<worker_queue>> m_queues;
+  std::vector<std::thread>               m_workers;
+  std::atomic<std::size_t>               m_next { 0u };
+  std::mutex                             m_sleep_mutex;
+  std::condition_variable                m_wake;
+  std::atomic<std::size_t>               m_pending { 0u };  // queued tasks
+  std::atomic<std::size_t>               m_sleepers { 0u }; // workers waiting on m_wake
+  bool                                   m_stop { false };  // guarded by m_sleep_mutex
+};
+
+/**
+ * @brief Process wide pool with one worker per hardware thread, created on first use.
+ */
+inline thread_pool& default_thread_pool() {
+  static thread_pool pool;
+  return pool;
+}
+
+} // end namespace
+
+#endif
+
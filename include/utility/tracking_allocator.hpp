@@ -0,0 +1,547 @@
+/** @file
+ *
+ * @brief An allocator adapter and a @c std::pmr memory resource that record, per named
+ * tag, allocation counts, bytes, the live byte high-water mark, a size histogram, and
+ * optionally sampled allocation stack traces.
+ *
+ * Finding which containers in a service allocate the most (or churn the allocator by
+ * repeatedly growing and shrinking) usually needs a heap profiler run. Instead, a
+ * container can be given @c tracking_allocator<T, Tag> (for standard allocator aware
+ * containers) or a @c tracking_resource (for @c std::pmr containers), which forward to
+ * the underlying allocator or upstream resource and record each allocation under an
+ * @c allocation_tag, looked up by name.
+ *
+ * Recording is cheap: each thread updates its own counter block for the tag (single
+ * writer relaxed atomics, so no read-modify-write and no shared cache line), and live
+ * bytes are batched per thread and added to the tag's shared total when the thread's
+ * pending change reaches 64 KiB, or when the thread exits. The high-water mark is
+ * checked on each allocation against the shared total plus the allocating thread's
+ * pending bytes, so it is exact for a single thread and can be low by at most 64 KiB
+ * for each other thread.
+ *
+ * @c stats sums the blocks of a tag, @c allocation_report formats all tags as text, and
+ * @c set_stack_sampling(n) records a stack trace (Linux with glibc) for one allocation
+ * in @c n on each thread, aggregated by a hash of the return addresses, so the call
+ * sites responsible for most of a tag's bytes can be found.
+ *
+ * @code
+ * struct orders_tag { static constexpr const char* name = "orders"; };
+ * std::vector<order, chops::tracking_allocator<order, orders_tag>> orders;
+ *
+ * chops::tracking_resource res(chops::allocation_tag::get("parser"));
+ * std::pmr::vector<token> tokens(&res);
+ *
+ * std::cout << chops::allocation_report();
+ * @endcode
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef TRACKING_ALLOCATOR_HPP_INCLUDED
+#define TRACKING_ALLOCATOR_HPP_INCLUDED
+
+#include <algorithm> // std::sort
+#include <array>
+#include <atomic>
+#include <bit> // std::bit_width
+#include <cstddef> // std::size_t, std::byte
+#include <cstdint> // std::uint64_t, std::int64_t, std::uint32_t
+#include <memory> // std::allocator, std::allocator_traits, std::unique_ptr
+#include <memory_resource> // std::pmr::memory_resource
+#include <mutex>
+#include <span>
+#include <stdexcept> // std::length_error
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__) && defined(__GLIBC__)
+#include <execinfo.h> // backtrace
+#endif
+
+#include "utility/hash_bytes.hpp"
+
+namespace chops {
+
+/**
+ * @brief Maximum number of distinct allocation tags.
+ */
+inline constexpr std::size_t max_allocation_tags = 256u;
+
+/**
+ * @brief Number of allocation size histogram buckets: sizes up to 8 bytes, then each
+ * power of two up to 1 MiB, then larger.
+ */
+inline constexpr std::size_t allocation_histogram_size = 19u;
+
+/**
+ * @brief Histogram bucket of an allocation size.
+ */
+constexpr std::size_t allocation_bucket(std::size_t bytes) noexcept {
+  auto w = static_cast<std::size_t>(std::bit_width(bytes > 0u ? bytes - 1u : 0u));
+  w = (w < 3u) ? 3u : w;
+  return (w > 20u) ? allocation_histogram_size - 1u : w - 3u;
+}
+
+/**
+ * @brief Totals for one allocation tag.
+ */
+struct allocation_stats {
+  std::uint64_t allocations { 0u };
+  std::uint64_t deallocations { 0u };
+  std::uint64_t bytes_allocated { 0u };
+  std::uint64_t bytes_deallocated { 0u };
+/** @brief Bytes currently allocated. */
+  std::int64_t  live_bytes { 0 };
+/** @brief High-water mark of @c live_bytes (low by at most 64 KiB per other thread). */
+  std::int64_t  peak_live_bytes { 0 };
+/** @brief Allocation counts by size, see @c allocation_bucket. */
+  std::array<std::uint64_t, allocation_histogram_size> histogram { };
+};
+
+/**
+ * @brief Sampled allocation call stack, aggregated over all samples with the same
+ * return addresses.
+ */
+struct allocation_stack_sample {
+  std::uint64_t      hash { 0u };
+  std::uint64_t      count { 0u };
+  std::uint64_t      bytes { 0u };
+/** @brief Return addresses, innermost first (symbolize with @c backtrace_symbols). */
+  std::vector<void*> frames;
+};
+
+namespace detail {
+
+// per thread, per tag counters; only the owning thread writes
+struct alloc_block {
+  std::atomic<std::uint64_t> m_allocations { 0u };
+  std::atomic<std::uint64_t> m_deallocations { 0u };
+  std::atomic<std::uint64_t> m_bytes_allocated { 0u };
+  std::atomic<std::uint64_t> m_bytes_deallocated { 0u };
+  std::atomic<std::int64_t>  m_pending_live { 0 };
+  std::array<std::atomic<std::uint64_t>, allocation_histogram_size> m_histogram { };
+  std::atomic<bool>          m_in_use { false };
+  std::uint32_t              m_sample_countdown { 0u };
+
+  static void bump(std::atomic<std::uint64_t>& c, std::uint64_t n) noexcept {
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+};
+
+inline constexpr std::int64_t live_flush_bytes = 64 * 1024;
+
+}
+
+/**
+ * @brief Named set of allocation counters, shared by all allocators and resources
+ * recording under that name.
+ */
+class allocation_tag {
+public:
+
+/**
+ * @brief The tag with a name, created on first use; the reference stays valid for the
+ * life of the program.
+ *
+ * @throw std::length_error if @c max_allocation_tags tags already exist.
+ */
+  static allocation_tag& get(std::string_view name) {
+    auto& reg = registry();
+    std::lock_guard lk(reg.m_mutex);
+    auto n = reg.m_count.load(std::memory_order_relaxed);
+    for (std::size_t i = 0u; i < n; ++i) {
+      if (reg.m_tags[i]->m_name == name) {
+        return *reg.m_tags[i];
+      }
+    }
+    if (n == max_allocation_tags) {
+      throw std::length_error("allocation_tag: too many tags");
+    }
+    reg.m_tags[n].reset(new allocation_tag(name, n));
+    reg.m_count.store(n + 1u, std::memory_order_release);
+    return *reg.m_tags[n];
+  }
+
+/**
+ * @brief Invoke @c f with each tag, in order of creation.
+ */
+  template <typename F>
+  static void for_each(F&& f) {
+    auto& reg = registry();
+    auto n = reg.m_count.load(std::memory_order_acquire);
+    for (std::size_t i = 0u; i < n; ++i) {
+      f(static_cast<const allocation_tag&>(*reg.m_tags[i]));
+    }
+  }
+
+  allocation_tag(const allocation_tag&) = delete;
+  allocation_tag& operator=(const allocation_tag&) = delete;
+
+  const std::string& name() const noexcept { return m_name; }
+
+/**
+ * @brief Record an allocation of @c bytes by the calling thread.
+ */
+  void record_allocate(std::size_t bytes) {
+    auto* pb = local_block();
+    if (pb == nullptr) {
+      // the thread's blocks are gone (allocating from a thread_local destructor)
+      m_shared.m_allocations.fetch_add(1u, std::memory_order_relaxed);
+      m_shared.m_bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+      m_shared.m_histogram[allocation_bucket(bytes)].fetch_add(1u, std::memory_order_relaxed);
+      raise_peak(m_live.fetch_add(static_cast<std::int64_t>(bytes), std::memory_order_relaxed) +
+                 static_cast<std::int64_t>(bytes));
+      return;
+    }
+    auto& b = *pb;
+    detail::alloc_block::bump(b.m_allocations, 1u);
+    detail::alloc_block::bump(b.m_bytes_allocated, bytes);
+    detail::alloc_block::bump(b.m_histogram[allocation_bucket(bytes)], 1u);
+    add_live(b, static_cast<std::int64_t>(bytes));
+    auto every = m_sample_every.load(std::memory_order_relaxed);
+    if (every != 0u && ++b.m_sample_countdown >= every) {
+      b.m_sample_countdown = 0u;
+      sample_stack(bytes);
+    }
+  }
+
+/**
+ * @brief Record a deallocation of @c bytes by the calling thread.
+ */
+  void record_deallocate(std::size_t bytes) noexcept {
+    auto* b = try_local_block();
+    if (b == nullptr) {
+      // no block could be set up for this thread, or its blocks are gone (freeing from
+      // a thread_local or static destructor), so count in the shared block
+      m_shared.m_deallocations.fetch_add(1u, std::memory_order_relaxed);
+      m_shared.m_bytes_deallocated.fetch_add(bytes, std::memory_order_relaxed);
+      m_live.fetch_sub(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+      return;
+    }
+    detail::alloc_block::bump(b->m_deallocations, 1u);
+    detail::alloc_block::bump(b->m_bytes_deallocated, bytes);
+    add_live(*b, -static_cast<std::int64_t>(bytes));
+  }
+
+/**
+ * @brief Sum of the counters of all threads.
+ */
+  allocation_stats stats() const {
+    allocation_stats st;
+    std::int64_t pending = 0;
+    auto add = [&st, &pending] (const detail::alloc_block& b) {
+      st.allocations += b.m_allocations.load(std::memory_order_relaxed);
+      st.deallocations += b.m_deallocations.load(std::memory_order_relaxed);
+      st.bytes_allocated += b.m_bytes_allocated.load(std::memory_order_relaxed);
+      st.bytes_deallocated += b.m_bytes_deallocated.load(std::memory_order_relaxed);
+      pending += b.m_pending_live.load(std::memory_order_relaxed);
+      for (std::size_t i = 0u; i < allocation_histogram_size; ++i) {
+        st.histogram[i] += b.m_histogram[i].load(std::memory_order_relaxed);
+      }
+    };
+    add(m_shared);
+    std::lock_guard lk(m_blocks_mutex);
+    for (const auto& b : m_blocks) {
+      add(*b);
+    }
+    st.live_bytes = m_live.load(std::memory_order_relaxed) + pending;
+    auto peak = m_peak.load(std::memory_order_relaxed);
+    st.peak_live_bytes = (st.live_bytes > peak) ? st.live_bytes : peak;
+    return st;
+  }
+
+/**
+ * @brief Record the call stack of one allocation in @c every_n on each thread; 0
+ * disables sampling. Sampling is only available on Linux with glibc.
+ */
+  void set_stack_sampling(std::uint32_t every_n) noexcept { m_sample_every.store(every_n, std::memory_order_relaxed); }
+
+/**
+ * @brief Sampled call stacks, most bytes first.
+ */
+  std::vector<allocation_stack_sample> stack_samples() const {
+    std::vector<allocation_stack_sample> out;
+    {
+      std::lock_guard lk(m_samples_mutex);
+      for (const auto& [h, s] : m_samples) {
+        out.push_back(s);
+      }
+    }
+    std::sort(out.begin(), out.end(), [] (const auto& a, const auto& b) { return a.bytes > b.bytes; } );
+    return out;
+  }
+
+private:
+  struct tag_registry {
+    std::mutex                                                      m_mutex;
+    std::atomic<std::size_t>                                        m_count { 0u };
+    std::array<std::unique_ptr<allocation_tag>, max_allocation_tags> m_tags;
+  };
+
+  // the blocks used by one thread, returned for reuse (keeping their totals) when the
+  // thread exits
+  struct thread_blocks {
+    std::array<std::pair<allocation_tag*, detail::alloc_block*>, max_allocation_tags> m_blocks { };
+
+    ~thread_blocks() {
+      tl_blocks_destroyed = true;
+      for (auto [tag, b] : m_blocks) {
+        if (b != nullptr) {
+          tag->flush_live(*b);
+          b->m_in_use.store(false, std::memory_order_release);
+        }
+      }
+    }
+  };
+
+  allocation_tag(std::string_view name, std::size_t index) : m_name(name), m_index(index) { }
+
+  // never destroyed, so tags outlive containers with static storage duration
+  static tag_registry& registry() {
+    static auto& reg = *new tag_registry;
+    return reg;
+  }
+
+  // null once the calling thread's blocks have been returned at thread exit
+  detail::alloc_block* local_block() {
+    if (tl_blocks_destroyed) {
+      return nullptr;
+    }
+    thread_local thread_blocks tb;
+    auto& slot = tb.m_blocks[m_index];
+    if (slot.second == nullptr) {
+      slot = { this, acquire_block() };
+    }
+    return slot.second;
+  }
+
+  // also null if the thread has no block and one cannot be allocated
+  detail::alloc_block* try_local_block() noexcept {
+    try {
+      return local_block();
+    }
+    catch (...) {
+      return nullptr;
+    }
+  }
+
+  detail::alloc_block* acquire_block() {
+    std::lock_guard lk(m_blocks_mutex);
+    for (auto& b : m_blocks) {
+      bool expected = false;
+      if (b->m_in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        return b.get();
+      }
+    }
+    m_blocks.push_back(std::make_unique<detail::alloc_block>());
+    m_blocks.back()->m_in_use.store(true, std::memory_order_relaxed);
+    return m_blocks.back().get();
+  }
+
+  void add_live(detail::alloc_block& b, std::int64_t delta) noexcept {
+    auto pending = b.m_pending_live.load(std::memory_order_relaxed) + delta;
+    b.m_pending_live.store(pending, std::memory_order_relaxed);
+    if (pending >= detail::live_flush_bytes || pending <= -detail::live_flush_bytes) {
+      flush_live(b);
+    }
+    else if (delta > 0) {
+      // shared lines are only read here, and written on a new peak
+      raise_peak(m_live.load(std::memory_order_relaxed) + pending);
+    }
+  }
+
+  void flush_live(detail::alloc_block& b) noexcept {
+    auto pending = b.m_pending_live.exchange(0, std::memory_order_relaxed);
+    raise_peak(m_live.fetch_add(pending, std::memory_order_relaxed) + pending);
+  }
+
+  void raise_peak(std::int64_t live) noexcept {
+    auto peak = m_peak.load(std::memory_order_relaxed);
+    while (live > peak && !m_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) { }
+  }
+
+  void sample_stack([[maybe_unused]] std::size_t bytes) noexcept {
+#if defined(__linux__) && defined(__GLIBC__)
+    constexpr int max_frames = 32;
+    constexpr int skip = 2; // sample_stack and record_allocate
+    std::array<void*, max_frames> frames;
+    auto n = ::backtrace(frames.data(), max_frames);
+    if (n <= skip) {
+      return;
+    }
+    std::span<void* const> used(frames.data() + skip, static_cast<std::size_t>(n - skip));
+    auto h = hash_bytes(std::as_bytes(used));
+    try {
+      std::lock_guard lk(m_samples_mutex);
+      auto& s = m_samples[h];
+      if (s.count == 0u) {
+        s.hash = h;
+        s.frames.assign(used.begin(), used.end());
+      }
+      ++s.count;
+      s.bytes += bytes;
+    }
+    catch (...) {
+      // a sample is dropped if its entry cannot be allocated
+    }
+#endif
+  }
+
+private:
+  static inline thread_local bool                                    tl_blocks_destroyed { false };
+
+  std::string                                                        m_name;
+  std::size_t                                                        m_index;
+  std::atomic<std::int64_t>                                          m_live { 0 };
+  std::atomic<std::int64_t>                                          m_peak { 0 };
+  std::atomic<std::uint32_t>                                         m_sample_every { 0u };
+  mutable std::mutex                                                 m_blocks_mutex;
+  std::vector<std::unique_ptr<detail::alloc_block>>                  m_blocks;
+  detail::alloc_block                                                m_shared; // updated with atomic adds
+  mutable std::mutex                                                 m_samples_mutex;
+  std::unordered_map<std::uint64_t, allocation_stack_sample>         m_samples;
+};
+
+/**
+ * @brief Allocator recording its allocations under the tag named by @c Tag::name,
+ * forwarding to @c Alloc.
+ *
+ * @tparam Tag Type with a @c static @c constexpr @c const @c char* @c name member.
+ */
+template <typename T, typename Tag, typename Alloc = std::allocator<T>>
+class tracking_allocator {
+  using traits = std::allocator_traits<Alloc>;
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal = typename traits::is_always_equal;
+
+  template <typename U>
+  struct rebind {
+    using other = tracking_allocator<U, Tag, typename traits::template rebind_alloc<U>>;
+  };
+
+  tracking_allocator() = default;
+  explicit tracking_allocator(const Alloc& alloc) : m_alloc(alloc) { }
+
+  template <typename U, typename A>
+  tracking_allocator(const tracking_allocator<U, Tag, A>& rhs) noexcept : m_alloc(rhs.underlying()) { }
+
+  T* allocate(std::size_t n) {
+    auto p = traits::allocate(m_alloc, n);
+    try {
+      tag().record_allocate(n * sizeof(T));
+    }
+    catch (...) {
+      traits::deallocate(m_alloc, p, n);
+      throw;
+    }
+    return p;
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept {
+    tag().record_deallocate(n * sizeof(T));
+    traits::deallocate(m_alloc, p, n);
+  }
+
+  const Alloc& underlying() const noexcept { return m_alloc; }
+
+/**
+ * @brief The tag allocations are recorded under.
+ */
+  static allocation_tag& tag() {
+    static allocation_tag& t = allocation_tag::get(Tag::name);
+    return t;
+  }
+
+  template <typename U, typename A>
+  friend bool operator==(const tracking_allocator& a, const tracking_allocator<U, Tag, A>& b) noexcept {
+    return a.m_alloc == b.underlying();
+  }
+
+private:
+  [[no_unique_address]] Alloc m_alloc { };
+};
+
+/**
+ * @brief @c std::pmr memory resource recording its allocations under a tag,
+ * forwarding to an upstream resource.
+ */
+class tracking_resource : public std::pmr::memory_resource {
+public:
+  explicit tracking_resource(allocation_tag& tag,
+                             std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept :
+    m_tag(&tag), m_upstream(upstream) { }
+
+  allocation_tag& tag() const noexcept { return *m_tag; }
+  std::pmr::memory_resource* upstream() const noexcept { return m_upstream; }
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    auto p = m_upstream->allocate(bytes, align);
+    try {
+      m_tag->record_allocate(bytes);
+    }
+    catch (...) {
+      m_upstream->deallocate(p, bytes, align);
+      throw;
+    }
+    return p;
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+    m_tag->record_deallocate(bytes);
+    m_upstream->deallocate(p, bytes, align);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& rhs) const noexcept override { return this == &rhs; }
+
+private:
+  allocation_tag*            m_tag;
+  std::pmr::memory_resource* m_upstream;
+};
+
+/**
+ * @brief Text report of all allocation tags: one line of totals per tag, followed by
+ * its non-empty histogram buckets and its top sampled stacks.
+ */
+inline std::string allocation_report(std::size_t max_stacks = 5u) {
+  std::string out;
+  allocation_tag::for_each([&out, max_stacks] (const allocation_tag& tag) {
+      auto st = tag.stats();
+      out += tag.name() + ": allocs " + std::to_string(st.allocations) +
+             ", frees " + std::to_string(st.deallocations) +
+             ", bytes " + std::to_string(st.bytes_allocated) +
+             ", live " + std::to_string(st.live_bytes) +
+             ", peak " + std::to_string(st.peak_live_bytes) + "\n";
+      for (std::size_t i = 0u; i < allocation_histogram_size; ++i) {
+        if (st.histogram[i] == 0u) {
+          continue;
+        }
+        out += (i + 1u == allocation_histogram_size) ? std::string("  > 1048576") :
+                                                        "  <= " + std::to_string(std::size_t{8u} << i);
+        out += ": " + std::to_string(st.histogram[i]) + "\n";
+      }
+      auto samples = tag.stack_samples();
+      for (std::size_t i = 0u; i < samples.size() && i < max_stacks; ++i) {
+        out += "  stack " + std::to_string(samples[i].hash) + ": samples " + std::to_string(samples[i].count) +
+               ", bytes " + std::to_string(samples[i].bytes) + "\n";
+      }
+    } );
+  return out;
+}
+
+} // end namespace
+
+#endif
+
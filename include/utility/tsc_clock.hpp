@@ -0,0 +1,289 @@
+/** @file
+ *
+ * @brief A @c std::chrono compatible clock reading the CPU time stamp counter,
+ * calibrated against @c std::chrono::steady_clock.
+ *
+ * @c std::chrono::steady_clock::now typically calls @c clock_gettime, which is fast
+ * on bare metal (a vDSO call reading the TSC) but can cost tens or hundreds of
+ * nanoseconds in virtual machines whose clock source is not the TSC. @c tsc_clock reads
+ * the time stamp counter directly (@c rdtscp on x86, @c cntvct_el0 on ARM64) and
+ * converts ticks to nanoseconds with a 64 x 64-bit multiply.
+ *
+ * The counter frequency is calibrated against @c steady_clock when the clock is first
+ * used (taking about 10 milliseconds), and recalibrated about once a second by
+ * whichever thread first calls @c now after the interval expires, using the whole
+ * time since startup as the measurement window. Each recalibration keeps the clock
+ * continuous and slews its rate (by at most 500 parts per million) so that any
+ * accumulated offset from @c steady_clock is absorbed over the next interval. The
+ * conversion parameters are published through a @c seqlock, so readers never block.
+ *
+ * The TSC is only used if the processor reports an invariant TSC (constant rate, not
+ * stopped in sleep states) and supports @c rdtscp. Otherwise @c now falls back to
+ * @c clock_gettime(CLOCK_MONOTONIC_RAW) on Linux, or @c steady_clock elsewhere.
+ *
+ * For the lowest overhead, hot paths can record raw counter values with @c ticks and
+ * convert them later with @c from_ticks.
+ *
+ * @c tsc_clock meets the C++ @c Clock requirements (it is steady, with nanosecond
+ * resolution), so it works with @c std::chrono durations and time points. Its epoch is
+ * unspecified; time points are only meaningful relative to each other.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#ifndef TSC_CLOCK_HPP_INCLUDED
+#define TSC_CLOCK_HPP_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstdint> // std::uint64_t, std::int64_t
+#include <ratio> // std::nano
+
+#if defined(__x86_64__) || defined(__i386__)
+#if defined(__GNUC__) || defined(__clang__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+#if defined(__linux__)
+#include <time.h> // clock_gettime
+#endif
+
+#include "utility/hash_bytes.hpp"
+#include "utility/seqlock.hpp"
+
+namespace chops {
+
+namespace detail {
+
+// tick to nanosecond conversion: ns = base_ns + ((ticks - base_ticks) * mult) >> 32
+struct tsc_params {
+  std::uint64_t base_ticks;
+  std::int64_t  base_ns;
+  std::uint64_t mult;
+};
+
+// ticks may precede base_ticks if read just before another thread recalibrated
+inline std::int64_t tsc_convert(const tsc_params& p, std::uint64_t ticks) noexcept {
+  std::uint64_t lo, hi;
+  if (ticks >= p.base_ticks) {
+    mul128(ticks - p.base_ticks, p.mult, lo, hi);
+    return p.base_ns + static_cast<std::int64_t>((hi << 32u) | (lo >> 32u));
+  }
+  mul128(p.base_ticks - ticks, p.mult, lo, hi);
+  return p.base_ns - static_cast<std::int64_t>((hi << 32u) | (lo >> 32u));
+}
+
+inline std::int64_t steady_ns() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline std::int64_t monotonic_raw_ns() noexcept {
+#if defined(__linux__)
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+  return static_cast<std::int64_t>(ts.tv_sec) * 1000000000 + static_cast<std::int64_t>(ts.tv_nsec);
+#else
+  return steady_ns();
+#endif
+}
+
+// invariant TSC and rdtscp support, or a constant rate ARM64 virtual counter
+inline bool has_usable_tsc() noexcept {
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+  unsigned a = 0u, b = 0u, c = 0u, d = 0u;
+  if (__get_cpuid(0x80000000u, &a, &b, &c, &d) == 0 || a < 0x80000007u) {
+    return false;
+  }
+  __get_cpuid(0x80000001u, &a, &b, &c, &d);
+  bool rdtscp = (d & (1u << 27u)) != 0u;
+  __get_cpuid(0x80000007u, &a, &b, &c, &d);
+  return rdtscp && (d & (1u << 8u)) != 0u;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  int r[4];
+  __cpuid(r, static_cast<int>(0x80000000u));
+  if (static_cast<unsigned>(r[0]) < 0x80000007u) {
+    return false;
+  }
+  __cpuid(r, static_cast<int>(0x80000001u));
+  bool rdtscp = (static_cast<unsigned>(r[3]) & (1u << 27u)) != 0u;
+  __cpuid(r, static_cast<int>(0x80000007u));
+  return rdtscp && (static_cast<unsigned>(r[3]) & (1u << 8u)) != 0u;
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+  return true;
+#else
+  return false;
+#endif
+}
+
+// counter read, ordered after preceding instructions
+inline std::uint64_t read_tsc() noexcept {
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+  unsigned aux;
+  return __rdtscp(&aux);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  unsigned aux;
+  return __rdtscp(&aux);
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+  std::uint64_t v;
+  asm volatile("isb; mrs %0, cntvct_el0" : "=r"(v) :: "memory");
+  return v;
+#else
+  return 0u;
+#endif
+}
+
+class tsc_state {
+public:
+  static constexpr std::int64_t initial_window_ns = 10000000;      // 10 ms
+  static constexpr std::int64_t recalibration_ns = 1000000000;     // 1 s
+  static constexpr double max_slew = 0.0005;
+
+  tsc_state() : m_use_tsc(has_usable_tsc()) {
+    if (!m_use_tsc) {
+      return;
+    }
+    m_start_ns = steady_ns();
+    m_start_ticks = read_tsc();
+    std::int64_t now_ns;
+    std::uint64_t now_ticks;
+    do {
+      now_ns = steady_ns();
+      now_ticks = read_tsc();
+    } while (now_ns - m_start_ns < initial_window_ns);
+    auto ns_per_tick = static_cast<double>(now_ns - m_start_ns) / static_cast<double>(now_ticks - m_start_ticks);
+    publish(now_ticks, now_ns, ns_per_tick);
+  }
+
+  bool use_tsc() const noexcept { return m_use_tsc; }
+
+  std::int64_t now_ns() noexcept {
+    auto t = read_tsc();
+    auto p = m_params.load();
+    if (t > p.base_ticks && t - p.base_ticks > m_recal_ticks.load(std::memory_order_relaxed)) {
+      recalibrate();
+      p = m_params.load();
+    }
+    return tsc_convert(p, t);
+  }
+
+  std::int64_t convert(std::uint64_t ticks) const noexcept {
+    return tsc_convert(m_params.load(), ticks);
+  }
+
+  double ticks_per_second() const noexcept {
+    return 1e9 * 4294967296.0 / static_cast<double>(m_params.load().mult);
+  }
+
+  // only one thread recalibrates at a time, others keep the current parameters
+  void recalibrate() noexcept {
+    if (m_recalibrating.exchange(true, std::memory_order_acquire)) {
+      return;
+    }
+    auto s = steady_ns();
+    auto t = read_tsc();
+    auto p = m_params.load();
+    auto current = tsc_convert(p, t);
+    auto ns_per_tick = static_cast<double>(s - m_start_ns) / static_cast<double>(t - m_start_ticks);
+    // slew the rate so the offset from steady_clock is absorbed over the next interval
+    auto slew = static_cast<double>(s - current) / static_cast<double>(recalibration_ns);
+    slew = (slew > max_slew) ? max_slew : ((slew < -max_slew) ? -max_slew : slew);
+    publish(t, current, ns_per_tick * (1.0 + slew));
+    m_recalibrating.store(false, std::memory_order_release);
+  }
+
+private:
+
+  void publish(std::uint64_t ticks, std::int64_t ns, double ns_per_tick) noexcept {
+    m_params.store(tsc_params { ticks, ns, static_cast<std::uint64_t>(ns_per_tick * 4294967296.0) });
+    m_recal_ticks.store(static_cast<std::uint64_t>(static_cast<double>(recalibration_ns) / ns_per_tick),
+                        std::memory_order_relaxed);
+  }
+
+private:
+  bool                       m_use_tsc;
+  std::int64_t               m_start_ns { 0 };
+  std::uint64_t              m_start_ticks { 0u };
+  seqlock<tsc_params>        m_params { tsc_params { 0u, 0, 1u } };
+  std::atomic<std::uint64_t> m_recal_ticks { ~std::uint64_t{0u} };
+  std::atomic<bool>          m_recalibrating { false };
+};
+
+inline tsc_state& tsc_instance() {
+  static tsc_state state;
+  return state;
+}
+
+}
+
+/**
+ * @brief Steady clock based on the CPU time stamp counter.
+ */
+class tsc_clock {
+public:
+  using rep = std::int64_t;
+  using period = std::nano;
+  using duration = std::chrono::duration<rep, period>;
+  using time_point = std::chrono::time_point<tsc_clock>;
+  static constexpr bool is_steady = true;
+
+  static time_point now() noexcept {
+    auto& st = detail::tsc_instance();
+    return time_point(duration(st.use_tsc() ? st.now_ns() : detail::monotonic_raw_ns()));
+  }
+
+/**
+ * @brief Raw counter value, for deferred conversion with @c from_ticks; nanoseconds
+ * when the TSC is not used.
+ */
+  static std::uint64_t ticks() noexcept {
+    return detail::tsc_instance().use_tsc() ? detail::read_tsc() :
+                                              static_cast<std::uint64_t>(detail::monotonic_raw_ns());
+  }
+
+/**
+ * @brief Convert a raw counter value to a time point, using the current calibration.
+ */
+  static time_point from_ticks(std::uint64_t t) noexcept {
+    auto& st = detail::tsc_instance();
+    return time_point(duration(st.use_tsc() ? st.convert(t) : static_cast<std::int64_t>(t)));
+  }
+
+/**
+ * @brief @c true if the time stamp counter is used, @c false if using the fallback.
+ */
+  static bool uses_tsc() noexcept { return detail::tsc_instance().use_tsc(); }
+
+/**
+ * @brief Calibrated counter frequency, in ticks per second (1e9 for the fallback).
+ */
+  static double frequency() noexcept {
+    auto& st = detail::tsc_instance();
+    return st.use_tsc() ? st.ticks_per_second() : 1e9;
+  }
+
+/**
+ * @brief Recalibrate immediately, rather than waiting for the next periodic
+ * recalibration.
+ */
+  static void recalibrate() noexcept {
+    if (auto& st = detail::tsc_instance(); st.use_tsc()) {
+      st.recalibrate();
+    }
+  }
+};
+
+} // end namespace
+
+#endif
+
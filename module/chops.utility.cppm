@@ -0,0 +1,274 @@
+/** @file
+ *
+ * @brief C++20 module interface unit for the utility-rack utilities, module name
+ * @c chops.utility.
+ *
+ * The headers (and the standard library headers they use) are included in the global
+ * module fragment, so their contents are compiled once when the module is built and
+ * only the public @c chops names listed below are exported. A translation unit can then
+ * replace a set of @c #include "utility/..." directives with:
+ *
+ * @code
+ * import chops.utility;
+ * @endcode
+ *
+ * Implementation details (the @c chops::detail namespace) are not exported. Preprocessor
+ * macros cannot be exported from a module, so code using the @c CHOPS_FWD and
+ * @c CHOPS_FWD_CAPTURE macros must still include @c utility/forward_capture.hpp.
+ *
+ * The module is built when the @c UTILITY_RACK_BUILD_MODULE CMake option is set (CMake
+ * 3.28 or later and a compiler with module dependency scanning support are required).
+ * Standard library names are not re-exported; consumers use @c import @c std (see the
+ * @c UTILITY_RACK_MODULE_IMPORT_STD option) or standard headers as before.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+module;
+
+#include "utility/async_file_reader.hpp"
+#include "utility/binary_logger.hpp"
+#include "utility/bitmap.hpp"
+#include "utility/bloom_filter.hpp"
+#include "utility/byte_array.hpp"
+#include "utility/cache_padded.hpp"
+#include "utility/cast_ptr_to.hpp"
+#include "utility/chunked_vector.hpp"
+#include "utility/circular_buffer.hpp"
+#include "utility/coalescing_writer.hpp"
+#include "utility/compressed_bitmap.hpp"
+#include "utility/concurrent_hash_map.hpp"
+#include "utility/d_ary_heap.hpp"
+#include "utility/erase_where.hpp"
+#include "utility/forward_capture.hpp"
+#include "utility/hash_bytes.hpp"
+#include "utility/intrusive_list.hpp"
+#include "utility/memory_reclaim.hpp"
+#include "utility/numa.hpp"
+#include "utility/numeric_text.hpp"
+#include "utility/overloaded.hpp"
+#include "utility/parallel.hpp"
+#include "utility/random.hpp"
+#include "utility/rate_limiter.hpp"
+#include "utility/repeat.hpp"
+#include "utility/seqlock.hpp"
+#include "utility/slot_map.hpp"
+#include "utility/spin_lock.hpp"
+#include "utility/spsc_byte_ring.hpp"
+#include "utility/string_hash.hpp"
+#include "utility/string_interner.hpp"
+#include "utility/thread_pool.hpp"
+#include "utility/tracking_allocator.hpp"
+#include "utility/tsc_clock.hpp"
+
+export module chops.utility;
+
+export namespace chops {
+
+// async_file_reader.hpp
+#if defined(__linux__)
+using chops::read_result;
+using chops::read_handler;
+using chops::async_reader_options;
+using chops::async_file_reader;
+#endif
+
+// binary_logger.hpp
+using chops::log_arg_type;
+using chops::log_output;
+using chops::binary_logger;
+using chops::decode_binary_log;
+
+// bitmap.hpp
+using chops::bitmap;
+using chops::count_and;
+using chops::rank_select;
+using chops::erase_where_bits;
+
+// bloom_filter.hpp
+using chops::bloom_parameters;
+using chops::bloom_false_positive_rate;
+using chops::calculate_bloom_parameters;
+using chops::basic_blocked_bloom_filter;
+using chops::blocked_bloom_filter;
+using chops::concurrent_blocked_bloom_filter;
+
+// byte_array.hpp
+using chops::make_byte_array;
+using chops::compare_byte_arrays;
+
+// cache_padded.hpp
+using chops::cache_line_size;
+using chops::cache_padded;
+using chops::relaxed_counter;
+using chops::cpu_slot_index;
+using chops::per_cpu;
+using chops::per_cpu_counter;
+
+// cast_ptr_to.hpp
+using chops::cast_ptr_to;
+
+// chunked_vector.hpp
+using chops::chunked_vector;
+
+// circular_buffer.hpp
+using chops::circular_buffer;
+using chops::snapshot_circular_buffer;
+
+// coalescing_writer.hpp
+using chops::io_vec;
+using chops::coalescing_config;
+using chops::flush_reason;
+using chops::flush_stats;
+using chops::coalescing_totals;
+using chops::coalescing_writer;
+#if defined(__linux__)
+using chops::write_all;
+#endif
+
+// compressed_bitmap.hpp
+using chops::compressed_bitmap;
+
+// concurrent_hash_map.hpp
+using chops::concurrent_hash_map;
+
+// d_ary_heap.hpp
+using chops::d_ary_heap;
+using chops::indexed_priority_queue;
+
+// erase_where.hpp
+using chops::erase_where;
+using chops::erase_where_if;
+
+// forward_capture.hpp
+using chops::access;
+
+// hash_bytes.hpp
+using chops::mul_fold;
+using chops::hash_bytes;
+using chops::hash_value;
+using chops::hash_mix;
+
+// intrusive_list.hpp
+using chops::link_mode;
+using chops::list_hook;
+using chops::intrusive_list;
+
+// memory_reclaim.hpp
+using chops::reclamation_stats;
+using chops::epoch_domain;
+using chops::epoch_guard;
+using chops::hazard_domain;
+using chops::hazard_guard;
+
+// numa.hpp
+using chops::parse_cpu_list;
+using chops::numa_topology;
+using chops::system_numa_topology;
+using chops::current_cpu;
+using chops::current_numa_node;
+using chops::pin_thread;
+using chops::pin_current_thread;
+using chops::pin_current_thread_to_node;
+using chops::bind_memory_to_node;
+using chops::set_preferred_numa_node;
+using chops::reset_numa_memory_policy;
+using chops::numa_local;
+
+// numeric_text.hpp
+using chops::append_decimal;
+using chops::append_hex;
+using chops::append_fixed;
+using chops::parse_decimal;
+using chops::parse_hex;
+using chops::parse_fixed;
+
+// overloaded.hpp
+using chops::overloaded;
+
+// parallel.hpp
+using chops::par_options;
+using chops::par_participants;
+using chops::par_for_chunks;
+using chops::par_for_each;
+using chops::par_transform;
+using chops::par_reduce;
+using chops::repeat_par;
+
+// random.hpp
+using chops::splitmix64;
+using chops::xoshiro256ss;
+using chops::wyrand;
+using chops::xoshiro256ss_x4;
+using chops::full_range_64_generator;
+using chops::fill_random;
+using chops::uniform_below;
+using chops::uniform_int;
+using chops::uniform_double;
+using chops::uniform_float;
+using chops::uniform_real;
+
+// rate_limiter.hpp
+using chops::token_bucket;
+using chops::sliding_window_limiter;
+using chops::keyed_rate_limiter;
+
+// repeat.hpp
+using chops::repeat;
+
+// seqlock.hpp
+using chops::seqlock;
+
+// slot_map.hpp
+using chops::slot_handle;
+using chops::slot_map;
+
+// spin_lock.hpp
+using chops::cpu_relax;
+using chops::spin_lock;
+using chops::hybrid_mutex;
+
+// spsc_byte_ring.hpp
+using chops::spsc_byte_ring;
+
+// string_hash.hpp
+using chops::fnv1a_32;
+using chops::fnv1a_64;
+using chops::perfect_hash_table;
+using chops::make_perfect_hash;
+using chops::dispatch_keyword;
+namespace literals {
+using chops::literals::operator""_hash;
+using chops::literals::operator""_fnv1a;
+}
+
+// string_interner.hpp
+using chops::symbol_id;
+using chops::string_interner;
+
+// thread_pool.hpp
+using chops::thread_pool;
+using chops::default_thread_pool;
+
+// tracking_allocator.hpp
+using chops::max_allocation_tags;
+using chops::allocation_histogram_size;
+using chops::allocation_bucket;
+using chops::allocation_stats;
+using chops::allocation_stack_sample;
+using chops::allocation_tag;
+using chops::tracking_allocator;
+using chops::tracking_resource;
+using chops::allocation_report;
+
+// tsc_clock.hpp
+using chops::tsc_clock;
+
+} // end namespace
+
@@ -0,0 +1,174 @@
+/** @file
+ *
+ * @brief Test scenarios for @c async_file_reader and @c read_handler.
+ *
+ * Each scenario runs with io_uring (when the kernel allows it) and with the @c pread
+ * fallback.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstddef> // std::byte, std::size_t
+#include <cstdint> // std::uint64_t
+#include <filesystem>
+#include <fstream>
+#include <memory> // std::unique_ptr
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utility/async_file_reader.hpp"
+
+#if defined(__linux__)
+
+#include <fcntl.h> // open
+#include <unistd.h> // close
+
+namespace {
+
+// file with a byte pattern depending on the offset
+struct temp_file {
+  explicit temp_file(std::size_t size) :
+      m_path(std::filesystem::temp_directory_path() / ("async_reader_test_" + std::to_string(size))) {
+    std::vector<char> buf(size);
+    for (std::size_t i = 0u; i < size; ++i) {
+      buf[i] = static_cast<char>(pattern(i));
+    }
+    std::ofstream(m_path, std::ios::binary).write(buf.data(), static_cast<std::streamsize>(size));
+  }
+  ~temp_file() { std::filesystem::remove(m_path); }
+
+  static unsigned char pattern(std::uint64_t off) { return static_cast<unsigned char>((off * 7u + off / 251u) & 0xffu); }
+
+  std::filesystem::path m_path;
+};
+
+bool matches(std::uint64_t offset, std::span<const std::byte> data) {
+  for (std::size_t i = 0u; i < data.size(); ++i) {
+    if (static_cast<unsigned char>(data[i]) != temp_file::pattern(offset + i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+TEST_CASE ( "Read handler stores small callables inline", "[async_file_reader]" ) {
+
+  int calls = 0;
+  auto owned = std::make_unique<int>(5);
+  chops::read_handler h([&calls, p = std::move(owned)] (const chops::read_result& r) { calls += *p + static_cast<int>(r.data.size()); } );
+  REQUIRE (h);
+  chops::read_handler h2(std::move(h));
+  REQUIRE_FALSE (h);
+  h2(chops::read_result { });
+  REQUIRE (calls == 5);
+  h = std::move(h2);
+  h(chops::read_result { });
+  REQUIRE (calls == 10);
+  h.reset();
+  REQUIRE_FALSE (h);
+}
+
+TEST_CASE ( "Async file reader reads a file in order", "[async_file_reader]" ) {
+
+  temp_file f(1'000'003u);
+  for (bool uring : { true, false }) {
+    chops::async_file_reader rdr({ .queue_depth = 4u, .buffer_size = 64u * 1024u, .use_io_uring = uring });
+    if (!uring) {
+      REQUIRE_FALSE (rdr.uses_io_uring());
+    }
+    std::uint64_t expected = 0u;
+    bool ok = true;
+    auto ec = rdr.read_file(f.m_path.c_str(), [&] (std::uint64_t off, std::span<const std::byte> data) {
+        ok = ok && off == expected && matches(off, data);
+        expected += data.size();
+      } );
+    REQUIRE_FALSE (ec);
+    REQUIRE (ok);
+    REQUIRE (expected == 1'000'003u);
+    REQUIRE (rdr.in_flight() == 0u);
+
+    auto bad = rdr.read_file("/nonexistent/async_reader_test", [] (std::uint64_t, std::span<const std::byte>) { } );
+    REQUIRE (bad == std::errc::no_such_file_or_directory);
+
+    // an exception from the chunk callback leaves the reader usable
+    REQUIRE_THROWS_AS (rdr.read_file(f.m_path.c_str(), [] (std::uint64_t off, std::span<const std::byte>) {
+        if (off > 0u) {
+          throw std::runtime_error("stop");
+        }
+      } ), std::runtime_error);
+    REQUIRE (rdr.in_flight() == 0u);
+  }
+}
+
+TEST_CASE ( "Async file reader completes independent reads", "[async_file_reader]" ) {
+
+  temp_file f(100'000u);
+  int fd = ::open(f.m_path.c_str(), O_RDONLY);
+  REQUIRE (fd >= 0);
+  for (bool uring : { true, false }) {
+    chops::async_file_reader rdr({ .queue_depth = 3u, .buffer_size = 4096u, .use_io_uring = uring, .fallback_threads = 2u });
+    REQUIRE (rdr.queue_depth() == 3u);
+    REQUIRE_THROWS_AS (rdr.read(fd, 0u, 4097u, [] (const chops::read_result&) { } ), std::invalid_argument);
+
+    int done = 0;
+    int bad = 0;
+    std::size_t total = 0u;
+    // more reads than buffers, so read waits for completions
+    for (std::uint64_t off = 0u; off < 100'000u; off += 1000u) {
+      rdr.read(fd, off, 4096u, [&] (const chops::read_result& r) {
+          ++done;
+          total += r.data.size();
+          if (r.error || r.fd != fd || !matches(r.offset, r.data)) {
+            ++bad;
+          }
+        } );
+      REQUIRE (rdr.in_flight() <= 3u);
+    }
+    // a handler queueing another read, and a read past end of file
+    rdr.read(fd, 99'000u, 4096u, [&] (const chops::read_result& r) {
+        ++done;
+        total += r.data.size();
+        rdr.read(fd, 200'000u, 10u, [&] (const chops::read_result& r2) {
+            ++done;
+            if (!r2.data.empty()) {
+              ++bad;
+            }
+          } );
+      } );
+    rdr.drain();
+    REQUIRE (bad == 0);
+    REQUIRE (done == 102);
+    REQUIRE (total == 96u * 4096u + 4000u + 3000u + 2000u + 1000u + 1000u);
+
+    // a failed read reports the error
+    std::error_code err;
+    rdr.read(-1, 0u, 16u, [&err] (const chops::read_result& r) { err = r.error; } );
+    REQUIRE (rdr.wait() == 1u);
+    REQUIRE (err == std::errc::bad_file_descriptor);
+    REQUIRE (rdr.wait() == 0u);
+
+    // reads in flight at destruction are waited for without their handlers
+    {
+      chops::async_file_reader rdr2({ .queue_depth = 2u, .buffer_size = 4096u, .use_io_uring = uring });
+      rdr2.read(fd, 0u, 4096u, [&done] (const chops::read_result&) { ++done; } );
+      rdr2.submit();
+    }
+    REQUIRE (done == 102);
+  }
+  ::close(fd);
+}
+
+#endif
+
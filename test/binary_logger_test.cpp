@@ -0,0 +1,186 @@
+/** @file
+ *
+ * @brief Test scenarios for @c binary_logger.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "utility/binary_logger.hpp"
+#include "utility/repeat.hpp"
+
+namespace {
+
+struct capture {
+  std::mutex             mutex;
+  std::vector<std::byte> bytes;
+  int                    calls { 0 };
+
+  chops::binary_logger::writer_type writer() {
+    return [this] (std::span<const std::byte> buf) {
+      std::lock_guard lk(mutex);
+      bytes.insert(bytes.end(), buf.begin(), buf.end());
+      ++calls;
+    };
+  }
+};
+
+// text lines with the leading time stamp removed
+std::vector<std::string> messages(const std::vector<std::byte>& bytes) {
+  std::vector<std::string> lines;
+  std::string_view sv(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+  while (!sv.empty()) {
+    auto eol = sv.find('\n');
+    auto line = sv.substr(0u, eol);
+    lines.emplace_back(line.substr(line.find(' ') + 1u));
+    sv.remove_prefix(eol + 1u);
+  }
+  return lines;
+}
+
+}
+
+TEST_CASE ( "Binary logger text output", "[binary_logger]" ) {
+
+  capture cap;
+  {
+    chops::binary_logger logger(cap.writer());
+    std::string str("world");
+    REQUIRE (logger.log("hello {}", str));
+    REQUIRE (logger.log("ints {} {} {} {}", -5, std::uint8_t{200}, std::int64_t{-9000000000}, 42u));
+    REQUIRE (logger.log("misc {} {} {} {}", true, 'x', 1.5, 0.25f));
+    REQUIRE (logger.log("view {} and literal {}", std::string_view("abc"), "def"));
+    REQUIRE (logger.log("no args"));
+    REQUIRE (logger.log("extra {} {}", 1));
+    logger.flush();
+    std::lock_guard lk(cap.mutex);
+    auto lines = messages(cap.bytes);
+    REQUIRE (lines == std::vector<std::string>{ "hello world",
+                                                "ints -5 200 -9000000000 42",
+                                                "misc true x 1.500000 0.250000",
+                                                "view abc and literal def",
+                                                "no args",
+                                                "extra 1 {}" });
+    REQUIRE (logger.dropped() == 0u);
+  }
+}
+
+TEST_CASE ( "Binary logger time stamps", "[binary_logger]" ) {
+
+  capture cap;
+  {
+    chops::binary_logger logger(cap.writer());
+    auto before = chops::tsc_clock::now().time_since_epoch().count();
+    logger.log("stamped");
+    auto after = chops::tsc_clock::now().time_since_epoch().count();
+    logger.flush();
+    std::lock_guard lk(cap.mutex);
+    std::string line(reinterpret_cast<const char*>(cap.bytes.data()), cap.bytes.size());
+    auto ts = std::stoll(line.substr(0u, line.find(' ')));
+    REQUIRE (ts >= before - 1000);
+    REQUIRE (ts <= after + 1000);
+  }
+}
+
+TEST_CASE ( "Binary logger binary output and decoding", "[binary_logger]" ) {
+
+  capture text_cap;
+  capture bin_cap;
+  {
+    chops::binary_logger text_logger(text_cap.writer());
+    chops::binary_logger bin_logger(bin_cap.writer(), chops::log_output::binary);
+    chops::repeat(100, [&] (int i) {
+      text_logger.log("value {} name {}", i, "abc");
+      bin_logger.log("value {} name {}", i, "abc");
+      text_logger.log("flag {}", i % 2 == 0);
+      bin_logger.log("flag {}", i % 2 == 0);
+    } );
+  }
+  std::vector<std::byte> decoded;
+  REQUIRE (chops::decode_binary_log(bin_cap.bytes, decoded));
+  REQUIRE (messages(decoded) == messages(text_cap.bytes));
+  REQUIRE (messages(decoded).size() == 200u);
+  // format strings are written once, so the binary log is smaller
+  REQUIRE (bin_cap.bytes.size() < text_cap.bytes.size());
+
+  auto truncated = std::span<const std::byte>(bin_cap.bytes).first(bin_cap.bytes.size() - 3u);
+  std::vector<std::byte> partial;
+  REQUIRE (!chops::decode_binary_log(truncated, partial));
+  REQUIRE (messages(partial).size() == 199u);
+  REQUIRE (!chops::decode_binary_log(std::span<const std::byte>(text_cap.bytes), partial));
+}
+
+TEST_CASE ( "Binary logger drops entries when a ring is full", "[binary_logger]" ) {
+
+  capture cap;
+  {
+    // long poll interval so nothing is drained until the flush
+    chops::binary_logger logger(cap.writer(), chops::log_output::text, 1024u, std::chrono::milliseconds(10000));
+    int logged = 0;
+    chops::repeat(1000, [&] (int i) { logged += logger.log("entry {}", i) ? 1 : 0; } );
+    REQUIRE (logged < 1000);
+    REQUIRE (logger.dropped() == static_cast<std::uint64_t>(1000 - logged));
+    logger.flush();
+    std::lock_guard lk(cap.mutex);
+    REQUIRE (messages(cap.bytes).size() == static_cast<std::size_t>(logged));
+  }
+}
+
+TEST_CASE ( "Binary logger multiple threads", "[binary_logger]" ) {
+
+  constexpr int num_threads = 4;
+  constexpr int per_thread = 5000;
+  capture cap;
+  {
+    chops::binary_logger logger(cap.writer(), chops::log_output::text, 1u << 16u, std::chrono::milliseconds(1));
+    std::vector<std::thread> thrs;
+    for (int t = 0; t < num_threads; ++t) {
+      thrs.emplace_back([&logger, t] {
+        for (int i = 0; i < per_thread; ) {
+          if (logger.log("thread {} seq {}", t, i)) {
+            ++i;
+          }
+          else {
+            std::this_thread::yield();
+          }
+        }
+      } );
+    }
+    for (auto& th : thrs) {
+      th.join();
+    }
+    logger.flush();
+  }
+  auto lines = messages(cap.bytes);
+  REQUIRE (lines.size() == static_cast<std::size_t>(num_threads * per_thread));
+  // entries from each thread are in order
+  std::vector<int> next(num_threads, 0);
+  int errors = 0;
+  for (const auto& line : lines) {
+    int t = 0, i = 0;
+    if (std::sscanf(line.c_str(), "thread %d seq %d", &t, &i) != 2 || next[static_cast<std::size_t>(t)] != i) {
+      ++errors;
+    }
+    else {
+      ++next[static_cast<std::size_t>(t)];
+    }
+  }
+  REQUIRE (errors == 0);
+}
@@ -0,0 +1,145 @@
+/** @file
+ *
+ * @brief Test scenarios for @c bitmap, @c rank_select, and @c erase_where_bits.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstddef> // std::size_t
+#include <vector>
+
+#include "utility/bitmap.hpp"
+
+TEST_CASE ( "Bitmap basic bit operations", "[bitmap]" ) {
+
+  chops::bitmap bm(130u);
+  REQUIRE (bm.size() == 130u);
+  REQUIRE (bm.words().size() == 3u);
+  REQUIRE (bm.none());
+  REQUIRE (bm.count() == 0u);
+  REQUIRE (bm.find_first() == chops::bitmap::npos);
+
+  bm.set(0u);
+  bm.set(63u);
+  bm.set(64u);
+  bm.set(129u);
+  REQUIRE (bm.count() == 4u);
+  REQUIRE (bm.test(63u));
+  REQUIRE (bm[64u]);
+  REQUIRE_FALSE (bm.test(1u));
+  bm.reset(63u);
+  bm.flip(1u);
+  bm.set(2u, true);
+  bm.set(0u, false);
+  REQUIRE (bm.count() == 4u);
+  REQUIRE (bm.find_first() == 1u);
+  REQUIRE (bm.find_next(1u) == 2u);
+  REQUIRE (bm.find_next(2u) == 64u);
+  REQUIRE (bm.find_next(64u) == 129u);
+  REQUIRE (bm.find_next(129u) == chops::bitmap::npos);
+
+  bm.set_all();
+  REQUIRE (bm.count() == 130u);
+  REQUIRE (bm.words()[2] == 0x3u); // tail bits stay clear
+  bm.flip_all();
+  REQUIRE (bm.none());
+
+  chops::bitmap full(70u, true);
+  REQUIRE (full.count() == 70u);
+  full.resize(200u, true);
+  REQUIRE (full.count() == 200u);
+  full.resize(65u);
+  REQUIRE (full.count() == 65u);
+  full.resize(100u);
+  REQUIRE (full.count() == 65u);
+}
+
+TEST_CASE ( "Bitmap bulk operations and iteration", "[bitmap]" ) {
+
+  constexpr std::size_t sz = 1000u;
+  chops::bitmap a(sz);
+  chops::bitmap b(sz);
+  for (std::size_t i = 0u; i < sz; i += 2u) {
+    a.set(i);
+  }
+  for (std::size_t i = 0u; i < sz; i += 3u) {
+    b.set(i);
+  }
+  REQUIRE (a.count() == 500u);
+  REQUIRE (b.count() == 334u);
+  REQUIRE ((a & b).count() == 167u);
+  REQUIRE (chops::count_and(a, b) == 167u);
+  REQUIRE ((a | b).count() == 667u);
+  REQUIRE ((a ^ b).count() == 500u);
+  auto c = a;
+  c.and_not(b);
+  REQUIRE (c.count() == 333u);
+  REQUIRE (c != a);
+  c |= b;
+  REQUIRE (c == (a | b));
+
+  std::vector<std::size_t> positions;
+  (a & b).for_each_set([&positions] (std::size_t pos) { positions.push_back(pos); } );
+  REQUIRE (positions.size() == 167u);
+  for (std::size_t i = 0u; i < positions.size(); ++i) {
+    REQUIRE (positions[i] == i * 6u);
+  }
+}
+
+TEST_CASE ( "Bitmap rank and select", "[bitmap]" ) {
+
+  constexpr std::size_t sz = 5000u;
+  chops::bitmap bm(sz);
+  for (std::size_t i = 0u; i < sz; i += 7u) {
+    bm.set(i);
+  }
+  chops::rank_select rs(bm);
+  REQUIRE (rs.count() == bm.count());
+
+  std::size_t expected_rank = 0u;
+  for (std::size_t pos = 0u; pos <= sz; ++pos) {
+    REQUIRE (rs.rank(pos) == expected_rank);
+    if (pos < sz && bm.test(pos)) {
+      ++expected_rank;
+    }
+  }
+  for (std::size_t k = 0u; k < rs.count(); ++k) {
+    REQUIRE (rs.select(k) == k * 7u);
+    REQUIRE (rs.rank(rs.select(k)) == k);
+  }
+  REQUIRE (rs.select(rs.count()) == chops::rank_select::npos);
+
+  chops::bitmap empty_bm;
+  chops::rank_select empty_rs(empty_bm);
+  REQUIRE (empty_rs.count() == 0u);
+  REQUIRE (empty_rs.rank(0u) == 0u);
+  REQUIRE (empty_rs.select(0u) == chops::rank_select::npos);
+}
+
+TEST_CASE ( "Erase elements using a tombstone bitmap", "[bitmap] [erase_where_bits]" ) {
+
+  std::vector<int> vec { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+  chops::bitmap tombstones(vec.size());
+  tombstones.set(1u);
+  tombstones.set(4u);
+  tombstones.set(5u);
+  tombstones.set(9u);
+  chops::erase_where_bits(vec, tombstones);
+  REQUIRE (vec == std::vector<int> { 0, 2, 3, 6, 7, 8 });
+
+  chops::bitmap none(vec.size());
+  chops::erase_where_bits(vec, none);
+  REQUIRE (vec.size() == 6u);
+
+  chops::bitmap all(vec.size(), true);
+  chops::erase_where_bits(vec, all);
+  REQUIRE (vec.empty());
+}
@@ -0,0 +1,129 @@
+/** @file
+ *
+ * @brief Test scenarios for @c blocked_bloom_filter, @c concurrent_blocked_bloom_filter,
+ * and the parameter calculator.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <cstddef> // std::byte
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utility/bloom_filter.hpp"
+#include "utility/repeat.hpp"
+
+constexpr std::size_t num_keys = 20000u;
+
+std::string key_of (std::size_t i) { return "key-" + std::to_string(i); }
+
+template <typename F>
+double measured_fp_rate (const F& filter) {
+  std::size_t fps = 0u;
+  constexpr std::size_t probes = 100000u;
+  for (std::size_t i = 0u; i < probes; ++i) {
+    fps += filter.contains(key_of(num_keys + i));
+  }
+  return static_cast<double>(fps) / static_cast<double>(probes);
+}
+
+TEST_CASE ( "Bloom filter parameter calculator", "[bloom_filter]" ) {
+
+  auto p = chops::calculate_bloom_parameters(num_keys, 0.01);
+  REQUIRE (p.num_hashes == 7u);
+  REQUIRE (chops::bloom_false_positive_rate(p, num_keys) <= 0.01);
+  // about 10 bits per key for 1%, slightly more for blocking
+  REQUIRE (p.num_blocks * 512u > num_keys * 9u);
+  REQUIRE (p.num_blocks * 512u < num_keys * 14u);
+
+  auto p2 = chops::calculate_bloom_parameters(num_keys, 0.001);
+  REQUIRE (p2.num_blocks > p.num_blocks);
+  REQUIRE (chops::bloom_false_positive_rate(p2, num_keys) <= 0.001);
+}
+
+TEST_CASE ( "Blocked Bloom filter inserts, lookups, and false positives", "[bloom_filter]" ) {
+
+  auto params = chops::calculate_bloom_parameters(num_keys, 0.01);
+  chops::blocked_bloom_filter filter(params);
+  REQUIRE_FALSE (filter.contains("anything"));
+  REQUIRE (filter.size_bytes() == params.num_blocks * 64u);
+
+  chops::repeat(static_cast<int>(num_keys), [&filter] (int i) { filter.insert(key_of(static_cast<std::size_t>(i))); } );
+  chops::repeat(static_cast<int>(num_keys), [&filter] (int i) {
+    REQUIRE (filter.contains(key_of(static_cast<std::size_t>(i))));
+  } );
+  auto rate = measured_fp_rate(filter);
+  REQUIRE (rate < 0.015);
+  REQUIRE (filter.fill_ratio() > 0.4);
+  REQUIRE (filter.fill_ratio() < 0.6);
+
+  std::vector<std::byte> bytes { std::byte { 1 }, std::byte { 2 } };
+  filter.insert(std::span<const std::byte>(bytes));
+  REQUIRE (filter.contains(std::span<const std::byte>(bytes)));
+
+  auto copy = filter;
+  filter.clear();
+  REQUIRE_FALSE (filter.contains(key_of(1u)));
+  REQUIRE (copy.contains(key_of(1u)));
+}
+
+TEST_CASE ( "Bloom filter serialization", "[bloom_filter]" ) {
+
+  chops::blocked_bloom_filter filter(chops::calculate_bloom_parameters(1000u, 0.01));
+  chops::repeat(1000, [&filter] (int i) { filter.insert(key_of(static_cast<std::size_t>(i))); } );
+
+  std::vector<std::byte> buf(filter.serialized_size());
+  REQUIRE (filter.serialize(std::span<std::byte>(buf.data(), buf.size() - 1u)) == 0u);
+  REQUIRE (filter.serialize(buf) == buf.size());
+
+  auto restored = chops::blocked_bloom_filter::deserialize(buf);
+  REQUIRE (restored);
+  REQUIRE (restored->parameters().num_blocks == filter.parameters().num_blocks);
+  REQUIRE (restored->parameters().num_hashes == filter.parameters().num_hashes);
+  chops::repeat(1000, [&restored] (int i) { REQUIRE (restored->contains(key_of(static_cast<std::size_t>(i)))); } );
+
+  auto conc = chops::concurrent_blocked_bloom_filter::deserialize(buf);
+  REQUIRE (conc);
+  REQUIRE (conc->contains(key_of(999u)));
+
+  REQUIRE_FALSE (chops::blocked_bloom_filter::deserialize(std::span<const std::byte>(buf.data(), buf.size() - 1u)));
+  buf[0] = std::byte { 0 };
+  REQUIRE_FALSE (chops::blocked_bloom_filter::deserialize(buf));
+}
+
+TEST_CASE ( "Concurrent Bloom filter inserts", "[bloom_filter]" ) {
+
+  constexpr int num_thrs = 4;
+  chops::concurrent_blocked_bloom_filter filter(chops::calculate_bloom_parameters(num_keys, 0.01));
+  std::atomic<int> missing { 0 };
+  std::vector<std::thread> thrs;
+  chops::repeat(num_thrs, [&] (int t) {
+    thrs.emplace_back([&filter, &missing, t] {
+      for (std::size_t i = static_cast<std::size_t>(t); i < num_keys; i += num_thrs) {
+        filter.insert(key_of(i));
+        if (!filter.contains(key_of(i))) {
+          missing.fetch_add(1);
+        }
+      }
+    } );
+  } );
+  for (auto& thr : thrs) {
+    thr.join();
+  }
+  REQUIRE (missing.load() == 0);
+  chops::repeat(static_cast<int>(num_keys), [&filter] (int i) {
+    REQUIRE (filter.contains(key_of(static_cast<std::size_t>(i))));
+  } );
+  REQUIRE (measured_fp_rate(filter) < 0.015);
+}
@@ -0,0 +1,85 @@
+/** @file
+ *
+ * @brief Test scenarios for @c cache_padded, @c relaxed_counter, @c per_cpu, and
+ * @c per_cpu_counter.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <cstdint> // std::uintptr_t
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utility/cache_padded.hpp"
+#include "utility/repeat.hpp"
+
+TEST_CASE ( "Cache padded values occupy their own cache lines", "[cache_padded]" ) {
+
+  STATIC_REQUIRE (sizeof(chops::cache_padded<char>) == chops::cache_line_size);
+  STATIC_REQUIRE (alignof(chops::cache_padded<int>) == chops::cache_line_size);
+  STATIC_REQUIRE (sizeof(chops::cache_padded<char[chops::cache_line_size + 1u]>) == 
+                  2u * chops::cache_line_size);
+
+  chops::cache_padded<std::atomic<int>> arr[2];
+  REQUIRE (arr[0]->load() == 0);
+  auto diff = reinterpret_cast<std::uintptr_t>(&arr[1].get()) - reinterpret_cast<std::uintptr_t>(&arr[0].get());
+  REQUIRE (diff == chops::cache_line_size);
+
+  chops::cache_padded<std::string> str { 3u, 'a' };
+  REQUIRE (*str == "aaa");
+  REQUIRE (str->size() == 3u);
+  auto copy { str };
+  REQUIRE (copy.get() == "aaa");
+}
+
+TEST_CASE ( "A relaxed counter counts", "[relaxed_counter]" ) {
+  chops::relaxed_counter cnt;
+  ++cnt;
+  cnt += 10u;
+  cnt.add(5u);
+  REQUIRE (cnt.load() == 16u);
+  cnt.store(2u);
+  REQUIRE (cnt.load() == 2u);
+}
+
+TEST_CASE ( "Per CPU slots are a power of two and cover the local CPU", "[per_cpu]" ) {
+  chops::per_cpu<std::atomic<int>> slots { 3u };
+  REQUIRE (slots.size() == 4u);
+  slots.local() += 1;
+  int total = 0;
+  slots.for_each([&total] (const std::atomic<int>& v) { total += v.load(); } );
+  REQUIRE (total == 1);
+
+  chops::per_cpu<int> dflt;
+  REQUIRE (dflt.size() >= std::thread::hardware_concurrency());
+  REQUIRE (dflt[0] == 0);
+}
+
+TEST_CASE ( "A per CPU counter sums increments from many threads", "[per_cpu_counter]" ) {
+  constexpr int NumThreads = 8;
+  constexpr int NumIncrs = 10000;
+
+  chops::per_cpu_counter cnt;
+  std::vector<std::thread> thrs;
+  chops::repeat(NumThreads, [&] {
+    thrs.emplace_back([&cnt] { chops::repeat(NumIncrs, [&cnt] { ++cnt; } ); } );
+  } );
+  for (auto& thr : thrs) {
+    thr.join();
+  }
+  REQUIRE (cnt.load() == static_cast<std::uint64_t>(NumThreads * NumIncrs));
+  cnt += 5u;
+  REQUIRE (cnt.load() == static_cast<std::uint64_t>(NumThreads * NumIncrs + 5));
+  cnt.reset();
+  REQUIRE (cnt.load() == 0u);
+}
@@ -0,0 +1,132 @@
+/** @file
+ *
+ * @brief Test scenarios for @c chunked_vector.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm> // std::equal, std::sort
+#include <memory> // std::make_unique
+#include <numeric> // std::iota
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utility/chunked_vector.hpp"
+#include "utility/erase_where.hpp"
+#include "utility/repeat.hpp"
+
+TEST_CASE ( "Chunked vector growth keeps element addresses", "[chunked_vector]" ) {
+
+  chops::chunked_vector<int, 8> cv;
+  REQUIRE (cv.empty());
+  REQUIRE (cv.chunk_count() == 0u);
+
+  std::vector<const int*> addrs;
+  chops::repeat(100, [&] (int i) { addrs.push_back(&cv.emplace_back(i)); } );
+  REQUIRE (cv.size() == 100u);
+  REQUIRE (cv.chunk_count() == 13u);
+  REQUIRE (cv.capacity() == 104u);
+  for (std::size_t i = 0u; i < cv.size(); ++i) {
+    REQUIRE (&cv[i] == addrs[i]);
+    REQUIRE (cv[i] == static_cast<int>(i));
+  }
+  REQUIRE (cv.front() == 0);
+  REQUIRE (cv.back() == 99);
+  REQUIRE (cv.at(42) == 42);
+  REQUIRE_THROWS_AS (cv.at(100), std::out_of_range);
+
+  std::vector<int> expected(100u);
+  std::iota(expected.begin(), expected.end(), 0);
+  REQUIRE (std::equal(cv.begin(), cv.end(), expected.begin(), expected.end()));
+  REQUIRE (cv.end() - cv.begin() == 100);
+  REQUIRE (*(cv.cbegin() + 17) == 17);
+
+  std::size_t chunks = 0u;
+  long long sum = 0;
+  cv.for_each_chunk([&] (std::span<int> c) {
+      ++chunks;
+      for (auto v : c) {
+        sum += v;
+      }
+    } );
+  REQUIRE (chunks == 13u);
+  REQUIRE (sum == 4950);
+  REQUIRE (cv.chunk(12).size() == 4u);
+
+  cv.pop_back();
+  REQUIRE (cv.size() == 99u);
+  cv.clear();
+  REQUIRE (cv.empty());
+  REQUIRE (cv.capacity() == 104u);
+  cv.shrink_to_fit();
+  REQUIRE (cv.capacity() == 0u);
+}
+
+TEST_CASE ( "Chunked vector erase and erase_where_if", "[chunked_vector]" ) {
+
+  chops::chunked_vector<std::string, 4> cv;
+  chops::repeat(20, [&cv] (int i) { cv.push_back(std::to_string(i)); } );
+
+  auto n = chops::erase_where_if(cv, [] (const std::string& s) { return std::stoi(s) % 3 == 0; } );
+  REQUIRE (n == 7u);
+  REQUIRE (cv.size() == 13u);
+  std::vector<std::string> expected { "1", "2", "4", "5", "7", "8", "10", "11", "13", "14", "16", "17", "19" };
+  REQUIRE (std::equal(cv.begin(), cv.end(), expected.begin(), expected.end()));
+
+  auto it = cv.erase(cv.begin() + 1);
+  REQUIRE (*it == "4");
+  REQUIRE (cv.size() == 12u);
+  chops::erase_where(cv, std::string("19"));
+  REQUIRE (cv.size() == 11u);
+  REQUIRE (cv.back() == "17");
+
+  // erasing an empty range leaves every element intact
+  it = cv.erase(cv.begin() + 2, cv.begin() + 2);
+  REQUIRE (it == cv.begin() + 2);
+  REQUIRE (cv.size() == 11u);
+  REQUIRE (cv.front() == "1");
+  REQUIRE (std::equal(cv.begin() + 1, cv.end(), expected.begin() + 2, expected.end() - 1));
+  chops::chunked_vector<std::vector<int>, 4> vv;
+  chops::repeat(6, [&vv] { vv.push_back(std::vector<int>(3u, 1)); } );
+  vv.erase(vv.begin() + 2, vv.begin() + 2);
+  REQUIRE (vv.size() == 6u);
+  for (const auto& e : vv) {
+    REQUIRE (e.size() == 3u);
+  }
+
+  REQUIRE (chops::erase_where_if(cv, [] (const std::string&) { return true; } ) == 11u);
+  REQUIRE (cv.empty());
+}
+
+TEST_CASE ( "Chunked vector copy, move and move only elements", "[chunked_vector]" ) {
+
+  chops::chunked_vector<int, 4> a;
+  chops::repeat(10, [&a] (int i) { a.push_back(i); } );
+  auto b = a;
+  REQUIRE (std::equal(a.begin(), a.end(), b.begin(), b.end()));
+  auto c = std::move(a);
+  REQUIRE (a.empty());
+  REQUIRE (c.size() == 10u);
+  a = c;
+  REQUIRE (a.size() == 10u);
+  REQUIRE (a[9] == 9);
+
+  chops::chunked_vector<std::unique_ptr<int>> ptrs;
+  REQUIRE (decltype(ptrs)::chunk_size == 2048u);
+  chops::repeat(5000, [&ptrs] (int i) { ptrs.push_back(std::make_unique<int>(i)); } );
+  REQUIRE (*ptrs[4999] == 4999);
+  REQUIRE (chops::erase_where_if(ptrs, [] (const std::unique_ptr<int>& p) { return *p < 2500; } ) == 2500u);
+  REQUIRE (*ptrs.front() == 2500);
+  REQUIRE (ptrs.chunk_count() == 2u);
+}
+
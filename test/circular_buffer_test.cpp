@@ -0,0 +1,200 @@
+/** @file
+ *
+ * @brief Test scenarios for @c circular_buffer and @c snapshot_circular_buffer.
+ *
+ * The concurrent snapshot scenario is intended to also be run under ThreadSanitizer.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm> // std::equal
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iterator> // std::back_inserter
+#include <memory> // std::unique_ptr
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utility/circular_buffer.hpp"
+#include "utility/repeat.hpp"
+
+TEST_CASE ( "Circular buffer overwrites the oldest element when full", "[circular_buffer]" ) {
+
+  chops::circular_buffer<int, 8> cb;
+  REQUIRE (cb.empty());
+  REQUIRE (cb.capacity() == 8u);
+
+  chops::repeat(5, [&cb] (int i) { cb.push_back(i); } );
+  REQUIRE (cb.size() == 5u);
+  REQUIRE (cb.front() == 0);
+  REQUIRE (cb.back() == 4);
+
+  chops::repeat(7, [&cb] (int i) { cb.push_back(i + 5); } );
+  REQUIRE (cb.full());
+  REQUIRE (cb.size() == 8u);
+  REQUIRE (cb.total_pushed() == 12u);
+  REQUIRE (cb.front() == 4);
+  REQUIRE (cb.back() == 11);
+  for (std::size_t i = 0u; i < cb.size(); ++i) {
+    REQUIRE (cb[i] == static_cast<int>(i) + 4);
+  }
+
+  cb.pop_front();
+  REQUIRE (cb.size() == 7u);
+  REQUIRE (cb.front() == 5);
+  cb.emplace_back(12);
+  cb.emplace_back(13);
+  REQUIRE (cb.size() == 8u);
+  REQUIRE (cb.front() == 6);
+
+  cb.clear();
+  REQUIRE (cb.empty());
+  cb.push_back(42);
+  REQUIRE (cb.front() == 42);
+  REQUIRE (cb.back() == 42);
+}
+
+TEST_CASE ( "Circular buffer spans and iteration", "[circular_buffer]" ) {
+
+  chops::circular_buffer<int, 8> cb;
+  {
+    auto [a, b] = cb.spans();
+    REQUIRE (a.empty());
+    REQUIRE (b.empty());
+  }
+  chops::repeat(6, [&cb] (int i) { cb.push_back(i); } );
+  {
+    auto [a, b] = cb.spans();
+    REQUIRE (a.size() == 6u);
+    REQUIRE (b.empty());
+  }
+  chops::repeat(5, [&cb] (int i) { cb.push_back(i + 6); } ); // 3 .. 10, wraps
+  const auto& ccb = cb;
+  auto [a, b] = ccb.spans();
+  REQUIRE (a.size() + b.size() == 8u);
+  REQUIRE (a.size() == 5u);
+  REQUIRE (a.front() == 3);
+  REQUIRE (b.back() == 10);
+
+  std::vector<int> expected { 3, 4, 5, 6, 7, 8, 9, 10 };
+  std::vector<int> out;
+  cb.copy_to(std::back_inserter(out));
+  REQUIRE (out == expected);
+  REQUIRE (std::equal(cb.begin(), cb.end(), expected.begin(), expected.end()));
+  REQUIRE (std::equal(ccb.cbegin(), ccb.cend(), expected.begin(), expected.end()));
+  REQUIRE (cb.end() - cb.begin() == 8);
+  REQUIRE (*(cb.begin() + 2) == 5);
+  REQUIRE (cb.begin()[7] == 10);
+
+  for (auto& v : cb) {
+    v *= 2;
+  }
+  REQUIRE (cb.front() == 6);
+  REQUIRE (cb.back() == 20);
+}
+
+TEST_CASE ( "Circular buffer with move only and non trivial elements", "[circular_buffer]" ) {
+
+  chops::circular_buffer<std::unique_ptr<int>, 4> ptrs;
+  chops::repeat(6, [&ptrs] (int i) { ptrs.push_back(std::make_unique<int>(i)); } );
+  REQUIRE (ptrs.size() == 4u);
+  REQUIRE (*ptrs.front() == 2);
+  ptrs.pop_front();
+  REQUIRE (*ptrs.front() == 3);
+
+  chops::circular_buffer<std::string, 2> strs;
+  strs.emplace_back(3u, 'a');
+  strs.push_back("bb");
+  strs.push_back("ccc");
+  REQUIRE (strs.front() == "bb");
+  REQUIRE (strs.back() == "ccc");
+}
+
+struct sample {
+  std::uint64_t seq;
+  std::uint64_t check;
+  std::uint32_t extra;
+};
+
+TEST_CASE ( "Snapshot circular buffer, single thread", "[circular_buffer]" ) {
+
+  chops::snapshot_circular_buffer<sample, 16> sb;
+  REQUIRE_FALSE (sb.latest());
+  REQUIRE (sb.snapshot().empty());
+
+  chops::repeat(10, [&sb] (int i) {
+      auto s = static_cast<std::uint64_t>(i);
+      sb.push_back(sample { s, s * 7u, static_cast<std::uint32_t>(i) } );
+    } );
+  REQUIRE (sb.total_pushed() == 10u);
+  REQUIRE (sb.latest()->seq == 9u);
+
+  auto cb = sb.snapshot();
+  REQUIRE (cb.size() == 10u);
+  REQUIRE (cb.front().seq == 0u);
+  REQUIRE (cb.back().seq == 9u);
+
+  chops::repeat(30, [&sb] (int i) {
+      auto s = static_cast<std::uint64_t>(i + 10);
+      sb.push_back(sample { s, s * 7u, 0u } );
+    } );
+  cb = sb.snapshot();
+  REQUIRE (cb.size() == 16u);
+  REQUIRE (cb.front().seq == 24u);
+  REQUIRE (cb.back().seq == 39u);
+
+  std::array<sample, 4> last;
+  REQUIRE (sb.snapshot(std::span<sample>(last)) == 4u);
+  REQUIRE (last[0].seq == 36u);
+  REQUIRE (last[3].seq == 39u);
+}
+
+TEST_CASE ( "Snapshot circular buffer, concurrent readers", "[circular_buffer]" ) {
+
+  constexpr std::uint64_t total = 200'000u;
+  chops::snapshot_circular_buffer<sample, 64> sb;
+  std::atomic<bool> done { false };
+  std::atomic<int> failures { 0 };
+  std::atomic<std::uint64_t> snapshots { 0u };
+
+  std::vector<std::thread> readers;
+  chops::repeat(2, [&] {
+      readers.emplace_back([&] {
+          std::array<sample, 64> buf;
+          while (!done.load(std::memory_order_acquire)) {
+            auto n = sb.snapshot(std::span<sample>(buf));
+            for (std::size_t i = 0u; i < n; ++i) {
+              // each element intact and consecutive with its predecessor
+              if (buf[i].check != buf[i].seq * 7u || (i > 0u && buf[i].seq != buf[i - 1u].seq + 1u)) {
+                failures.fetch_add(1, std::memory_order_relaxed);
+              }
+            }
+            snapshots.fetch_add(1u, std::memory_order_relaxed);
+          }
+        } );
+    } );
+
+  for (std::uint64_t s = 0u; s < total; ++s) {
+    sb.push_back(sample { s, s * 7u, 0u } );
+  }
+  done.store(true, std::memory_order_release);
+  for (auto& t : readers) {
+    t.join();
+  }
+  REQUIRE (failures.load() == 0);
+  REQUIRE (snapshots.load() > 0u);
+  REQUIRE (sb.latest()->seq == total - 1u);
+  REQUIRE (sb.snapshot().size() == 64u);
+}
+
@@ -0,0 +1,209 @@
+/** @file
+ *
+ * @brief Test scenarios for @c coalescing_writer.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include "utility/coalescing_writer.hpp"
+#include "utility/repeat.hpp"
+
+namespace {
+
+struct capture {
+  std::vector<std::byte>   bytes;
+  std::vector<std::size_t> batch_segments;
+
+  chops::coalescing_writer::sink_type sink() {
+    return [this] (std::span<const chops::io_vec> segs) {
+      batch_segments.push_back(segs.size());
+      for (const auto& s : segs) {
+        auto* p = static_cast<const std::byte*>(s.iov_base);
+        bytes.insert(bytes.end(), p, p + s.iov_len);
+      }
+    };
+  }
+};
+
+std::vector<std::byte> make_bytes(std::size_t n, int seed) {
+  std::vector<std::byte> v(n);
+  for (std::size_t i = 0u; i < n; ++i) {
+    v[i] = static_cast<std::byte>((i + static_cast<std::size_t>(seed)) & 0xffu);
+  }
+  return v;
+}
+
+}
+
+TEST_CASE ( "Coalescing writer size threshold", "[coalescing_writer]" ) {
+
+  capture cap;
+  std::vector<chops::flush_stats> reports;
+  chops::coalescing_config cfg;
+  cfg.flush_bytes = 1000u;
+  cfg.chunk_size = 256u;
+  cfg.max_delay = std::chrono::seconds(100);
+  chops::coalescing_writer wr(cap.sink(), cfg, [&reports] (const chops::flush_stats& st) { reports.push_back(st); } );
+
+  std::vector<std::byte> expected;
+  chops::repeat(30, [&] (int i) {
+    auto b = make_bytes(50u, i);
+    expected.insert(expected.end(), b.begin(), b.end());
+    wr.write(b);
+  } );
+  // 20 writes of 50 bytes reach the threshold
+  REQUIRE (reports.size() == 1u);
+  REQUIRE (reports[0].reason == chops::flush_reason::size);
+  REQUIRE (reports[0].bytes == 1000u);
+  REQUIRE (reports[0].writes == 20u);
+  REQUIRE (reports[0].sink_calls == 1u);
+  REQUIRE (reports[0].writes_saved == 19u);
+  REQUIRE (reports[0].segments == 4u);
+  REQUIRE (wr.pending_bytes() == 500u);
+  REQUIRE (wr.deadline().has_value());
+
+  auto st = wr.flush();
+  REQUIRE (st.reason == chops::flush_reason::explicit_flush);
+  REQUIRE (st.bytes == 500u);
+  REQUIRE (st.writes == 10u);
+  REQUIRE (cap.bytes == expected);
+  REQUIRE (!wr.deadline().has_value());
+  REQUIRE (wr.flush().bytes == 0u);
+  REQUIRE (cap.batch_segments.size() == 2u);
+
+  REQUIRE (wr.totals().bytes == 1500u);
+  REQUIRE (wr.totals().writes == 30u);
+  REQUIRE (wr.totals().sink_calls == 2u);
+  REQUIRE (wr.totals().flushes == 2u);
+  REQUIRE (wr.totals().average_batch() == 15.0);
+  // chunks are reused from the pool
+  REQUIRE (wr.chunks_allocated() == 4u);
+}
+
+TEST_CASE ( "Coalescing writer large writes are not copied", "[coalescing_writer]" ) {
+
+  std::vector<const void*> bases;
+  std::size_t total = 0u;
+  chops::coalescing_config cfg;
+  cfg.copy_threshold = 1024u;
+  chops::coalescing_writer wr([&] (std::span<const chops::io_vec> segs) {
+      for (const auto& s : segs) {
+        bases.push_back(s.iov_base);
+        total += s.iov_len;
+      }
+    }, cfg);
+
+  auto small = make_bytes(100u, 1);
+  auto large = make_bytes(5000u, 2);
+  wr.write(small);
+  REQUIRE (bases.empty());
+  wr.write(large);
+  REQUIRE (bases.size() == 2u);
+  REQUIRE (bases[0] != small.data());
+  REQUIRE (bases[1] == large.data());
+  REQUIRE (total == 5100u);
+  REQUIRE (wr.pending_bytes() == 0u);
+  REQUIRE (wr.totals().writes == 2u);
+  REQUIRE (wr.totals().sink_calls == 1u);
+}
+
+TEST_CASE ( "Coalescing writer deadline", "[coalescing_writer]" ) {
+
+  capture cap;
+  chops::coalescing_config cfg;
+  cfg.max_delay = std::chrono::milliseconds(2);
+  chops::coalescing_writer wr(cap.sink(), cfg);
+
+  REQUIRE (!wr.poll());
+  wr.write(make_bytes(10u, 0));
+  auto dl = wr.deadline();
+  REQUIRE (dl.has_value());
+  REQUIRE (*dl > chops::tsc_clock::now());
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  auto st = wr.poll();
+  REQUIRE (st.has_value());
+  REQUIRE (st->reason == chops::flush_reason::deadline);
+  REQUIRE (st->bytes == 10u);
+  REQUIRE (cap.bytes.size() == 10u);
+
+  // an expired deadline is also checked by write
+  wr.write(make_bytes(10u, 1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  wr.write(make_bytes(10u, 2));
+  REQUIRE (cap.bytes.size() == 30u);
+  REQUIRE (wr.pending_bytes() == 0u);
+}
+
+TEST_CASE ( "Coalescing writer splits batches at the segment limit", "[coalescing_writer]" ) {
+
+  capture cap;
+  chops::coalescing_config cfg;
+  cfg.chunk_size = 16u;
+  cfg.max_segments = 3u;
+  chops::coalescing_writer wr(cap.sink(), cfg);
+  auto b = make_bytes(100u, 3);
+  wr.write(b);
+  auto st = wr.flush();
+  REQUIRE (st.segments == 7u);
+  REQUIRE (st.sink_calls == 3u);
+  REQUIRE (st.writes_saved == 0u);
+  REQUIRE (cap.batch_segments == std::vector<std::size_t>{3u, 3u, 1u});
+  REQUIRE (cap.bytes == b);
+}
+
+#if defined(__linux__)
+TEST_CASE ( "Coalescing writer with writev to a pipe", "[coalescing_writer]" ) {
+
+  int fds[2];
+  REQUIRE (::pipe(fds) == 0);
+  std::vector<std::byte> received;
+  std::thread reader([&received, rd = fds[0]] {
+    std::byte buf[4096];
+    for (;;) {
+      auto n = ::read(rd, buf, sizeof(buf));
+      if (n <= 0) {
+        break;
+      }
+      received.insert(received.end(), buf, buf + n);
+    }
+  } );
+
+  std::vector<std::byte> expected;
+  {
+    int errors = 0;
+    chops::coalescing_writer wr([&errors, wfd = fds[1]] (std::span<const chops::io_vec> segs) {
+        errors += chops::write_all(wfd, segs) ? 1 : 0;
+      } );
+    chops::repeat(5000, [&] (int i) {
+      auto b = make_bytes(static_cast<std::size_t>(i % 200 + 1), i);
+      expected.insert(expected.end(), b.begin(), b.end());
+      wr.write(b);
+    } );
+    wr.flush();
+    REQUIRE (errors == 0);
+    REQUIRE (wr.totals().sink_calls < 100u);
+  }
+  ::close(fds[1]);
+  reader.join();
+  ::close(fds[0]);
+  REQUIRE (received == expected);
+}
+#endif
@@ -0,0 +1,107 @@
+/** @file
+ *
+ * @brief Test scenarios for @c compressed_bitmap.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstdint> // std::uint32_t
+#include <vector>
+
+#include "utility/compressed_bitmap.hpp"
+#include "utility/bitmap.hpp"
+
+TEST_CASE ( "Compressed bitmap add, remove, contains", "[compressed_bitmap]" ) {
+
+  chops::compressed_bitmap cb;
+  REQUIRE (cb.empty());
+  REQUIRE (cb.add(5u));
+  REQUIRE_FALSE (cb.add(5u));
+  REQUIRE (cb.add(70000u));
+  REQUIRE (cb.add(0xffffffffu));
+  REQUIRE (cb.cardinality() == 3u);
+  REQUIRE (cb.container_count() == 3u);
+  REQUIRE (cb.contains(70000u));
+  REQUIRE_FALSE (cb.contains(70001u));
+  REQUIRE_FALSE (cb.contains(1u << 20u));
+
+  std::vector<std::uint32_t> vals;
+  cb.for_each([&vals] (std::uint32_t v) { vals.push_back(v); } );
+  REQUIRE (vals == std::vector<std::uint32_t> { 5u, 70000u, 0xffffffffu });
+
+  REQUIRE (cb.remove(70000u));
+  REQUIRE_FALSE (cb.remove(70000u));
+  REQUIRE (cb.container_count() == 2u);
+  REQUIRE (cb.cardinality() == 2u);
+}
+
+TEST_CASE ( "Compressed bitmap switches container form", "[compressed_bitmap]" ) {
+
+  chops::compressed_bitmap cb;
+  for (std::uint32_t i = 0u; i < 10000u; ++i) {
+    cb.add(i * 2u);
+  }
+  REQUIRE (cb.cardinality() == 10000u);
+  REQUIRE (cb.container_count() == 1u);
+  REQUIRE (cb.bitmap_container_count() == 1u);
+  REQUIRE (cb.contains(19998u));
+  REQUIRE_FALSE (cb.contains(19999u));
+
+  for (std::uint32_t i = 0u; i < 6000u; ++i) {
+    cb.remove(i * 2u);
+  }
+  REQUIRE (cb.cardinality() == 4000u);
+  REQUIRE (cb.bitmap_container_count() == 0u);
+  REQUIRE (cb.contains(12000u));
+  REQUIRE_FALSE (cb.contains(11998u));
+
+  chops::compressed_bitmap sparse;
+  for (std::uint32_t i = 0u; i < 1000u; ++i) {
+    sparse.add(i * 1000003u);
+  }
+  REQUIRE (sparse.cardinality() == 1000u);
+  REQUIRE (sparse.bitmap_container_count() == 0u);
+  REQUIRE (sparse.memory_bytes() < (std::uint64_t{1u} << 32u) / 8u);
+}
+
+TEST_CASE ( "Compressed bitmap intersection and union", "[compressed_bitmap]" ) {
+
+  constexpr std::uint32_t sz = 200000u;
+  chops::bitmap da(sz);
+  chops::bitmap db(sz);
+  chops::compressed_bitmap a;
+  chops::compressed_bitmap b;
+  for (std::uint32_t i = 0u; i < sz; i += 3u) { // dense in every chunk
+    a.add(i);
+    da.set(i);
+  }
+  for (std::uint32_t i = 0u; i < sz; i += 50u) { // sparse
+    b.add(i);
+    db.set(i);
+  }
+  for (std::uint32_t i = 0u; i < 5000u; ++i) { // dense in the first chunk only
+    b.add(i);
+    db.set(i);
+  }
+
+  auto i_ab = a & b;
+  auto u_ab = a | b;
+  REQUIRE (i_ab.to_bitmap(sz) == (da & db));
+  REQUIRE (u_ab.to_bitmap(sz) == (da | db));
+  REQUIRE (i_ab.cardinality() == (da & db).count());
+  REQUIRE (u_ab.cardinality() == (da | db).count());
+  REQUIRE ((a & a) == a);
+  REQUIRE ((b | b) == b);
+
+  chops::compressed_bitmap from_dense(da);
+  REQUIRE (from_dense == a);
+  REQUIRE ((a & chops::compressed_bitmap { }).empty());
+}
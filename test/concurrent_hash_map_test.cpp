@@ -0,0 +1,170 @@
+/** @file
+ *
+ * @brief Test scenarios for @c concurrent_hash_map.
+ *
+ * The concurrent scenario is intended to also be run under ThreadSanitizer (configure
+ * with @c -D UTILITY_RACK_TEST_SANITIZER=thread).
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utility/concurrent_hash_map.hpp"
+#include "utility/erase_where.hpp"
+#include "utility/repeat.hpp"
+
+struct session {
+  std::uint64_t id;
+  std::uint32_t expiry;
+  std::uint32_t msg_count;
+};
+
+TEST_CASE ( "Concurrent hash map basic operations", "[concurrent_hash_map]" ) {
+
+  chops::concurrent_hash_map<std::uint64_t, session> m(4u);
+  static_assert (decltype(m)::lock_free_reads);
+  REQUIRE (m.shard_count() == 4u);
+  REQUIRE (m.empty());
+
+  REQUIRE (m.insert(42u, session { 42u, 100u, 0u }));
+  REQUIRE_FALSE (m.insert(42u, session { 42u, 200u, 0u }));
+  REQUIRE (m.size() == 1u);
+  auto s = m.find(42u);
+  REQUIRE (s);
+  REQUIRE (s->expiry == 100u);
+  REQUIRE_FALSE (m.find(43u));
+  REQUIRE_FALSE (m.contains(43u));
+
+  REQUIRE_FALSE (m.insert_or_assign(42u, session { 42u, 300u, 0u }));
+  REQUIRE (m.find(42u)->expiry == 300u);
+  REQUIRE (m.update(42u, [] (session& ss) { ++ss.msg_count; } ));
+  REQUIRE (m.find(42u)->msg_count == 1u);
+  REQUIRE_FALSE (m.update(43u, [] (session& ss) { ++ss.msg_count; } ));
+
+  REQUIRE (m.erase(42u));
+  REQUIRE_FALSE (m.erase(42u));
+  REQUIRE (m.empty());
+}
+
+TEST_CASE ( "Concurrent hash map growth, erasure, and iteration", "[concurrent_hash_map]" ) {
+
+  constexpr std::uint64_t num = 20000u;
+  chops::concurrent_hash_map<std::uint64_t, std::uint64_t> m(8u);
+  for (std::uint64_t i = 0u; i < num; ++i) {
+    REQUIRE (m.insert(i, i * 3u));
+  }
+  REQUIRE (m.size() == num);
+  for (std::uint64_t i = 0u; i < num; ++i) {
+    REQUIRE (m.find(i) == std::optional<std::uint64_t> { i * 3u });
+  }
+  // churn through many deleted markers
+  for (int round = 0; round < 4; ++round) {
+    for (std::uint64_t i = 0u; i < num; i += 2u) {
+      REQUIRE (m.erase(i));
+    }
+    for (std::uint64_t i = 0u; i < num; i += 2u) {
+      REQUIRE (m.insert(i, i * 3u));
+    }
+  }
+  REQUIRE (m.size() == num);
+
+  std::uint64_t sum = 0u;
+  m.for_each([&sum] (std::uint64_t k, std::uint64_t v) { REQUIRE (v == k * 3u); sum += k; } );
+  REQUIRE (sum == num * (num - 1u) / 2u);
+
+  auto erased = chops::erase_where_if(m, [] (std::uint64_t k, std::uint64_t) { return k % 3u == 0u; } );
+  REQUIRE (erased == (num + 2u) / 3u);
+  REQUIRE (m.size() == num - erased);
+  REQUIRE_FALSE (m.contains(9u));
+  REQUIRE (m.contains(10u));
+  REQUIRE (m.erase_if([] (std::uint64_t, std::uint64_t) { return true; }, 4u) == num - erased);
+  REQUIRE (m.empty());
+
+  m.insert(1u, 1u);
+  m.clear();
+  REQUIRE (m.empty());
+  REQUIRE_FALSE (m.contains(1u));
+}
+
+TEST_CASE ( "Concurrent hash map with non trivially copyable types", "[concurrent_hash_map]" ) {
+
+  chops::concurrent_hash_map<std::string, std::vector<int>> m(2u);
+  static_assert (!decltype(m)::lock_free_reads);
+  for (int i = 0; i < 500; ++i) {
+    REQUIRE (m.insert("key_" + std::to_string(i), std::vector<int>(3u, i)));
+  }
+  REQUIRE (m.size() == 500u);
+  REQUIRE (m.find("key_77") == std::optional<std::vector<int>> { std::vector<int> { 77, 77, 77 } });
+  REQUIRE (m.update("key_77", [] (std::vector<int>& v) { v.push_back(0); } ));
+  REQUIRE (m.find("key_77")->size() == 4u);
+  REQUIRE (m.erase("key_77"));
+  REQUIRE (chops::erase_where_if(m, [] (const std::string&, const std::vector<int>& v) { return v[0] < 100; } ) == 99u);
+  REQUIRE (m.size() == 400u);
+}
+
+TEST_CASE ( "Concurrent hash map readers and writers", "[concurrent_hash_map]" ) {
+
+  constexpr std::uint64_t num_keys = 2000u;
+  constexpr int num_writers = 2;
+  constexpr int num_readers = 4;
+  chops::concurrent_hash_map<std::uint64_t, session> m(4u);
+  for (std::uint64_t k = 0u; k < num_keys; k += 2u) {
+    m.insert(k, session { k, static_cast<std::uint32_t>(k), 0u });
+  }
+  std::atomic<bool> done { false };
+  std::atomic<int> bad { 0 };
+  std::vector<std::thread> thrs;
+
+  chops::repeat(num_writers, [&] (int w) {
+    thrs.emplace_back([&, w] {
+      chops::repeat(20000, [&] (int n) {
+        auto k = static_cast<std::uint64_t>((n * 7 + w) % static_cast<int>(num_keys));
+        if (k % 2u == 0u) {
+          m.update(k, [] (session& s) { ++s.msg_count; } );
+        }
+        else if (!m.insert(k, session { k, static_cast<std::uint32_t>(k), 0u })) {
+          m.erase(k);
+        }
+      } );
+    } );
+  } );
+  chops::repeat(num_readers, [&] {
+    thrs.emplace_back([&] {
+      std::uint64_t k = 0u;
+      while (!done.load()) {
+        k = (k + 13u) % num_keys;
+        auto s = m.find(k);
+        if (k % 2u == 0u && !s) {
+          bad.fetch_add(1);
+        }
+        if (s && (s->id != k || s->expiry != static_cast<std::uint32_t>(k))) {
+          bad.fetch_add(1);
+        }
+      }
+    } );
+  } );
+  for (int i = 0; i < num_writers; ++i) {
+    thrs[static_cast<std::size_t>(i)].join();
+  }
+  done.store(true);
+  for (std::size_t i = num_writers; i < thrs.size(); ++i) {
+    thrs[i].join();
+  }
+  REQUIRE (bad.load() == 0);
+  std::uint64_t updates = 0u;
+  m.for_each([&updates] (std::uint64_t, const session& s) { updates += s.msg_count; } );
+  REQUIRE (updates > 0u);
+}
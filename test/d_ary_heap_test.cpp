@@ -0,0 +1,170 @@
+/** @file
+ *
+ * @brief Test scenarios for @c d_ary_heap and @c indexed_priority_queue.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm> // std::sort
+#include <cstdint> // std::uint64_t
+#include <functional> // std::greater
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "utility/d_ary_heap.hpp"
+#include "utility/repeat.hpp"
+
+template <typename H>
+std::vector<int> drain (H& heap) {
+  std::vector<int> out;
+  while (!heap.empty()) {
+    out.push_back(heap.top());
+    heap.pop();
+  }
+  return out;
+}
+
+template <std::size_t D>
+void check_heap_order () {
+  std::mt19937 gen(D);
+  std::uniform_int_distribution<int> dist(0, 999);
+  chops::d_ary_heap<int, D> heap;
+  std::vector<int> ref;
+  chops::repeat(1000, [&] {
+      auto v = dist(gen);
+      heap.push(v);
+      ref.push_back(v);
+    } );
+  REQUIRE (heap.size() == 1000u);
+  REQUIRE (heap.data().size() == 1000u);
+  std::sort(ref.begin(), ref.end(), std::greater<int>());
+  REQUIRE (drain(heap) == ref);
+}
+
+TEST_CASE ( "D-ary heap pops in priority order", "[d_ary_heap]" ) {
+
+  check_heap_order<2>();
+  check_heap_order<3>();
+  check_heap_order<4>();
+  check_heap_order<8>();
+
+  chops::d_ary_heap<int, 4, std::greater<int>> min_heap;
+  for (int v : { 5, 1, 9, 3, 7 }) {
+    min_heap.push(v);
+  }
+  REQUIRE (min_heap.top() == 1);
+  REQUIRE (drain(min_heap) == std::vector<int> { 1, 3, 5, 7, 9 });
+
+  chops::d_ary_heap<std::string, 8> str_heap;
+  str_heap.emplace(3u, 'b');
+  str_heap.push("a");
+  str_heap.push("c");
+  REQUIRE (str_heap.top() == "c");
+  str_heap.pop();
+  REQUIRE (str_heap.top() == "bbb");
+  str_heap.clear();
+  REQUIRE (str_heap.empty());
+}
+
+TEST_CASE ( "Indexed priority queue update and erase by handle", "[d_ary_heap]" ) {
+
+  chops::indexed_priority_queue<int, 4, std::greater<int>> pq;
+  auto a = pq.push(50);
+  auto b = pq.push(20);
+  auto c = pq.push(30);
+  REQUIRE (pq.top() == 20);
+  REQUIRE (pq.top_handle() == b);
+  REQUIRE (*pq.find(c) == 30);
+
+  REQUIRE (pq.update(a, 10)); // decrease key
+  REQUIRE (pq.top_handle() == a);
+  REQUIRE (pq.update(a, 40)); // increase key
+  REQUIRE (pq.top_handle() == b);
+  REQUIRE (pq.update_with(c, [] (int& v) { v -= 25; } ));
+  REQUIRE (pq.top() == 5);
+
+  REQUIRE (pq.erase(c));
+  REQUIRE_FALSE (pq.erase(c));
+  REQUIRE_FALSE (pq.contains(c));
+  REQUIRE_FALSE (pq.update(c, 1));
+  REQUIRE (pq.find(c) == nullptr);
+  REQUIRE (pq.size() == 2u);
+
+  pq.pop();
+  REQUIRE_FALSE (pq.contains(b));
+  REQUIRE (pq.top_handle() == a);
+  auto d = pq.push(1);
+  REQUIRE (d.index() == b.index());
+  REQUIRE_FALSE (pq.contains(b));
+  REQUIRE (pq.top_handle() == d);
+  pq.clear();
+  REQUIRE (pq.empty());
+  REQUIRE_FALSE (pq.contains(a));
+}
+
+TEST_CASE ( "Indexed priority queue random operations match a reference", "[d_ary_heap]" ) {
+
+  std::mt19937 gen(97u);
+  std::uniform_int_distribution<int> dist(0, 100000);
+  chops::indexed_priority_queue<int, 8> pq;
+  std::map<std::uint64_t, int> live; // handle value to priority
+  std::vector<chops::slot_handle> handles;
+
+  int mismatches = 0;
+  chops::repeat(20000, [&] (int i) {
+      auto op = i % 5;
+      if (op < 2 || handles.empty()) {
+        auto v = dist(gen);
+        auto h = pq.push(v);
+        live[h.value()] = v;
+        handles.push_back(h);
+      }
+      else {
+        auto k = static_cast<std::size_t>(dist(gen)) % handles.size();
+        auto h = handles[k];
+        if (op == 2) {
+          auto v = dist(gen);
+          if (pq.update(h, v) != (live.count(h.value()) == 1u)) {
+            ++mismatches;
+          }
+          if (live.count(h.value()) == 1u) {
+            live[h.value()] = v;
+          }
+        }
+        else if (op == 3) {
+          if (pq.erase(h) != (live.erase(h.value()) == 1u)) {
+            ++mismatches;
+          }
+        }
+        else if (!pq.empty()) {
+          auto top = pq.top();
+          auto th = pq.top_handle();
+          int best = -1;
+          for (const auto& [hv, v] : live) {
+            best = (v > best) ? v : best;
+          }
+          if (top != best || live[th.value()] != top) {
+            ++mismatches;
+          }
+          live.erase(th.value());
+          pq.pop();
+        }
+      }
+    } );
+  REQUIRE (mismatches == 0);
+  REQUIRE (pq.size() == live.size());
+  for (const auto& [hv, v] : live) {
+    REQUIRE (*pq.find(chops::slot_handle::from_value(hv)) == v);
+  }
+}
+
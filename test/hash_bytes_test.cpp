@@ -0,0 +1,65 @@
+/** @file
+ *
+ * @brief Test scenarios for @c hash_bytes and related hash functions.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <bit> // std::popcount
+#include <cstddef> // std::byte
+#include <cstdint>
+#include <set>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "utility/hash_bytes.hpp"
+
+TEST_CASE ( "Hash bytes is deterministic and seed dependent", "[hash_bytes]" ) {
+
+  std::string str { "The quick brown fox jumps over the lazy dog" };
+  std::vector<std::byte> bytes;
+  for (auto c : str) {
+    bytes.push_back(static_cast<std::byte>(c));
+  }
+  REQUIRE (chops::hash_bytes(str) == chops::hash_bytes(std::span<const std::byte>(bytes)));
+  REQUIRE (chops::hash_bytes(str, 1u) == chops::hash_bytes(str, 1u));
+  REQUIRE (chops::hash_bytes(str, 1u) != chops::hash_bytes(str, 2u));
+  REQUIRE (chops::hash_bytes(std::string_view { }) == chops::hash_bytes(std::span<const std::byte> { }));
+
+  std::uint64_t val = 0x0123456789abcdefu;
+  REQUIRE (chops::hash_value(val) == chops::hash_value(val));
+  REQUIRE (chops::hash_value(val) != chops::hash_value(val + 1u));
+  REQUIRE (chops::hash_mix(1u) != chops::hash_mix(2u));
+}
+
+TEST_CASE ( "Hash bytes distinguishes every length and position", "[hash_bytes]" ) {
+
+  // every prefix of a buffer, and every single byte change, covers all length paths
+  std::vector<std::byte> buf(200u, std::byte { 0x5a });
+  std::set<std::uint64_t> hashes;
+  for (std::size_t len = 0u; len <= buf.size(); ++len) {
+    hashes.insert(chops::hash_bytes(std::span<const std::byte>(buf.data(), len)));
+  }
+  REQUIRE (hashes.size() == buf.size() + 1u);
+
+  auto base = chops::hash_bytes(std::span<const std::byte>(buf));
+  for (std::size_t i = 0u; i < buf.size(); ++i) {
+    buf[i] ^= std::byte { 1 };
+    auto h = chops::hash_bytes(std::span<const std::byte>(buf));
+    buf[i] ^= std::byte { 1 };
+    REQUIRE (h != base);
+    // a single bit change flips roughly half of the output bits
+    auto diff = std::popcount(h ^ base);
+    REQUIRE (diff > 12);
+    REQUIRE (diff < 52);
+  }
+}
@@ -0,0 +1,152 @@
+/** @file
+ *
+ * @brief Test scenarios for @c intrusive_list and @c list_hook.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <memory> // std::make_unique
+#include <utility> // std::move
+#include <vector>
+
+#include "utility/intrusive_list.hpp"
+#include "utility/erase_where.hpp"
+#include "utility/repeat.hpp"
+
+struct lru_tag { };
+struct idle_tag { };
+
+struct conn : chops::list_hook<lru_tag>,
+              chops::list_hook<idle_tag, chops::link_mode::auto_unlink> {
+  explicit conn(int i) : id(i) { }
+  int id;
+  bool closed { false };
+};
+
+using lru_list = chops::intrusive_list<conn, lru_tag>;
+using idle_list = chops::intrusive_list<conn, idle_tag>;
+
+std::vector<int> ids (const lru_list& lst) {
+  std::vector<int> v;
+  for (const auto& c : lst) {
+    v.push_back(c.id);
+  }
+  return v;
+}
+
+TEST_CASE ( "Intrusive list basic operations", "[intrusive_list]" ) {
+
+  std::vector<conn> conns;
+  conns.reserve(5u);
+  chops::repeat(5, [&conns] (int i) { conns.emplace_back(i); } );
+
+  lru_list lst;
+  REQUIRE (lst.empty());
+  REQUIRE (lst.size() == 0u);
+  for (auto& c : conns) {
+    lst.push_back(c);
+  }
+  REQUIRE (lst.size() == 5u);
+  REQUIRE (lst.front().id == 0);
+  REQUIRE (lst.back().id == 4);
+  REQUIRE (ids(lst) == std::vector<int> { 0, 1, 2, 3, 4 });
+
+  // self unlink, without the list
+  conns[2].chops::list_hook<lru_tag>::unlink();
+  REQUIRE_FALSE (conns[2].chops::list_hook<lru_tag>::is_linked());
+  REQUIRE (ids(lst) == std::vector<int> { 0, 1, 3, 4 });
+
+  lst.move_to_front(conns[3]);
+  lst.move_to_front(conns[2]);
+  REQUIRE (ids(lst) == std::vector<int> { 2, 3, 0, 1, 4 });
+  lst.move_to_back(conns[2]);
+  REQUIRE (ids(lst) == std::vector<int> { 3, 0, 1, 4, 2 });
+
+  lst.pop_front();
+  lst.pop_back();
+  REQUIRE (ids(lst) == std::vector<int> { 0, 1, 4 });
+
+  auto it = lst.insert(lst.iterator_to(conns[4]), conns[3]);
+  REQUIRE (it->id == 3);
+  REQUIRE (ids(lst) == std::vector<int> { 0, 1, 3, 4 });
+  it = lst.erase(lst.iterator_to(conns[1]));
+  REQUIRE (it->id == 3);
+  lst.remove(conns[4]);
+  REQUIRE (ids(lst) == std::vector<int> { 0, 3 });
+  REQUIRE ((--lst.end())->id == 3);
+
+  lst.clear();
+  REQUIRE (lst.empty());
+  for (auto& c : conns) {
+    REQUIRE_FALSE (c.chops::list_hook<lru_tag>::is_linked());
+  }
+}
+
+TEST_CASE ( "Intrusive list, object in two lists, auto unlink and copy", "[intrusive_list]" ) {
+
+  lru_list lru;
+  idle_list idle;
+  {
+    auto a = std::make_unique<conn>(1);
+    auto b = std::make_unique<conn>(2);
+    lru.push_back(*a);
+    lru.push_back(*b);
+    idle.push_back(*a);
+    idle.push_back(*b);
+    REQUIRE (idle.size() == 2u);
+
+    // a copy starts unlinked
+    conn c { *a };
+    REQUIRE_FALSE (c.chops::list_hook<idle_tag, chops::link_mode::auto_unlink>::is_linked());
+
+    lru.remove(*a);
+    a.reset(); // auto unlink from the idle list
+    REQUIRE (idle.size() == 1u);
+    REQUIRE (idle.front().id == 2);
+    lru.clear();
+  }
+  REQUIRE (idle.empty());
+}
+
+TEST_CASE ( "Intrusive list erase_where_if unlinks without destroying", "[intrusive_list]" ) {
+
+  std::vector<conn> conns;
+  conns.reserve(10u);
+  chops::repeat(10, [&conns] (int i) { conns.emplace_back(i); } );
+  lru_list lst;
+  for (auto& c : conns) {
+    c.closed = (c.id % 3 == 0);
+    lst.push_back(c);
+  }
+  auto n = chops::erase_where_if(lst, [] (const conn& c) { return c.closed; } );
+  REQUIRE (n == 4u);
+  REQUIRE (ids(lst) == std::vector<int> { 1, 2, 4, 5, 7, 8 });
+  REQUIRE (conns[3].id == 3); // still alive, only unlinked
+
+  std::vector<int> vec { 1, 2, 3, 4 };
+  chops::erase_where_if(vec, [] (int i) { return i % 2 == 0; } );
+  REQUIRE (vec == std::vector<int> { 1, 3 });
+
+  lru_list moved { std::move(lst) };
+  REQUIRE (lst.empty());
+  REQUIRE (ids(moved) == std::vector<int> { 1, 2, 4, 5, 7, 8 });
+  lru_list other;
+  other.push_back(conns[0]);
+  other.swap(moved);
+  REQUIRE (ids(other) == std::vector<int> { 1, 2, 4, 5, 7, 8 });
+  REQUIRE (ids(moved) == std::vector<int> { 0 });
+  moved = std::move(other);
+  REQUIRE (other.empty());
+  REQUIRE_FALSE (conns[0].chops::list_hook<lru_tag>::is_linked());
+  REQUIRE (moved.size() == 6u);
+  moved.clear();
+}
+
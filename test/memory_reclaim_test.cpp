@@ -0,0 +1,226 @@
+/** @file
+ *
+ * @brief Test scenarios for @c epoch_domain and @c hazard_domain.
+ *
+ * The stress scenarios run a lock-free (Treiber) stack with concurrent pushes and
+ * pops, retiring popped nodes. They are most useful when also run under
+ * ThreadSanitizer or AddressSanitizer, which detect a premature delete.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept> // std::length_error
+#include <thread>
+#include <vector>
+
+#include "utility/memory_reclaim.hpp"
+#include "utility/repeat.hpp"
+
+std::atomic<int> live_nodes { 0 };
+
+struct node {
+  explicit node(int v) : val(v) { ++live_nodes; }
+  ~node() { --live_nodes; }
+  int val;
+  node* next { nullptr };
+};
+
+struct epoch_stack {
+  chops::epoch_domain& domain;
+  std::atomic<node*> head { nullptr };
+
+  void push(int v) {
+    auto* n = new node(v);
+    n->next = head.load();
+    while (!head.compare_exchange_weak(n->next, n)) { }
+  }
+  bool pop(int& v) {
+    node* n;
+    {
+      chops::epoch_guard g(domain);
+      n = head.load();
+      while (n != nullptr && !head.compare_exchange_weak(n, n->next)) { }
+      if (n == nullptr) {
+        return false;
+      }
+      v = n->val;
+    }
+    domain.retire(n);
+    return true;
+  }
+};
+
+struct hazard_stack {
+  chops::hazard_domain& domain;
+  std::atomic<node*> head { nullptr };
+
+  void push(int v) {
+    auto* n = new node(v);
+    n->next = head.load();
+    while (!head.compare_exchange_weak(n->next, n)) { }
+  }
+  bool pop(int& v) {
+    chops::hazard_guard g(domain);
+    for (;;) {
+      node* n = g.protect(head);
+      if (n == nullptr) {
+        return false;
+      }
+      if (head.compare_exchange_strong(n, n->next)) {
+        v = n->val;
+        g.reset();
+        domain.retire(n);
+        return true;
+      }
+    }
+  }
+};
+
+template <typename Stack>
+long stress (Stack& stk) {
+  constexpr int NumThreads = 4;
+  constexpr int NumOps = 20000;
+  std::atomic<long> popped_sum { 0 };
+  std::vector<std::thread> thrs;
+  chops::repeat(NumThreads, [&] (int t) {
+    thrs.emplace_back([&, t] {
+      long sum = 0;
+      chops::repeat(NumOps, [&] (int i) {
+        stk.push(t * NumOps + i);
+        int v;
+        if (stk.pop(v)) {
+          sum += v;
+        }
+      } );
+      popped_sum += sum;
+    } );
+  } );
+  for (auto& thr : thrs) {
+    thr.join();
+  }
+  int v;
+  long rest = 0;
+  while (stk.pop(v)) {
+    rest += v;
+  }
+  long n = static_cast<long>(NumThreads) * NumOps;
+  REQUIRE (popped_sum + rest == n * (n - 1) / 2);
+  return n;
+}
+
+TEST_CASE ( "Epoch guard delays reclamation", "[epoch_domain]" ) {
+
+  live_nodes = 0;
+  chops::epoch_domain domain { 1000u };
+  {
+    chops::epoch_guard g(domain);
+    {
+      chops::epoch_guard nested(domain);
+    }
+    domain.retire(new node(1));
+    domain.collect();
+    domain.collect();
+    REQUIRE (live_nodes == 1);
+    REQUIRE (domain.stats().pending() == 1u);
+  }
+  REQUIRE (domain.collect() == 1u);
+  REQUIRE (live_nodes == 0);
+  auto st = domain.stats();
+  REQUIRE (st.retired == 1u);
+  REQUIRE (st.reclaimed == 1u);
+  REQUIRE (st.max_latency >= st.mean_latency);
+  REQUIRE (st.max_latency.count() > 0);
+}
+
+TEST_CASE ( "Epoch domain reclaims inline in batches", "[epoch_domain]" ) {
+
+  live_nodes = 0;
+  {
+    chops::epoch_domain domain { 16u };
+    chops::repeat(100, [&domain] (int i) { domain.retire(new node(i)); } );
+    REQUIRE (domain.stats().reclaimed > 0u);
+    REQUIRE (live_nodes < 100);
+  }
+  REQUIRE (live_nodes == 0);
+}
+
+TEST_CASE ( "Epoch domain reclaims in the background", "[epoch_domain]" ) {
+
+  live_nodes = 0;
+  chops::epoch_domain domain { 16u, std::chrono::milliseconds { 1 } };
+  chops::repeat(100, [&domain] (int i) { domain.retire(new node(i)); } );
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (live_nodes != 0 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  REQUIRE (live_nodes == 0);
+  REQUIRE (domain.stats().reclaimed == 100u);
+}
+
+TEST_CASE ( "Epoch domain stress with a lock-free stack", "[epoch_domain] [concurrent]" ) {
+
+  live_nodes = 0;
+  {
+    chops::epoch_domain domain;
+    epoch_stack stk { domain };
+    auto n = stress(stk);
+    REQUIRE (domain.stats().retired == static_cast<std::uint64_t>(n));
+  }
+  REQUIRE (live_nodes == 0);
+}
+
+TEST_CASE ( "Hazard pointer protects an object from reclamation", "[hazard_domain]" ) {
+
+  live_nodes = 0;
+  chops::hazard_domain domain { 2u, 1000u };
+  std::atomic<node*> src { new node(1) };
+  {
+    chops::hazard_guard g(domain);
+    auto* p = g.protect(src);
+    REQUIRE (p->val == 1);
+    src = nullptr;
+    domain.retire(p);
+    REQUIRE (domain.collect() == 0u);
+    REQUIRE (live_nodes == 1);
+    {
+      chops::hazard_guard g2(domain);
+      REQUIRE_THROWS_AS (chops::hazard_guard(domain), std::length_error);
+    }
+    g.reset();
+    REQUIRE (domain.collect() == 1u);
+  }
+  REQUIRE (live_nodes == 0);
+  REQUIRE (domain.stats().pending() == 0u);
+}
+
+TEST_CASE ( "Hazard domain bounds pending objects per thread", "[hazard_domain]" ) {
+
+  live_nodes = 0;
+  chops::hazard_domain domain { 1u, 8u };
+  chops::repeat(100, [&domain] (int i) {
+    domain.retire(new node(i));
+    REQUIRE (live_nodes < 8);
+  } );
+}
+
+TEST_CASE ( "Hazard domain stress with a lock-free stack", "[hazard_domain] [concurrent]" ) {
+
+  live_nodes = 0;
+  {
+    chops::hazard_domain domain;
+    hazard_stack stk { domain };
+    auto n = stress(stk);
+    REQUIRE (domain.stats().retired == static_cast<std::uint64_t>(n));
+  }
+  REQUIRE (live_nodes == 0);
+}
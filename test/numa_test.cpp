@@ -0,0 +1,115 @@
+/** @file
+ *
+ * @brief Test scenarios for thread affinity and NUMA utilities.
+ *
+ * The machine running the tests may have one or several NUMA nodes, and may restrict
+ * the system calls (e.g. in a container), so the tests check consistency rather
+ * than specific topologies.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "utility/numa.hpp"
+
+TEST_CASE ( "Linux CPU lists are parsed", "[parse_cpu_list]" ) {
+  REQUIRE (chops::parse_cpu_list("0") == (std::vector<unsigned> { 0u }));
+  REQUIRE (chops::parse_cpu_list("0-3,8,10-11\n") == (std::vector<unsigned> { 0u, 1u, 2u, 3u, 8u, 10u, 11u }));
+  REQUIRE (chops::parse_cpu_list("4,2,2-3") == (std::vector<unsigned> { 2u, 3u, 4u }));
+  REQUIRE (chops::parse_cpu_list("x,5-3,7") == (std::vector<unsigned> { 7u }));
+  REQUIRE (chops::parse_cpu_list("").empty());
+  // ids beyond an affinity mask are skipped rather than expanded
+  REQUIRE (chops::parse_cpu_list("0-4000000000,1") == (std::vector<unsigned> { 1u }));
+  REQUIRE (chops::parse_cpu_list("4294967294-4294967295,2") == (std::vector<unsigned> { 2u }));
+  REQUIRE (chops::parse_cpu_list("1000000").empty());
+}
+
+TEST_CASE ( "NUMA topology is read from a sys style directory", "[numa_topology]" ) {
+
+  SECTION ( "A two node layout, including a memory-only node" ) {
+    auto dir = std::filesystem::temp_directory_path() / "chops_numa_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "node0");
+    std::filesystem::create_directories(dir / "node1");
+    std::filesystem::create_directories(dir / "node2");
+    std::filesystem::create_directories(dir / "power");
+    std::ofstream(dir / "node0" / "cpulist") << "0-1,4\n";
+    std::ofstream(dir / "node1" / "cpulist") << "\n";
+    std::ofstream(dir / "node2" / "cpulist") << "2-3\n";
+
+    chops::numa_topology topo(dir);
+    REQUIRE (topo.node_count() == 3u);
+    REQUIRE (topo.cpus_of_node(0u).size() == 3u);
+    REQUIRE (topo.cpus_of_node(1u).empty());
+    REQUIRE (topo.cpus_of_node(2u)[1] == 3u);
+    REQUIRE (topo.cpus_of_node(7u).empty());
+    REQUIRE (topo.node_of_cpu(4u) == 0u);
+    REQUIRE (topo.node_of_cpu(2u) == 2u);
+    std::filesystem::remove_all(dir);
+  }
+  SECTION ( "A missing directory reports one node with all hardware threads" ) {
+    chops::numa_topology topo("/no/such/directory");
+    REQUIRE (topo.node_count() == 1u);
+    REQUIRE (topo.cpus_of_node(0u).size() >= 1u);
+  }
+  SECTION ( "The system topology contains the current CPU" ) {
+    const auto& topo = chops::system_numa_topology();
+    REQUIRE (topo.node_count() >= 1u);
+    auto node = topo.node_of_cpu(chops::current_cpu());
+    REQUIRE (node < topo.node_count());
+  }
+}
+
+TEST_CASE ( "Threads are pinned to CPUs", "[pin_thread]" ) {
+
+  std::atomic<unsigned> cpu { 0u };
+  std::atomic<bool> pinned { false };
+  std::thread thr ( [&] {
+    cpu = chops::current_cpu();
+    pinned = chops::pin_current_thread(cpu.load());
+    if (pinned) {
+      cpu = chops::current_cpu();
+    }
+  } );
+  thr.join();
+#if defined(__linux__)
+  REQUIRE (pinned);
+#else
+  REQUIRE_FALSE (pinned);
+#endif
+  REQUIRE_FALSE (chops::pin_current_thread(std::span<const unsigned>()));
+}
+
+struct node_stats {
+  explicit node_stats(int start) : count(start) { }
+  int count;
+};
+
+TEST_CASE ( "numa_local creates one instance per node", "[numa_local]" ) {
+
+  chops::numa_local<node_stats> stats { 10 };
+  REQUIRE (stats.size() == chops::system_numa_topology().node_count());
+  stats.local().count += 5;
+  int total = 0;
+  stats.for_each([&total] (node_stats& s) { total += s.count; } );
+  REQUIRE (total == static_cast<int>(stats.size()) * 10 + 5);
+  REQUIRE (stats[0].count >= 10);
+
+  // the binding may be refused, e.g. in a container, but must not disturb the memory
+  chops::numa_local<std::vector<int>> vecs { 100u, 7 };
+  REQUIRE (vecs.local().size() == 100u);
+  REQUIRE (vecs.local()[99] == 7);
+}
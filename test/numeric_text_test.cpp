@@ -0,0 +1,142 @@
+/** @file
+ *
+ * @brief Test scenarios for @c append_decimal, @c append_hex, @c append_fixed and the
+ * corresponding parse functions.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <array>
+#include <cstddef> // std::byte
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "utility/numeric_text.hpp"
+#include "utility/cast_ptr_to.hpp"
+
+std::string_view as_str (std::span<const std::byte> sp) {
+  return std::string_view(chops::cast_ptr_to<char>(sp.data()), sp.size());
+}
+
+std::span<const std::byte> as_bytes (std::string_view str) {
+  return std::span<const std::byte>(chops::cast_ptr_to<std::byte>(str.data()), str.size());
+}
+
+template <typename T>
+void check_decimal_round_trip (T val) {
+  std::array<std::byte, 24> buf;
+  auto n = chops::append_decimal(buf, val);
+  REQUIRE (as_str(std::span<const std::byte>(buf.data(), n)) == std::to_string(val));
+  REQUIRE (chops::parse_decimal<T>(std::span<const std::byte>(buf.data(), n)) == val);
+}
+
+TEST_CASE ( "Integers are formatted in decimal and parsed back", "[append_decimal] [parse_decimal]" ) {
+
+  SECTION ( "Boundary values round trip for several integer types" ) {
+    for (std::uint64_t p = 1u; p < 10000000000000000000ull; p *= 10u) {
+      check_decimal_round_trip(p - 1u);
+      check_decimal_round_trip(p);
+      check_decimal_round_trip(p + 1u);
+    }
+    check_decimal_round_trip(std::numeric_limits<std::uint64_t>::max());
+    check_decimal_round_trip(std::numeric_limits<std::int64_t>::min());
+    check_decimal_round_trip(std::numeric_limits<std::int64_t>::max());
+    check_decimal_round_trip(std::numeric_limits<int>::min());
+    check_decimal_round_trip(-1);
+    check_decimal_round_trip(0);
+    check_decimal_round_trip(std::uint16_t{65535u});
+    check_decimal_round_trip(std::int8_t{-128});
+  }
+  SECTION ( "A span that is too small is not written" ) {
+    std::array<std::byte, 3> buf { };
+    REQUIRE (chops::append_decimal(buf, 1234) == 0u);
+    REQUIRE (chops::append_decimal(buf, -12) == 3u);
+    REQUIRE (as_str(buf) == "-12");
+  }
+  SECTION ( "Values are appended to a byte vector" ) {
+    std::vector<std::byte> vec;
+    chops::append_decimal(vec, 42);
+    chops::append_decimal(vec, -7L);
+    chops::append_decimal(vec, 123456789012345ull);
+    REQUIRE (as_str(vec) == "42-7123456789012345");
+  }
+  SECTION ( "Malformed or out of range text is rejected" ) {
+    REQUIRE_FALSE (chops::parse_decimal<int>(as_bytes("")));
+    REQUIRE_FALSE (chops::parse_decimal<int>(as_bytes("-")));
+    REQUIRE_FALSE (chops::parse_decimal<int>(as_bytes("12a")));
+    REQUIRE_FALSE (chops::parse_decimal<int>(as_bytes("1234567x9")));
+    REQUIRE_FALSE (chops::parse_decimal<int>(as_bytes("12345678901")));
+    REQUIRE_FALSE (chops::parse_decimal<unsigned>(as_bytes("-1")));
+    REQUIRE_FALSE (chops::parse_decimal<std::int8_t>(as_bytes("128")));
+    REQUIRE_FALSE (chops::parse_decimal<std::uint64_t>(as_bytes("18446744073709551616")));
+    REQUIRE_FALSE (chops::parse_decimal<std::uint64_t>(as_bytes("123456789012345678901234")));
+    REQUIRE (chops::parse_decimal<std::int8_t>(as_bytes("-128")) == -128);
+    REQUIRE (chops::parse_decimal<int>(as_bytes("0000000000000042")) == 42);
+  }
+}
+
+TEST_CASE ( "Unsigned integers are formatted in hex and parsed back", "[append_hex] [parse_hex]" ) {
+
+  std::array<std::byte, 16> buf;
+  SECTION ( "Hex formatting is lower case with no prefix" ) {
+    REQUIRE (as_str(std::span(buf.data(), chops::append_hex(buf, 0u))) == "0");
+    REQUIRE (as_str(std::span(buf.data(), chops::append_hex(buf, 0xbeefu))) == "beef");
+    auto n = chops::append_hex(buf, std::numeric_limits<std::uint64_t>::max());
+    REQUIRE (as_str(std::span(buf.data(), n)) == "ffffffffffffffff");
+    REQUIRE (chops::parse_hex<std::uint64_t>(std::span<const std::byte>(buf.data(), n)) == 
+             std::numeric_limits<std::uint64_t>::max());
+  }
+  SECTION ( "Hex parsing accepts either case and rejects bad input" ) {
+    REQUIRE (chops::parse_hex<unsigned>(as_bytes("DeadBeef")) == 0xdeadbeefu);
+    REQUIRE_FALSE (chops::parse_hex<unsigned>(as_bytes("0x10")));
+    REQUIRE_FALSE (chops::parse_hex<std::uint8_t>(as_bytes("100")));
+    REQUIRE (chops::parse_hex<std::uint8_t>(as_bytes("00ff")) == 255u);
+    REQUIRE (chops::parse_hex<std::uint16_t>(as_bytes("0000000000001234")) == 0x1234u);
+    REQUIRE (chops::parse_hex<std::uint8_t>(as_bytes("000")) == 0u);
+    REQUIRE_FALSE (chops::parse_hex<std::uint8_t>(as_bytes("0100")));
+    REQUIRE_FALSE (chops::parse_hex<std::uint8_t>(as_bytes("00g")));
+    REQUIRE_FALSE (chops::parse_hex<unsigned>(as_bytes("")));
+  }
+  SECTION ( "Hex values are appended to a byte vector" ) {
+    std::vector<std::byte> vec;
+    chops::append_hex(vec, std::uint8_t{0x0au});
+    chops::append_hex(vec, 0x1234u);
+    REQUIRE (as_str(vec) == "a1234");
+  }
+}
+
+TEST_CASE ( "Doubles are formatted in fixed notation and parsed back", "[append_fixed] [parse_fixed]" ) {
+
+  std::array<std::byte, 32> buf;
+  SECTION ( "Precision controls the digits after the decimal point" ) {
+    REQUIRE (as_str(std::span(buf.data(), chops::append_fixed(buf, 3.14159, 2))) == "3.14");
+    REQUIRE (as_str(std::span(buf.data(), chops::append_fixed(buf, -0.5, 3))) == "-0.500");
+    REQUIRE (as_str(std::span(buf.data(), chops::append_fixed(buf, 42.0, 0))) == "42");
+    REQUIRE (chops::append_fixed(buf, 1.0e40, 2) == 0u);
+  }
+  SECTION ( "Fixed values are appended to a byte vector, including very large values" ) {
+    std::vector<std::byte> vec;
+    chops::append_fixed(vec, 1.25, 2);
+    REQUIRE (as_str(vec) == "1.25");
+    chops::append_fixed(vec, 1.0e40, 1);
+    REQUIRE (vec.size() == 4u + 41u + 2u);
+  }
+  SECTION ( "Fixed text is parsed" ) {
+    REQUIRE (chops::parse_fixed(as_bytes("3.25")) == 3.25);
+    REQUIRE (chops::parse_fixed(as_bytes("-100")) == -100.0);
+    REQUIRE_FALSE (chops::parse_fixed(as_bytes("1.5x")));
+    REQUIRE_FALSE (chops::parse_fixed(as_bytes("")));
+  }
+}
@@ -0,0 +1,155 @@
+/** @file
+ *
+ * @brief Test scenarios for the parallel algorithms in @c parallel.hpp.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <cstddef> // std::size_t
+#include <functional> // std::plus
+#include <numeric> // std::iota
+#include <stdexcept>
+#include <string>
+#include <thread> // std::this_thread::yield
+#include <vector>
+
+#include "utility/parallel.hpp"
+#include "utility/repeat.hpp"
+#include "utility/thread_pool.hpp"
+
+TEST_CASE ( "Parallel chunks cover the range once", "[parallel]" ) {
+
+  chops::thread_pool pool(3u, false);
+  for (std::size_t n : { 0u, 1u, 7u, 1000u, 10007u }) {
+    for (std::size_t grain : { 0u, 1u, 13u, 5000u }) {
+      std::vector<std::atomic<int>> hits(n);
+      std::vector<std::atomic<int>> in_use(chops::par_participants(pool));
+      std::atomic<int> errors { 0 };
+      chops::par_for_chunks(pool, n, { .grain = grain }, [&] (std::size_t b, std::size_t e, std::size_t p) {
+          if (p >= in_use.size() || in_use[p].fetch_add(1) != 0 || b >= e || (grain != 0u && e - b > grain)) {
+            ++errors;
+          }
+          for (auto i = b; i < e; ++i) {
+            ++hits[i];
+          }
+          --in_use[p];
+        } );
+      REQUIRE (errors == 0);
+      for (const auto& h : hits) {
+        REQUIRE (h == 1);
+      }
+    }
+  }
+}
+
+TEST_CASE ( "Parallel for_each, transform and repeat", "[parallel]" ) {
+
+  chops::thread_pool pool(4u);
+  std::vector<int> v(10000);
+  std::iota(v.begin(), v.end(), 0);
+
+  chops::par_for_each(pool, v, [] (int& x) { x *= 2; } );
+  for (std::size_t i = 0u; i < v.size(); ++i) {
+    REQUIRE (v[i] == static_cast<int>(2u * i));
+  }
+
+  std::vector<std::string> out(v.size());
+  auto it = chops::par_transform(pool, v, out.begin(), [] (int x) { return std::to_string(x); }, { .grain = 64u } );
+  REQUIRE (it == out.end());
+  REQUIRE (out[4999] == "9998");
+
+  std::vector<std::atomic<int>> seen(500);
+  chops::repeat_par(pool, 500, [&seen] (int i) { ++seen[static_cast<std::size_t>(i)]; } );
+  std::atomic<int> calls { 0 };
+  chops::repeat_par(pool, 500, [&calls] { ++calls; } );
+  REQUIRE (calls == 500);
+  for (const auto& s : seen) {
+    REQUIRE (s == 1);
+  }
+
+  // default pool overloads
+  chops::par_for_each(v, [] (int& x) { x /= 2; } );
+  REQUIRE (v[9999] == 9999);
+}
+
+TEST_CASE ( "Parallel reduce, deterministic and not", "[parallel]" ) {
+
+  std::vector<double> v(100000);
+  for (std::size_t i = 0u; i < v.size(); ++i) {
+    v[i] = 1.0 / static_cast<double>(i + 1u);
+  }
+  chops::thread_pool pool1(1u, false);
+  chops::thread_pool pool4(4u, false);
+  chops::thread_pool pool7(7u, false);
+
+  auto d1 = chops::par_reduce(pool1, v, 0.0, std::plus<> { }, { .deterministic = true } );
+  auto d4 = chops::par_reduce(pool4, v, 0.0, std::plus<> { }, { .deterministic = true } );
+  auto d7 = chops::par_reduce(pool7, v, 0.0, std::plus<> { }, { .deterministic = true } );
+  REQUIRE (d1 == d4); // bitwise equal
+  REQUIRE (d1 == d7);
+  auto nd = chops::par_reduce(pool4, v, 0.0, std::plus<> { } );
+  REQUIRE (nd > d1 - 1e-9);
+  REQUIRE (nd < d1 + 1e-9);
+
+  std::vector<long> ints(12345);
+  std::iota(ints.begin(), ints.end(), 1L);
+  REQUIRE (chops::par_reduce(pool7, ints, 10L, std::plus<> { }, { .grain = 100u } ) == 10L + 12345L * 12346L / 2L);
+  REQUIRE (chops::par_reduce(ints, 0L, std::plus<> { } ) == 12345L * 12346L / 2L);
+  std::vector<long> empty;
+  REQUIRE (chops::par_reduce(pool4, empty, 7L, std::plus<> { } ) == 7L);
+
+  // order preserving, non commutative op
+  std::vector<std::string> words { "a", "b", "c", "d", "e", "f", "g", "h", "i", "j" };
+  REQUIRE (chops::par_reduce(pool4, words, std::string { }, std::plus<> { }, { .grain = 1u, .deterministic = true } ) == "abcdefghij");
+
+  // associative but not commutative, without the deterministic option
+  chops::thread_pool pool8(8u, false);
+  std::vector<std::string> nums(2000);
+  std::string concat;
+  for (std::size_t i = 0u; i < nums.size(); ++i) {
+    nums[i] = std::to_string(i) + ",";
+    concat += nums[i];
+  }
+  // yielding in the op makes threads interleave and steal chunks even on one core
+  auto cat = [] (std::string a, const std::string& b) {
+      std::this_thread::yield();
+      return a + b;
+    };
+  chops::repeat(20, [&] {
+      REQUIRE (chops::par_reduce(pool8, nums, std::string { }, cat) == concat);
+      REQUIRE (chops::par_reduce(pool8, nums, std::string { }, cat, { .grain = 7u } ) == concat);
+    } );
+}
+
+TEST_CASE ( "Parallel algorithms propagate exceptions and nest", "[parallel]" ) {
+
+  chops::thread_pool pool(3u);
+  std::vector<int> v(1000, 1);
+  REQUIRE_THROWS_AS (chops::par_for_each(pool, v, [&v] (int& x) {
+      if (&x - v.data() == 500) {
+        throw std::runtime_error("bad element");
+      }
+    }, { .grain = 10u } ), std::runtime_error);
+
+  // nested loops from pool workers complete even with every worker busy
+  std::atomic<int> total { 0 };
+  chops::repeat_par(pool, 8, [&] {
+      chops::repeat_par(pool, 100, [&] { ++total; }, { .grain = 10u } );
+    }, { .grain = 1u } );
+  REQUIRE (total == 800);
+
+  auto fut = pool.submit([&pool, &v] {
+      return chops::par_reduce(pool, v, 0, std::plus<> { }, { .grain = 16u } );
+    } );
+  REQUIRE (fut.get() == 1000);
+}
+
@@ -0,0 +1,157 @@
+/** @file
+ *
+ * @brief Test scenarios for the pseudo random number generators and the bounded
+ * integer and floating point helpers.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm> // std::shuffle, std::sort
+#include <array>
+#include <concepts> // std::uniform_random_bit_generator
+#include <cstddef> // std::byte
+#include <cstdint>
+#include <limits>
+#include <random> // std::uniform_int_distribution
+#include <span>
+#include <vector>
+
+#include "utility/random.hpp"
+#include "utility/repeat.hpp"
+
+static_assert (std::uniform_random_bit_generator<chops::xoshiro256ss>);
+static_assert (std::uniform_random_bit_generator<chops::wyrand>);
+
+TEST_CASE ( "Xoshiro256** reference output and jump", "[random] [xoshiro256ss]" ) {
+
+  // reference values from the published algorithm
+  chops::xoshiro256ss gen { std::array<std::uint64_t, 4u> { 1u, 2u, 3u, 4u } };
+  REQUIRE (gen() == 11520u);
+  REQUIRE (gen() == 0u);
+  REQUIRE (gen() == 1509978240u);
+  REQUIRE (gen() == 1215971899390074240u);
+
+  chops::xoshiro256ss a { 42u };
+  chops::xoshiro256ss b { 42u };
+  REQUIRE (a == b);
+  b.discard(10u);
+  chops::repeat(10, [&a] { a(); } );
+  REQUIRE (a == b);
+  REQUIRE (a() == b());
+
+  chops::xoshiro256ss c { 42u };
+  c.jump();
+  REQUIRE (c != a);
+  chops::xoshiro256ss d { 42u };
+  d.long_jump();
+  REQUIRE (d != c);
+  REQUIRE (c() != d());
+}
+
+TEST_CASE ( "Wyrand generator and constant time discard", "[random] [wyrand]" ) {
+
+  chops::wyrand a { 7u };
+  chops::wyrand b { 7u };
+  std::vector<std::uint64_t> vals;
+  chops::repeat(1000, [&] { vals.push_back(a()); } );
+  b.discard(1000u);
+  REQUIRE (a == b);
+  std::sort(vals.begin(), vals.end());
+  REQUIRE (std::adjacent_find(vals.begin(), vals.end()) == vals.end());
+  chops::wyrand c { 7u };
+  c.jump();
+  chops::wyrand e { 7u };
+  e.discard(1ull << 48u);
+  REQUIRE (c == e);
+}
+
+TEST_CASE ( "Four stream generator matches jumped scalar streams", "[random] [xoshiro256ss_x4]" ) {
+
+  chops::xoshiro256ss_x4 x4 { 99u };
+  std::vector<std::uint64_t> words(4u * 50u + 3u);
+  x4.fill(std::span<std::uint64_t>(words));
+
+  chops::xoshiro256ss gen { 99u };
+  for (std::size_t lane = 0u; lane < 4u; ++lane) {
+    auto lane_gen = gen;
+    for (std::size_t i = lane; i < words.size(); i += 4u) {
+      REQUIRE (words[i] == lane_gen());
+    }
+    gen.jump();
+  }
+
+  chops::xoshiro256ss_x4 y4 { 99u };
+  std::vector<std::byte> bytes(words.size() * 8u - 5u);
+  chops::fill_random(bytes, y4);
+  for (std::size_t i = 0u; i < bytes.size(); ++i) {
+    REQUIRE (bytes[i] == static_cast<std::byte>(words[i / 8u] >> ((i % 8u) * 8u)));
+  }
+}
+
+TEST_CASE ( "Fill bytes from a scalar generator", "[random]" ) {
+
+  chops::wyrand a { 3u };
+  chops::wyrand b { 3u };
+  std::vector<std::byte> bytes(21u);
+  chops::fill_random(bytes, a);
+  for (std::size_t i = 0u; i < bytes.size(); i += 8u) {
+    auto w = b();
+    for (std::size_t j = i; j < i + 8u && j < bytes.size(); ++j) {
+      REQUIRE (bytes[j] == static_cast<std::byte>(w >> ((j - i) * 8u)));
+    }
+  }
+}
+
+TEST_CASE ( "Bounded integers and floating point values", "[random]" ) {
+
+  chops::xoshiro256ss gen { 1234u };
+  std::array<int, 6> counts { };
+  constexpr int draws = 60000;
+  chops::repeat(draws, [&] {
+    auto v = chops::uniform_int(gen, 1, 6);
+    REQUIRE (v >= 1);
+    REQUIRE (v <= 6);
+    ++counts[static_cast<std::size_t>(v - 1)];
+  } );
+  for (auto c : counts) {
+    REQUIRE (c > 9400);
+    REQUIRE (c < 10600);
+  }
+  REQUIRE (chops::uniform_below(gen, 1u) == 0u);
+  chops::repeat(1000, [&gen] {
+    auto v = chops::uniform_int(gen, -5, -3);
+    REQUIRE (v >= -5);
+    REQUIRE (v <= -3);
+    auto big = chops::uniform_int(gen, std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max());
+    (void) big;
+    auto b = chops::uniform_int(gen, std::uint8_t { 250u }, std::uint8_t { 255u });
+    REQUIRE (b >= 250u);
+    auto d = chops::uniform_double(gen);
+    REQUIRE (d >= 0.0);
+    REQUIRE (d < 1.0);
+    auto f = chops::uniform_float(gen);
+    REQUIRE (f >= 0.0f);
+    REQUIRE (f < 1.0f);
+    auto r = chops::uniform_real(gen, -2.5, 2.5);
+    REQUIRE (r >= -2.5);
+    REQUIRE (r < 2.5);
+  } );
+
+  // usable with standard algorithms and distributions
+  std::vector<int> vec { 1, 2, 3, 4, 5, 6, 7, 8 };
+  std::shuffle(vec.begin(), vec.end(), gen);
+  std::sort(vec.begin(), vec.end());
+  REQUIRE (vec == std::vector<int> { 1, 2, 3, 4, 5, 6, 7, 8 });
+  std::uniform_int_distribution<int> dist(0, 9);
+  auto v = dist(gen);
+  REQUIRE (v >= 0);
+  REQUIRE (v <= 9);
+}
@@ -0,0 +1,202 @@
+/** @file
+ *
+ * @brief Test scenarios for @c token_bucket, @c sliding_window_limiter, and
+ * @c keyed_rate_limiter.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "utility/rate_limiter.hpp"
+#include "utility/tsc_clock.hpp"
+#include "utility/repeat.hpp"
+
+namespace {
+
+// counter value a number of seconds after t0
+std::uint64_t after(std::uint64_t t0, double secs) {
+  return t0 + static_cast<std::uint64_t>(secs * chops::tsc_clock::frequency());
+}
+
+}
+
+TEST_CASE ( "Token bucket burst and refill", "[token_bucket]" ) {
+
+  chops::token_bucket tb(100.0, 10.0);
+  REQUIRE (tb.rate() == 100.0);
+  REQUIRE (tb.burst() == 10.0);
+  auto t0 = chops::tsc_clock::ticks();
+
+  int allowed = 0;
+  chops::repeat(20, [&] { allowed += tb.try_acquire(1u, t0) ? 1 : 0; } );
+  REQUIRE (allowed == 10);
+
+  // 50 ms refills 5 tokens
+  allowed = 0;
+  chops::repeat(20, [&] { allowed += tb.try_acquire(1u, after(t0, 0.0505)) ? 1 : 0; } );
+  REQUIRE (allowed == 5);
+
+  // a long idle period refills only up to the burst size
+  REQUIRE (!tb.try_acquire(11u, after(t0, 100.0)));
+  REQUIRE (tb.try_acquire(10u, after(t0, 100.0)));
+  REQUIRE (!tb.try_acquire(1u, after(t0, 100.0)));
+}
+
+TEST_CASE ( "Token bucket rate is accurate with frequent calls", "[token_bucket]" ) {
+
+  chops::token_bucket tb(1000.0, 1.0);
+  auto t0 = chops::tsc_clock::ticks();
+  int allowed = 0;
+  // one call per 3 microseconds for one second
+  for (int i = 0; i < 333333; ++i) {
+    allowed += tb.try_acquire(1u, after(t0, i * 3e-6)) ? 1 : 0;
+  }
+  REQUIRE (allowed >= 990);
+  REQUIRE (allowed <= 1001);
+}
+
+TEST_CASE ( "Token bucket invalid parameters", "[token_bucket]" ) {
+
+  REQUIRE_THROWS_AS (chops::token_bucket(0.0, 10.0), std::invalid_argument);
+  REQUIRE_THROWS_AS (chops::token_bucket(10.0, 0.5), std::invalid_argument);
+  REQUIRE_THROWS_AS (chops::token_bucket(10.0, 100000.0), std::invalid_argument);
+  REQUIRE_THROWS_AS (chops::sliding_window_limiter(0u, std::chrono::seconds(1)), std::invalid_argument);
+  REQUIRE_THROWS_AS (chops::sliding_window_limiter(2000000u, std::chrono::seconds(1)), std::invalid_argument);
+}
+
+TEST_CASE ( "Token bucket shared by several threads", "[token_bucket]" ) {
+
+  constexpr int num_threads = 4;
+  chops::token_bucket tb(1.0, 1000.0);
+  auto t0 = chops::tsc_clock::ticks();
+  std::atomic<int> allowed { 0 };
+  std::vector<std::thread> thrs;
+  for (int i = 0; i < num_threads; ++i) {
+    thrs.emplace_back([&tb, &allowed, t0] {
+      int n = 0;
+      chops::repeat(1000, [&] { n += tb.try_acquire(1u, t0) ? 1 : 0; } );
+      allowed.fetch_add(n);
+    } );
+  }
+  for (auto& thr : thrs) {
+    thr.join();
+  }
+  REQUIRE (allowed.load() == 1000);
+}
+
+TEST_CASE ( "Sliding window limiter", "[sliding_window_limiter]" ) {
+
+  chops::sliding_window_limiter sw(100u, std::chrono::seconds(1));
+  REQUIRE (sw.limit() == 100u);
+  auto w = sw.window_ticks();
+  // start of a window
+  auto t0 = (chops::tsc_clock::ticks() / w + 1u) * w;
+
+  int allowed = 0;
+  chops::repeat(150, [&] { allowed += sw.try_acquire(1u, t0) ? 1 : 0; } );
+  REQUIRE (allowed == 100);
+
+  // a quarter into the next window, 75% of the previous window still counts (offsets
+  // rounded up, so the overlap is not above the exact fraction)
+  allowed = 0;
+  chops::repeat(150, [&] { allowed += sw.try_acquire(1u, t0 + w + (w + 3u) / 4u) ? 1 : 0; } );
+  REQUIRE (allowed == 25);
+
+  // three quarters in, another 50 are allowed
+  allowed = 0;
+  chops::repeat(150, [&] { allowed += sw.try_acquire(1u, t0 + w + (3u * w + 3u) / 4u) ? 1 : 0; } );
+  REQUIRE (allowed == 50);
+
+  // after two empty windows the full limit is available
+  allowed = 0;
+  chops::repeat(150, [&] { allowed += sw.try_acquire(1u, t0 + 3u * w) ? 1 : 0; } );
+  REQUIRE (allowed == 100);
+  REQUIRE (!sw.try_acquire(1u, t0 + 3u * w + w / 2u));
+}
+
+TEST_CASE ( "Rate limiters after long idle periods", "[token_bucket][sliding_window_limiter]" ) {
+
+  // idle periods past half the time stamp wrap period refill the bucket
+  auto t0 = chops::tsc_clock::ticks();
+  for (double days : { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 }) {
+    chops::token_bucket tb(1.0, 1.0);
+    REQUIRE (tb.try_acquire(1u, t0));
+    REQUIRE (!tb.try_acquire(1u, t0));
+    REQUIRE (tb.try_acquire(1u, after(t0, days * 86400.0)));
+  }
+  // a counter value read slightly before the last update leaves the state unchanged
+  chops::token_bucket tb(1.0, 1.0);
+  REQUIRE (tb.try_acquire(1u, after(t0, 10.0)));
+  REQUIRE (!tb.try_acquire(1u, after(t0, 9.999)));
+  REQUIRE (!tb.try_acquire(1u, after(t0, 10.0)));
+
+  chops::sliding_window_limiter sw(10u, std::chrono::milliseconds(1));
+  auto w = sw.window_ticks();
+  auto s0 = (t0 / w + 1u) * w;
+  REQUIRE (sw.try_acquire(10u, s0));
+  REQUIRE (!sw.try_acquire(1u, s0));
+  // one window back is treated as the current window
+  REQUIRE (!sw.try_acquire(1u, s0 - w / 2u));
+  for (double hours : { 2.5, 3.0, 4.0 }) {
+    auto t = (after(s0, hours * 3600.0) / w) * w;
+    REQUIRE (sw.try_acquire(10u, t));
+    REQUIRE (!sw.try_acquire(1u, t));
+  }
+}
+
+TEST_CASE ( "Keyed rate limiter", "[keyed_rate_limiter]" ) {
+
+  chops::keyed_rate_limiter<std::uint64_t> kl(chops::token_bucket(10.0, 5.0), 8u);
+  auto t0 = chops::tsc_clock::ticks();
+  int allowed = 0;
+  for (std::uint64_t key = 0u; key < 1000u; ++key) {
+    chops::repeat(8, [&] { allowed += kl.try_acquire(key, 1u, t0) ? 1 : 0; } );
+  }
+  REQUIRE (allowed == 5000);
+  REQUIRE (kl.size() == 1000u);
+
+  // keys are independent
+  REQUIRE (!kl.try_acquire(7u, 1u, t0));
+  REQUIRE (kl.try_acquire(1000u, 1u, t0));
+
+  // partially refilled buckets are kept, full ones are purged
+  REQUIRE (kl.purge_idle(after(t0, 0.25), 2u) == 1u);
+  REQUIRE (kl.size() == 1000u);
+  REQUIRE (kl.try_acquire(3u, 2u, after(t0, 0.25)));
+  REQUIRE (!kl.try_acquire(3u, 1u, after(t0, 0.25)));
+  REQUIRE (kl.purge_idle(after(t0, 10.0), 2u) == 1000u);
+  REQUIRE (kl.size() == 0u);
+
+  chops::keyed_rate_limiter<int, chops::sliding_window_limiter>
+      ks(chops::sliding_window_limiter(3u, std::chrono::milliseconds(100)));
+  allowed = 0;
+  chops::repeat(10, [&] { allowed += ks.try_acquire(42, 1u, t0) ? 1 : 0; } );
+  REQUIRE (allowed == 3);
+  REQUIRE (ks.purge_idle(t0, 1u) == 0u);
+  REQUIRE (ks.purge_idle(after(t0, 1.0), 1u) == 1u);
+}
+
+TEST_CASE ( "Rate limiters with the current time", "[token_bucket]" ) {
+
+  chops::token_bucket tb(1000000.0, 100.0);
+  REQUIRE (tb.try_acquire());
+  REQUIRE (tb.available() <= 100.0);
+  chops::keyed_rate_limiter<int> kl(tb);
+  REQUIRE (kl.try_acquire(1));
+  chops::sliding_window_limiter sw(10u, std::chrono::seconds(1));
+  REQUIRE (sw.try_acquire(5u));
+}
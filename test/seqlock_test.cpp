@@ -0,0 +1,101 @@
+/** @file
+ *
+ * @brief Test scenarios for @c seqlock.
+ *
+ * The concurrent scenario is intended to also be run under ThreadSanitizer (configure
+ * with @c -D UTILITY_RACK_TEST_SANITIZER=thread); all shared accesses in @c seqlock are
+ * atomic, so no sanitizer annotations or suppressions are needed.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "utility/seqlock.hpp"
+#include "utility/repeat.hpp"
+
+struct snapshot {
+  std::uint64_t seq_num;
+  double bid;
+  double ask;
+  std::uint32_t bid_size;
+  char symbol[5];   // odd size, exercises the partial trailing word
+};
+
+bool consistent (const snapshot& s) {
+  return s.bid == static_cast<double>(s.seq_num) && s.ask == s.bid + 0.5 &&
+         s.bid_size == static_cast<std::uint32_t>(s.seq_num * 3u) && s.symbol[0] == 'Q' &&
+         s.symbol[4] == static_cast<char>('a' + s.seq_num % 26u);
+}
+
+snapshot make_snapshot (std::uint64_t n) {
+  return snapshot { n, static_cast<double>(n), static_cast<double>(n) + 0.5, 
+                    static_cast<std::uint32_t>(n * 3u), 
+                    { 'Q', 'X', 'Y', 'Z', static_cast<char>('a' + n % 26u) } };
+}
+
+TEST_CASE ( "Seqlock stores and loads values", "[seqlock]" ) {
+
+  chops::seqlock<snapshot> sl { make_snapshot(0u) };
+  REQUIRE (sl.sequence() == 0u);
+  REQUIRE (consistent(sl.load()));
+
+  sl.store(make_snapshot(7u));
+  REQUIRE (sl.sequence() == 2u);
+  auto s = sl.load();
+  REQUIRE (s.seq_num == 7u);
+  REQUIRE (consistent(s));
+  auto t = sl.try_load();
+  REQUIRE (t);
+  REQUIRE (t->seq_num == 7u);
+
+  chops::seqlock<int> si;
+  REQUIRE (si.load() == 0);
+  si.store(42);
+  REQUIRE (si.load() == 42);
+}
+
+TEST_CASE ( "Seqlock readers never see a torn value", "[seqlock] [concurrent]" ) {
+
+  constexpr int NumReaders = 4;
+  constexpr std::uint64_t NumWrites = 50000u;
+
+  chops::seqlock<snapshot> sl { make_snapshot(0u) };
+  std::atomic<bool> done { false };
+  std::atomic<int> bad { 0 };
+  std::vector<std::thread> readers;
+
+  chops::repeat(NumReaders, [&] {
+    readers.emplace_back([&] {
+      std::uint64_t last = 0u;
+      while (!done.load()) {
+        auto s = sl.load();
+        if (!consistent(s) || s.seq_num < last) {
+          bad += 1;
+        }
+        last = s.seq_num;
+      }
+    } );
+  } );
+  for (std::uint64_t i = 1u; i <= NumWrites; ++i) {
+    sl.store(make_snapshot(i));
+  }
+  done = true;
+  for (auto& thr : readers) {
+    thr.join();
+  }
+  REQUIRE (bad == 0);
+  REQUIRE (sl.load().seq_num == NumWrites);
+  REQUIRE (sl.sequence() == 2u * NumWrites);
+}
@@ -0,0 +1,121 @@
+/** @file
+ *
+ * @brief Test scenarios for @c slot_map and @c slot_handle.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <memory> // std::unique_ptr
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "utility/slot_map.hpp"
+#include "utility/repeat.hpp"
+
+TEST_CASE ( "Slot handle packing", "[slot_map]" ) {
+
+  chops::slot_handle empty;
+  REQUIRE_FALSE (empty);
+  chops::slot_handle h { 7u, 3u };
+  REQUIRE (h);
+  REQUIRE (h.index() == 7u);
+  REQUIRE (h.generation() == 3u);
+  REQUIRE (h.value() == ((3ull << 32u) | 7u));
+  REQUIRE (chops::slot_handle::from_value(h.value()) == h);
+  REQUIRE (std::hash<chops::slot_handle>{}(h) == std::hash<std::uint64_t>{}(h.value()));
+}
+
+TEST_CASE ( "Slot map insert, find and erase with stale handle detection", "[slot_map]" ) {
+
+  chops::slot_map<std::string> sm;
+  REQUIRE (sm.empty());
+  REQUIRE (sm.find(chops::slot_handle { }) == nullptr);
+
+  auto a = sm.insert("alpha");
+  auto b = sm.insert(std::string("beta"));
+  auto c = sm.emplace(3u, 'c');
+  REQUIRE (sm.size() == 3u);
+  REQUIRE (*sm.find(a) == "alpha");
+  REQUIRE (sm[b] == "beta");
+  REQUIRE (sm.at(c) == "ccc");
+
+  REQUIRE (sm.erase(a));
+  REQUIRE_FALSE (sm.erase(a));
+  REQUIRE_FALSE (sm.contains(a));
+  REQUIRE (sm.find(a) == nullptr);
+  REQUIRE_THROWS_AS (sm.at(a), std::out_of_range);
+  // the last value was moved into the erased position
+  REQUIRE (sm.size() == 2u);
+  REQUIRE (sm.values()[0] == "ccc");
+  REQUIRE (sm[c] == "ccc");
+  REQUIRE (sm[b] == "beta");
+
+  // the slot is reused with a new generation, the old handle stays stale
+  auto d = sm.insert("delta");
+  REQUIRE (d.index() == a.index());
+  REQUIRE (d.generation() != a.generation());
+  REQUIRE (sm.find(a) == nullptr);
+  REQUIRE (sm[d] == "delta");
+
+  for (std::size_t i = 0u; i < sm.size(); ++i) {
+    REQUIRE (sm[sm.handle_at(i)] == sm.values()[i]);
+  }
+
+  sm.clear();
+  REQUIRE (sm.empty());
+  REQUIRE_FALSE (sm.contains(b));
+  REQUIRE_FALSE (sm.contains(c));
+  REQUIRE_FALSE (sm.contains(d));
+  REQUIRE (sm.find(chops::slot_handle { 100u, 1u }) == nullptr);
+}
+
+TEST_CASE ( "Slot map churn keeps handles and values consistent", "[slot_map]" ) {
+
+  chops::slot_map<std::unique_ptr<int>> sm;
+  std::vector<chops::slot_handle> live;
+  std::vector<chops::slot_handle> dead;
+
+  chops::repeat(1000, [&] (int i) {
+      live.push_back(sm.insert(std::make_unique<int>(i)));
+      if (i % 3 == 2) {
+        auto h = live[live.size() / 2u];
+        live.erase(live.begin() + static_cast<std::ptrdiff_t>(live.size() / 2u));
+        REQUIRE (sm.erase(h));
+        dead.push_back(h);
+      }
+    } );
+  REQUIRE (sm.size() == live.size());
+  for (auto h : live) {
+    REQUIRE (sm.contains(h));
+  }
+  for (auto h : dead) {
+    REQUIRE_FALSE (sm.contains(h));
+  }
+  std::unordered_set<int> seen;
+  for (const auto& p : sm) {
+    seen.insert(*p);
+  }
+  REQUIRE (seen.size() == live.size());
+
+  auto n = sm.erase_if([] (const std::unique_ptr<int>& p) { return *p % 2 == 0; } );
+  REQUIRE (n + sm.size() == live.size());
+  std::size_t remaining = 0u;
+  for (auto h : live) {
+    if (auto p = sm.find(h)) {
+      REQUIRE (**p % 2 == 1);
+      ++remaining;
+    }
+  }
+  REQUIRE (remaining == sm.size());
+}
+
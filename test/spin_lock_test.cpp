@@ -0,0 +1,82 @@
+/** @file
+ *
+ * @brief Test scenarios for @c spin_lock and @c hybrid_mutex.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_template_test_macros.hpp"
+
+#include <chrono>
+#include <mutex> // std::lock_guard, std::unique_lock, std::scoped_lock
+#include <thread>
+#include <vector>
+
+#include "utility/spin_lock.hpp"
+#include "utility/repeat.hpp"
+
+TEMPLATE_TEST_CASE ( "Spin lock and hybrid mutex meet the Lockable requirements", 
+                     "[spin_lock] [hybrid_mutex]", chops::spin_lock, chops::hybrid_mutex ) {
+
+  TestType mtx;
+
+  SECTION ( "try_lock fails while the lock is held" ) {
+    REQUIRE (mtx.try_lock());
+    REQUIRE_FALSE (mtx.try_lock());
+    mtx.unlock();
+    std::unique_lock lk(mtx, std::try_to_lock);
+    REQUIRE (lk.owns_lock());
+  }
+  SECTION ( "Standard lock helpers work, including deadlock avoidance" ) {
+    TestType mtx2;
+    {
+      std::scoped_lock lk(mtx, mtx2);
+      REQUIRE_FALSE (mtx2.try_lock());
+    }
+    std::lock_guard lk(mtx2);
+    REQUIRE (mtx.try_lock());
+    mtx.unlock();
+  }
+  SECTION ( "Threads incrementing a plain counter are mutually excluded" ) {
+    constexpr int NumThreads = 6;
+    constexpr int NumIncrs = 20000;
+    long counter = 0;
+    std::vector<std::thread> thrs;
+    chops::repeat(NumThreads, [&] {
+      thrs.emplace_back([&] {
+        chops::repeat(NumIncrs, [&] {
+          std::lock_guard lk(mtx);
+          ++counter;
+        } );
+      } );
+    } );
+    for (auto& thr : thrs) {
+      thr.join();
+    }
+    REQUIRE (counter == NumThreads * NumIncrs);
+  }
+}
+
+TEST_CASE ( "Hybrid mutex parks waiters during long critical sections", "[hybrid_mutex]" ) {
+
+  chops::hybrid_mutex mtx;
+  int value = 0;
+  mtx.lock();
+  std::thread waiter ( [&] {
+    std::lock_guard lk(mtx);
+    value += 1;
+  } );
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  value = 41;
+  mtx.unlock();
+  waiter.join();
+  std::lock_guard lk(mtx);
+  REQUIRE (value == 42);
+}
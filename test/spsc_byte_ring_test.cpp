@@ -0,0 +1,105 @@
+/** @file
+ *
+ * @brief Test scenarios for @c spsc_byte_ring.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "utility/spsc_byte_ring.hpp"
+
+TEST_CASE ( "Spsc byte ring basic operations", "[spsc_byte_ring]" ) {
+
+  chops::spsc_byte_ring ring(100u);
+  REQUIRE (ring.capacity() == 128u);
+  REQUIRE (ring.max_record_size() == 60u);
+  REQUIRE (ring.empty());
+  REQUIRE (ring.try_reserve(61u).data() == nullptr);
+
+  auto sp = ring.try_reserve(3u);
+  REQUIRE (sp.size() == 3u);
+  sp[0] = std::byte{1}; sp[1] = std::byte{2}; sp[2] = std::byte{3};
+  REQUIRE (ring.empty()); // not yet committed
+  ring.commit();
+  REQUIRE (!ring.empty());
+  REQUIRE (ring.try_push(0u, [] (std::span<std::byte>) { } ));
+
+  std::vector<std::size_t> sizes;
+  auto n = ring.consume_all([&sizes] (std::span<const std::byte> rec) {
+      sizes.push_back(rec.size());
+      if (rec.size() == 3u) {
+        REQUIRE (rec[2] == std::byte{3});
+      }
+    } );
+  REQUIRE (n == 2u);
+  REQUIRE (sizes == std::vector<std::size_t>{3u, 0u});
+  REQUIRE (ring.empty());
+}
+
+TEST_CASE ( "Spsc byte ring full and wrap around", "[spsc_byte_ring]" ) {
+
+  chops::spsc_byte_ring ring(64u);
+  // each 20 byte record occupies 24 bytes
+  REQUIRE (ring.try_push(20u, [] (std::span<std::byte> sp) { sp[0] = std::byte{1}; } ));
+  REQUIRE (ring.try_push(20u, [] (std::span<std::byte> sp) { sp[0] = std::byte{2}; } ));
+  REQUIRE (!ring.try_push(20u, [] (std::span<std::byte>) { } ));
+  std::vector<int> seen;
+  ring.consume_all([&seen] (std::span<const std::byte> rec) { seen.push_back(std::to_integer<int>(rec[0])); } );
+  REQUIRE (seen == std::vector<int>{1, 2});
+  // 16 bytes left before the end, so the next record wraps to the start
+  REQUIRE (ring.try_push(20u, [] (std::span<std::byte> sp) { sp[0] = std::byte{3}; } ));
+  REQUIRE (ring.try_push(20u, [] (std::span<std::byte> sp) { sp[0] = std::byte{4}; } ));
+  REQUIRE (!ring.try_push(20u, [] (std::span<std::byte>) { } ));
+  seen.clear();
+  ring.consume_all([&seen] (std::span<const std::byte> rec) { seen.push_back(std::to_integer<int>(rec[0])); } );
+  REQUIRE (seen == std::vector<int>{3, 4});
+  REQUIRE (ring.empty());
+}
+
+TEST_CASE ( "Spsc byte ring producer and consumer threads", "[spsc_byte_ring]" ) {
+
+  constexpr std::uint64_t count = 200000u;
+  chops::spsc_byte_ring ring(1024u);
+  std::atomic<int> errors { 0 };
+
+  std::thread consumer([&ring, &errors] {
+    std::uint64_t expected = 0u;
+    while (expected < count) {
+      ring.consume_all([&expected, &errors] (std::span<const std::byte> rec) {
+          std::uint64_t v;
+          std::memcpy(&v, rec.data(), sizeof(v));
+          if (v != expected || rec.size() != sizeof(v) + v % 17u) {
+            errors.fetch_add(1);
+          }
+          ++expected;
+        } );
+    }
+  } );
+
+  for (std::uint64_t i = 0u; i < count; ) {
+    if (ring.try_push(sizeof(i) + i % 17u, [i] (std::span<std::byte> sp) { std::memcpy(sp.data(), &i, sizeof(i)); } )) {
+      ++i;
+    }
+    else {
+      std::this_thread::yield();
+    }
+  }
+  consumer.join();
+  REQUIRE (errors.load() == 0);
+  REQUIRE (ring.empty());
+}
@@ -0,0 +1,135 @@
+/** @file
+ *
+ * @brief Test scenarios for the compile-time string hashes and @c perfect_hash_table.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <string_view>
+
+#include "utility/string_hash.hpp"
+#include "utility/hash_bytes.hpp"
+
+using namespace chops::literals;
+
+// known FNV-1a values
+static_assert (chops::fnv1a_32("") == 0x811c9dc5u);
+static_assert (chops::fnv1a_32("a") == 0xe40c292cu);
+static_assert (chops::fnv1a_64("") == 0xcbf29ce484222325u);
+static_assert (chops::fnv1a_64("a") == 0xaf63dc4c8601ec8cu);
+static_assert ("foobar"_fnv1a == 0x85944171f73967e8u);
+static_assert ("get"_hash != "set"_hash);
+
+constexpr auto commands = chops::make_perfect_hash({ "get", "set", "delete", "incr", "decr" });
+static_assert (commands.size() == 5u);
+static_assert (commands.index_of("delete") == 2u);
+static_assert (commands.find("put") == commands.npos);
+
+namespace {
+
+int classify(std::string_view token) {
+  switch (chops::hash_bytes(token)) {
+    case "get"_hash: return token == "get" ? 1 : 0;
+    case "set"_hash: return token == "set" ? 2 : 0;
+    case "a much longer keyword used to exercise the long input path"_hash:
+      return token == "a much longer keyword used to exercise the long input path" ? 3 : 0;
+    default: return 0;
+  }
+}
+
+int command_id(std::string_view token) {
+  switch (commands.find(token)) {
+    case commands.index_of("get"): return 10;
+    case commands.index_of("set"): return 20;
+    case commands.index_of("delete"): return 30;
+    default: return -1;
+  }
+}
+
+}
+
+TEST_CASE ( "Compile-time hashes match run-time hashes", "[string_hash]" ) {
+
+  // built at run time, so the hashes below are not constant evaluated
+  std::string s;
+  for (int len = 0; len < 100; ++len) {
+    REQUIRE (chops::fnv1a_64(s) == chops::fnv1a_64(std::string_view(s)));
+    s.push_back(static_cast<char>('a' + len % 26));
+  }
+  REQUIRE (chops::hash_bytes(std::string("get")) == "get"_hash);
+  REQUIRE (chops::fnv1a_64(std::string("foobar")) == "foobar"_fnv1a);
+  constexpr auto long_hash = chops::hash_bytes("0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnop", 7u);
+  REQUIRE (chops::hash_bytes(std::string("0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnop"), 7u) == long_hash);
+}
+
+TEST_CASE ( "Switch on string hash", "[string_hash]" ) {
+
+  REQUIRE (classify(std::string("get")) == 1);
+  REQUIRE (classify(std::string("set")) == 2);
+  REQUIRE (classify(std::string("a much longer keyword used to exercise the long input path")) == 3);
+  REQUIRE (classify(std::string("put")) == 0);
+  REQUIRE (classify("") == 0);
+}
+
+TEST_CASE ( "Perfect hash table lookups", "[string_hash]" ) {
+
+  REQUIRE (command_id(std::string("get")) == 10);
+  REQUIRE (command_id(std::string("set")) == 20);
+  REQUIRE (command_id(std::string("delete")) == 30);
+  REQUIRE (command_id(std::string("incr")) == -1);
+  REQUIRE (command_id(std::string("gets")) == -1);
+  REQUIRE (command_id("") == -1);
+
+  constexpr auto keywords = chops::make_perfect_hash({
+      "alignas", "alignof", "and", "asm", "auto", "bool", "break", "case", "catch", "char",
+      "class", "concept", "const", "consteval", "constexpr", "constinit", "continue",
+      "co_await", "co_return", "co_yield", "decltype", "default", "delete", "do", "double",
+      "else", "enum", "explicit", "export", "extern", "false", "float", "for", "friend",
+      "goto", "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept",
+      "nullptr", "operator", "private", "protected", "public", "register", "requires",
+      "return", "short", "signed", "sizeof", "static", "struct", "switch", "template",
+      "this", "throw", "true", "try", "typedef", "typename", "union", "unsigned", "using",
+      "virtual", "void", "volatile", "while" });
+  REQUIRE (keywords.size() == 71u);
+  std::set<std::size_t> seen;
+  for (std::size_t i = 0u; i < keywords.size(); ++i) {
+    auto k = std::string(keywords.key(i));
+    REQUIRE (keywords.find(k) == i);
+    REQUIRE (keywords.contains(k));
+    seen.insert(keywords.find(k));
+    REQUIRE (!keywords.contains(k + "_"));
+  }
+  REQUIRE (seen.size() == 71u);
+  REQUIRE (!keywords.contains("foo"));
+  REQUIRE_THROWS_AS (keywords.index_of("foo"), std::invalid_argument);
+  REQUIRE_THROWS_AS (chops::make_perfect_hash({ "a", "b", "a" }), std::invalid_argument);
+}
+
+TEST_CASE ( "Keyword dispatch to handlers", "[string_hash]" ) {
+
+  int calls[3] = { 0, 0, 0 };
+  auto run = [&] (std::string_view token) {
+    return chops::dispatch_keyword(commands, token,
+        [&] { ++calls[0]; }, [&] { ++calls[1]; }, [&] { ++calls[2]; }, [] { }, [] { } );
+  };
+  REQUIRE (run("set"));
+  REQUIRE (run("set"));
+  REQUIRE (run("delete"));
+  REQUIRE (run("decr"));
+  REQUIRE (!run("nope"));
+  REQUIRE (calls[0] == 0);
+  REQUIRE (calls[1] == 2);
+  REQUIRE (calls[2] == 1);
+}
@@ -0,0 +1,101 @@
+/** @file
+ *
+ * @brief Test scenarios for @c string_interner.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <stdexcept> // std::length_error
+
+#include "utility/string_interner.hpp"
+#include "utility/repeat.hpp"
+
+TEST_CASE ( "String interner assigns stable symbol ids", "[string_interner]" ) {
+
+  chops::string_interner interner { 16u };
+  REQUIRE (interner.size() == 0u);
+  REQUIRE (interner.capacity() == 16u);
+
+  SECTION ( "The same string always returns the same id and shared storage" ) {
+    auto id1 = interner.intern("market.quotes");
+    auto id2 = interner.intern(std::string("market.quotes"));
+    REQUIRE (id1 == id2);
+    REQUIRE (interner.size() == 1u);
+    REQUIRE (interner.view(id1) == "market.quotes");
+    REQUIRE (interner.view(id1).data() == interner.view(id2).data());
+  }
+  SECTION ( "Distinct strings return distinct sequential ids" ) {
+    auto id1 = interner.intern("a");
+    auto id2 = interner.intern("b");
+    auto id3 = interner.intern("");
+    REQUIRE (id1 == 0u);
+    REQUIRE (id2 == 1u);
+    REQUIRE (id3 == 2u);
+    REQUIRE (interner.view(id3).empty());
+    REQUIRE (interner.find("") == id3);
+  }
+  SECTION ( "Find performs heterogeneous lookup without inserting" ) {
+    REQUIRE_FALSE (interner.find("field.price"));
+    auto id = interner.intern("field.price");
+    std::string str { "field.price" };
+    const char* cstr = "field.price";
+    REQUIRE (interner.find(str) == id);
+    REQUIRE (interner.find(cstr) == id);
+    REQUIRE (interner.find(std::string_view(str).substr(0, 5)) == std::nullopt);
+    REQUIRE (interner.size() == 1u);
+  }
+  SECTION ( "Views remain valid as the arena grows" ) {
+    auto id = interner.intern("first");
+    auto sv = interner.view(id);
+    chops::repeat(15, [&interner] (int i) { interner.intern(std::string(1000u, 'a' + i)); } );
+    REQUIRE (interner.view(id).data() == sv.data());
+    REQUIRE (interner.view(id) == "first");
+    REQUIRE (interner.size() == 16u);
+  }
+  SECTION ( "Interning past capacity throws" ) {
+    chops::repeat(16, [&interner] (int i) { interner.intern(std::to_string(i)); } );
+    REQUIRE (interner.intern("3") == 3u);
+    REQUIRE_THROWS_AS (interner.intern("too many"), std::length_error);
+  }
+}
+
+TEST_CASE ( "String interner is consistent under concurrent interning", "[string_interner] [concurrent]" ) {
+
+  constexpr int NumThreads = 4;
+  constexpr int NumNames = 500;
+
+  chops::string_interner interner { NumNames };
+  std::vector<std::vector<chops::symbol_id>> ids (NumThreads);
+  std::vector<std::thread> thrs;
+  chops::repeat(NumThreads, [&] (int t) {
+    thrs.emplace_back([&interner, &ids, t] {
+      chops::repeat(NumNames, [&] (int i) {
+        ids[t].push_back(interner.intern("name." + std::to_string((i + t * 7) % NumNames)));
+      } );
+    } );
+  } );
+  for (auto& thr : thrs) {
+    thr.join();
+  }
+  REQUIRE (interner.size() == static_cast<std::uint32_t>(NumNames));
+  chops::repeat(NumThreads, [&] (int t) {
+    chops::repeat(NumNames, [&] (int i) {
+      auto name = "name." + std::to_string((i + t * 7) % NumNames);
+      REQUIRE (interner.view(ids[t][i]) == name);
+      REQUIRE (interner.find(name) == ids[t][i]);
+    } );
+  } );
+}
+
@@ -0,0 +1,79 @@
+/** @file
+ *
+ * @brief Test scenarios for @c thread_pool.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include "utility/thread_pool.hpp"
+#include "utility/repeat.hpp"
+
+TEST_CASE ( "Thread pool runs posted and submitted tasks", "[thread_pool]" ) {
+
+  std::atomic<int> count { 0 };
+  std::atomic<int> bad_worker { 0 };
+  {
+    chops::thread_pool pool(4u, false);
+    REQUIRE (pool.size() == 4u);
+    REQUIRE (pool.current_worker() == chops::thread_pool::npos);
+    REQUIRE (pool.worker_node(3u) == 0u);
+    chops::repeat(1000, [&] (int i) {
+        auto task = [&] {
+            if (pool.current_worker() >= pool.size()) {
+              ++bad_worker;
+            }
+            ++count;
+          };
+        if (i % 2 == 0) {
+          pool.post(task);
+        }
+        else {
+          pool.post_to(static_cast<std::size_t>(i), task);
+        }
+      } );
+    auto fut = pool.submit([] { return 42; } );
+    REQUIRE (fut.get() == 42);
+    auto bad = pool.submit([] () -> int { throw std::runtime_error("bad"); } );
+    REQUIRE_THROWS_AS (bad.get(), std::runtime_error);
+  } // destructor runs the remaining tasks
+  REQUIRE (count == 1000);
+  REQUIRE (bad_worker == 0);
+}
+
+TEST_CASE ( "Thread pool tasks can post more tasks", "[thread_pool]" ) {
+
+  std::atomic<int> count { 0 };
+  {
+    chops::thread_pool pool(2u);
+    chops::repeat(10, [&] {
+        pool.post([&] {
+            chops::repeat(10, [&] { pool.post([&] { ++count; } ); } );
+          } );
+      } );
+  }
+  REQUIRE (count == 100);
+  REQUIRE (chops::default_thread_pool().size() >= 1u);
+}
+
+
+TEST_CASE ( "Thread pool wakes sleeping workers for every task", "[thread_pool]" ) {
+
+  chops::thread_pool pool(3u, false);
+  // each round trip finds the workers asleep, so a lost wakeup hangs here
+  int sum = 0;
+  chops::repeat(5000, [&] (int i) { sum += pool.submit([i] { return i % 2; } ).get(); } );
+  REQUIRE (sum == 2500);
+}
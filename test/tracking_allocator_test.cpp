@@ -0,0 +1,190 @@
+/** @file
+ *
+ * @brief Test scenarios for @c tracking_allocator, @c tracking_resource and
+ * @c allocation_tag.
+ *
+ * Tags are global, so each scenario uses its own tag names.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utility/tracking_allocator.hpp"
+#include "utility/erase_where.hpp"
+#include "utility/repeat.hpp"
+
+struct vec_tag { static constexpr const char* name = "test vector"; };
+struct map_tag { static constexpr const char* name = "test map"; };
+struct thr_tag { static constexpr const char* name = "test threads"; };
+struct glob_tag { static constexpr const char* name = "test global"; };
+struct tls_tag { static constexpr const char* name = "test thread_local"; };
+
+// freed at exit, after the main thread's blocks and possibly after other statics
+std::vector<int, chops::tracking_allocator<int, glob_tag>> g_tracked;
+
+TEST_CASE ( "Allocation size buckets", "[tracking_allocator]" ) {
+
+  REQUIRE (chops::allocation_bucket(0u) == 0u);
+  REQUIRE (chops::allocation_bucket(1u) == 0u);
+  REQUIRE (chops::allocation_bucket(8u) == 0u);
+  REQUIRE (chops::allocation_bucket(9u) == 1u);
+  REQUIRE (chops::allocation_bucket(16u) == 1u);
+  REQUIRE (chops::allocation_bucket(1024u) == 7u);
+  REQUIRE (chops::allocation_bucket(1024u * 1024u) == 17u);
+  REQUIRE (chops::allocation_bucket(1024u * 1024u + 1u) == 18u);
+  REQUIRE (chops::allocation_bucket(~std::size_t{0u}) == 18u);
+}
+
+TEST_CASE ( "Tracking allocator with std containers", "[tracking_allocator]" ) {
+
+  auto& vtag = chops::tracking_allocator<int, vec_tag>::tag();
+  REQUIRE (&vtag == &chops::allocation_tag::get("test vector"));
+  REQUIRE (vtag.name() == "test vector");
+  {
+    std::vector<int, chops::tracking_allocator<int, vec_tag>> v;
+    v.reserve(100u);
+    auto st = vtag.stats();
+    REQUIRE (st.allocations == 1u);
+    REQUIRE (st.bytes_allocated == 100u * sizeof(int));
+    REQUIRE (st.live_bytes == static_cast<std::int64_t>(100u * sizeof(int)));
+    REQUIRE (st.histogram[chops::allocation_bucket(100u * sizeof(int))] == 1u);
+    chops::repeat(1000, [&v] (int i) { v.push_back(i); } );
+    chops::erase_where_if(v, [] (int i) { return i % 2 == 0; } );
+    v.shrink_to_fit();
+    REQUIRE (v.size() == 500u);
+  }
+  auto st = vtag.stats();
+  REQUIRE (st.allocations == st.deallocations);
+  REQUIRE (st.bytes_allocated == st.bytes_deallocated);
+  REQUIRE (st.live_bytes == 0);
+  REQUIRE (st.peak_live_bytes > 0);
+
+  {
+    // node allocations go through the rebound allocator, under the same tag
+    std::map<int, int, std::less<int>, chops::tracking_allocator<std::pair<const int, int>, map_tag>> m;
+    chops::repeat(50, [&m] (int i) { m[i] = i; } );
+    auto mst = chops::tracking_allocator<int, map_tag>::tag().stats();
+    REQUIRE (mst.allocations == 50u);
+    REQUIRE (mst.live_bytes > 0);
+  }
+  REQUIRE (chops::tracking_allocator<char, map_tag>::tag().stats().live_bytes == 0);
+}
+
+TEST_CASE ( "Tracking resource with pmr containers", "[tracking_allocator]" ) {
+
+  auto& tag = chops::allocation_tag::get("test pmr");
+  chops::tracking_resource res(tag);
+  REQUIRE (&res.tag() == &tag);
+  REQUIRE (res.upstream() == std::pmr::get_default_resource());
+  {
+    std::pmr::vector<std::pmr::string> v(&res);
+    v.reserve(10u);
+    v.emplace_back(100u, 'x'); // the string allocates through the same resource
+    auto st = tag.stats();
+    REQUIRE (st.allocations == 2u);
+    REQUIRE (st.live_bytes >= static_cast<std::int64_t>(10u * sizeof(std::pmr::string) + 100u));
+  }
+  REQUIRE (tag.stats().live_bytes == 0);
+  REQUIRE (tag.stats().deallocations == 2u);
+}
+
+TEST_CASE ( "Tracking allocator counts from many threads and reports", "[tracking_allocator]" ) {
+
+  using alloc = chops::tracking_allocator<char, thr_tag>;
+  constexpr int num_thrs = 4;
+  constexpr int per_thr = 2000;
+  auto& tag = alloc::tag();
+  tag.set_stack_sampling(100u);
+
+  std::vector<std::thread> thrs;
+  chops::repeat(num_thrs, [&thrs] {
+      thrs.emplace_back([] {
+          alloc a;
+          std::vector<char*> ptrs;
+          chops::repeat(per_thr, [&] (int i) { ptrs.push_back(a.allocate(static_cast<std::size_t>(i % 64 + 1))); } );
+          chops::repeat(per_thr, [&] (int i) { a.deallocate(ptrs[static_cast<std::size_t>(i)], static_cast<std::size_t>(i % 64 + 1)); } );
+        } );
+    } );
+  for (auto& t : thrs) {
+    t.join();
+  }
+  tag.set_stack_sampling(0u);
+
+  auto st = tag.stats();
+  REQUIRE (st.allocations == static_cast<std::uint64_t>(num_thrs * per_thr));
+  REQUIRE (st.deallocations == st.allocations);
+  REQUIRE (st.live_bytes == 0);
+  std::uint64_t hist_total = 0u;
+  for (auto h : st.histogram) {
+    hist_total += h;
+  }
+  REQUIRE (hist_total == st.allocations);
+
+#if defined(__linux__) && defined(__GLIBC__)
+  auto samples = tag.stack_samples();
+  REQUIRE_FALSE (samples.empty());
+  std::uint64_t sampled = 0u;
+  for (const auto& s : samples) {
+    sampled += s.count;
+    REQUIRE_FALSE (s.frames.empty());
+  }
+  REQUIRE (sampled == static_cast<std::uint64_t>(num_thrs * per_thr / 100));
+#endif
+
+  // memory allocated on one thread and freed on another, whose first use of the tag is
+  // the deallocation
+  {
+    alloc a;
+    std::vector<char*> ptrs;
+    chops::repeat(num_thrs, [&] { ptrs.push_back(a.allocate(32u)); } );
+    std::vector<std::thread> freers;
+    for (auto* p : ptrs) {
+      freers.emplace_back([p] { alloc().deallocate(p, 32u); } );
+    }
+    for (auto& t : freers) {
+      t.join();
+    }
+  }
+  st = tag.stats();
+  REQUIRE (st.allocations == static_cast<std::uint64_t>(num_thrs * per_thr + num_thrs));
+  REQUIRE (st.deallocations == st.allocations);
+  REQUIRE (st.live_bytes == 0);
+
+  auto report = chops::allocation_report();
+  REQUIRE (report.find("test threads: allocs 8004") != std::string::npos);
+  REQUIRE (report.find("test vector:") != std::string::npos);
+  REQUIRE (report.find("  <= 64: ") != std::string::npos);
+}
+
+TEST_CASE ( "Tracking allocator in static and thread_local containers", "[tracking_allocator]" ) {
+
+  using alloc = chops::tracking_allocator<int, tls_tag>;
+  chops::repeat(100, [] (int i) { g_tracked.push_back(i); } );
+  REQUIRE (chops::tracking_allocator<int, glob_tag>::tag().stats().live_bytes > 0);
+
+  // the container is constructed before the thread's blocks, so it is destroyed after
+  // them and its deallocations go to the shared block
+  std::thread thr([] {
+      thread_local std::vector<int, alloc> v;
+      chops::repeat(1000, [] (int i) { v.push_back(i); } );
+    } );
+  thr.join();
+  auto st = alloc::tag().stats();
+  REQUIRE (st.allocations > 0u);
+  REQUIRE (st.deallocations == st.allocations);
+  REQUIRE (st.bytes_deallocated == st.bytes_allocated);
+  REQUIRE (st.live_bytes == 0);
+}
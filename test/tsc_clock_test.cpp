@@ -0,0 +1,62 @@
+/** @file
+ *
+ * @brief Test scenarios for @c tsc_clock.
+ *
+ * @author Cliff Green
+ *
+ * @copyright (c) 2026 by Cliff Green
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "utility/tsc_clock.hpp"
+#include "utility/repeat.hpp"
+
+static_assert (std::chrono::is_clock_v<chops::tsc_clock>);
+
+TEST_CASE ( "Tsc clock is monotonic", "[tsc_clock]" ) {
+
+  INFO ("Using TSC: " << chops::tsc_clock::uses_tsc() << ", frequency: " << chops::tsc_clock::frequency());
+  REQUIRE (chops::tsc_clock::frequency() > 0.0);
+  auto prev = chops::tsc_clock::now();
+  chops::repeat(100000, [&prev] {
+    auto t = chops::tsc_clock::now();
+    REQUIRE (t >= prev);
+    prev = t;
+  } );
+}
+
+TEST_CASE ( "Tsc clock tracks steady clock", "[tsc_clock]" ) {
+
+  using namespace std::chrono_literals;
+
+  auto s0 = std::chrono::steady_clock::now();
+  auto t0 = chops::tsc_clock::now();
+  auto raw0 = chops::tsc_clock::ticks();
+  std::this_thread::sleep_for(100ms);
+  auto raw1 = chops::tsc_clock::ticks();
+  auto t1 = chops::tsc_clock::now();
+  auto s1 = std::chrono::steady_clock::now();
+
+  auto steady_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(s1 - s0).count();
+  auto tsc_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+  REQUIRE (tsc_elapsed > steady_elapsed * 95 / 100);
+  REQUIRE (tsc_elapsed < steady_elapsed * 105 / 100);
+
+  auto from_raw = chops::tsc_clock::from_ticks(raw1) - chops::tsc_clock::from_ticks(raw0);
+  REQUIRE (from_raw >= 100ms);
+  REQUIRE (from_raw <= t1 - t0);
+
+  chops::tsc_clock::recalibrate();
+  auto t2 = chops::tsc_clock::now();
+  REQUIRE (t2 >= t1);
+  REQUIRE (t2 - t1 < 10ms);
+}